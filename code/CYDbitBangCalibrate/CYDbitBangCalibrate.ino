@@ -41,6 +41,7 @@
 // ----------------------------
 
 #include <SPI.h>
+#include <Preferences.h> // for storing the coefficients in NVS for UniRemoteCYD
 
 // ----------------------------
 // Additional Libraries - each one of these will need to be installed.
@@ -74,6 +75,9 @@
 // https://github.com/tomstewart89/BasicLinearAlgebra
 #include <BasicLinearAlgebra.h>
 
+// one-pass and robust statistics for the samples at each crosshair
+#include "uni_touch_stats.h"
+
 // Touchscreen pins
 #define XPT2046_IRQ 36   // T_IRQ
 #define XPT2046_MOSI 32  // T_DIN
@@ -98,6 +102,7 @@ XPT2046_Touchscreen touchscreen(XPT2046_CS, XPT2046_IRQ);
 String s;
 
 int ts_points[6][2];
+float ts_residual[6]; /* residual error of each touch point from uni_ts_point_estimate(); raw touchscreen units */
 
 /* define the screen points where touch samples will be taken */
 const int scr_points[6][2] = { {13, 11}, {20, 220}, {167, 60}, {155, 180}, {300, 13}, {295, 225} };
@@ -127,6 +132,14 @@ struct point fT;
 float alphaX, betaX, deltaX, alphaY, betaY, deltaY;
 float pref_alphaX, pref_betaX, pref_deltaX, pref_alphaY, pref_betaY, pref_deltaY;
 
+/* UniRemoteCYD loads the coefficients from NVS at boot; these must match UniRemoteCYD.ino
+   the blob is six floats in the order printed by check_calibration_results():
+      alpha_x, beta_x, delta_x, alpha_y, beta_y, delta_y */
+#define UNI_NVS_NAMESPACE "uniremote"
+#define UNI_TOUCH_CAL_NVS_KEY "touchcal"
+#define UNI_TOUCH_CAL_NUM 6
+Preferences nvs;
+
 #define DRAW_BUF_SIZE (SCREEN_WIDTH * SCREEN_HEIGHT / 10 * (LV_COLOR_DEPTH / 8))
 uint32_t draw_buf[DRAW_BUF_SIZE / 4];
 
@@ -138,7 +151,7 @@ void log_print(lv_log_level_t level, const char * buf) {
 }
 
 // Declare function to get the Raw Touchscreen data
-void touchscreen_read_pts(bool, bool, int, int);
+void touchscreen_read_pts(bool, bool *, int *, int *, float *);
 
 /* Declare function to display a user instruction upon startup */
 void lv_display_instruction(void);
@@ -175,11 +188,11 @@ void gather_cal_data(void) {
     x_avg = 0;
     y_avg = 0;
     
-    touchscreen_read_pts(reset, &finished, &x_avg, &y_avg);
+    touchscreen_read_pts(reset, &finished, &x_avg, &y_avg, &ts_residual[i]);
 
     reset = false;
     while (!finished) {
-      touchscreen_read_pts(reset, &finished, &x_avg, &y_avg);
+      touchscreen_read_pts(reset, &finished, &x_avg, &y_avg, &ts_residual[i]);
 
       /* found out the hard way that if I don't do this, the screen doesn't update */
       lv_task_handler();
@@ -240,7 +253,7 @@ void check_calibration_results(void) {
     Serial.println(s);
 
     error = (int) sqrt( sq(x_scr - scr_points[i][0]) + sq(y_scr - scr_points[i][1]) );
-    s = String("error = " + String(error) );
+    s = String("error = " + String(error) + " residual error of touch point = " + String(ts_residual[i]) );
     Serial.println(s);
     Serial.println();
   }
@@ -256,6 +269,28 @@ void check_calibration_results(void) {
   Serial.println("******************************************************************");
 }
 
+/* store the coefficients in NVS as printed "USE THE FOLLOWING COEFFICIENT VALUES" by check_calibration_results(),
+   then read them back into the pref_ variables to make sure they are there */
+void store_calibration_results(void) {
+  float coeffs[UNI_TOUCH_CAL_NUM] = { alphaX, betaX, deltaX, -alphaY, -betaY, SCREEN_WIDTH-deltaY };
+
+  nvs.begin(UNI_NVS_NAMESPACE, false);
+  if (sizeof(coeffs) != nvs.putBytes(UNI_TOUCH_CAL_NVS_KEY, coeffs, sizeof(coeffs))) {
+    Serial.println("ERROR: could not store the coefficients in NVS; copy them by hand");
+  }
+  memset(coeffs, 0, sizeof(coeffs));
+  if (sizeof(coeffs) == nvs.getBytes(UNI_TOUCH_CAL_NVS_KEY, coeffs, sizeof(coeffs))) {
+    pref_alphaX = coeffs[0]; pref_betaX = coeffs[1]; pref_deltaX = coeffs[2];
+    pref_alphaY = coeffs[3]; pref_betaY = coeffs[4]; pref_deltaY = coeffs[5];
+    s = String("Stored in NVS X:  alpha_x = " + String(pref_alphaX, 3) + ", beta_x = " + String(pref_betaX, 3) + ", delta_x = " + String(pref_deltaX, 3) );
+    Serial.println(s);
+    s = String("Stored in NVS Y:  alpha_y = " + String(pref_alphaY, 3) + ", beta_y = " + String(pref_betaY, 3) + ", delta_y = " + String(pref_deltaY, 3) );
+    Serial.println(s);
+    Serial.println("UniRemoteCYD will use these at its next boot");
+  }
+  nvs.end();
+}
+
 void setup() {
   String LVGL_Arduino = String("LVGL Library Version: ") + lv_version_major() + "." + lv_version_minor() + "." + lv_version_patch();
   Serial.begin(115200);
@@ -300,6 +335,9 @@ void setup() {
 
   /* display stored correction data and display generated vs measured screen points */
   check_calibration_results();
+
+  /* store them where UniRemoteCYD will find them */
+  store_calibration_results();
 }
 
 void loop() {
@@ -309,19 +347,17 @@ void loop() {
 }
  
 /* Function to read a number of points from the resistive touchscreen as the user taps
-   a stylus on displayed crosshairs.  Once the samples have been collected, they are
-   filtered to remove outliers and then averaged and the average x & y are returned to the caller. */
-void touchscreen_read_pts(bool reset, bool *finished, int *x_avg, int *y_avg) {
-  /* nr_samples = samples taken; good_samples = samples used, samples = array of 100 samples */
-  static int i, nr_samples, good_samples;
-  static uint32_t samples[100][2];
-
-  /* coordinates to shift and rotate touch screen coordinates to display coordinates */
-  static float mean_x, mean_y, filt_mean_x, filt_mean_y, stdev_x, stdev_y;
+   a stylus on displayed crosshairs.  Once enough samples have been collected, outliers are
+   removed using the median and MAD (see uni_touch_stats.h) and the filtered average x & y are
+   returned to the caller along with the residual error of that average. Sampling stops early
+   once the filtered average stops moving (converged), or after UNI_TS_MAX_SAMPLES samples. */
+void touchscreen_read_pts(bool reset, bool *finished, int *x_avg, int *y_avg, float *residual) {
+  static uni_ts_point_t samples;
+  uni_ts_estimate_t est;
 
   /* caller resets the sample run at each new displayed crosshair */
   if (reset) {
-    nr_samples = 0;
+    uni_ts_point_reset(&samples);
     *x_avg = 0;
     *y_avg = 0;
     *finished = false;
@@ -331,65 +367,28 @@ void touchscreen_read_pts(bool reset, bool *finished, int *x_avg, int *y_avg) {
   TouchPoint p = tsSPI.getTouch();
   if (p.zRaw > 200) { // this threshold of 200 seems to work pretty well
     // Get Touchscreen points
-    samples[nr_samples][0] = p.xRaw;
-    samples[nr_samples][1] = p.yRaw;
+    uni_ts_point_add(&samples, p.xRaw, p.yRaw);
 // NOTE WE ARE USING XPT2046_Bitbang INSTEAD OF TFT_eSPI
 
-    s = String("x, y = " + String(samples[nr_samples][0]) + ", " + String(samples[nr_samples][1]) );
+    s = String("x, y = " + String(p.xRaw) + ", " + String(p.yRaw) );
     Serial.println(s);
 
-    nr_samples++;
-
-    /* first compute the x & y averages of all the samples */
-    if (nr_samples >= 100) {
-      mean_x = 0;
-      mean_y = 0;
-      for (i = 0; i < 100; i++) {
-        mean_x += (float)samples[i][0];
-        mean_y += (float)samples[i][1];
-      }
-      mean_x = mean_x / (float)nr_samples;
-      mean_y = mean_y / (float)nr_samples;
-      s = String("Unfiltered values:  mean_x = " + String(mean_x) + ", mean_y = " + String(mean_y));
+    if (uni_ts_point_estimate(&samples, &est)) {
+      s = String("Unfiltered values:  mean_x = " + String(samples.all_x.mean) + ", mean_y = " + String(samples.all_y.mean));
       Serial.println(s);
-
-      /* now compute the x & y standard deviations of all the samples */
-      stdev_x = 0;
-      stdev_y = 0;
-      for (i = 0; i < 100; i++) {
-        stdev_x += sq((float)samples[i][0] - mean_x);
-        stdev_y += sq((float)samples[i][1] - mean_y);
-      }
-      stdev_x = sqrt(stdev_x / (float)nr_samples);
-      stdev_y = sqrt(stdev_y / (float)nr_samples);
-
-      s = String("stdev_x = " + String(stdev_x) + ", stdev_y = " + String(stdev_y));
-      Serial.println(s);   
-
-      /* now average the samples that are less than one standard deviation from the mean */
-      /* this filtering is called "outlier rejection," and is included because outliers were observed in testing */
-      good_samples = 0;
-      filt_mean_x = 0;
-      filt_mean_y = 0;
-      for (i = 0; i < 100; i++) {
-        if ((abs((float)samples[i][0] - mean_x) < stdev_x) && (abs((float)samples[i][1] - mean_y) < stdev_y)) {
-          filt_mean_x += (float)samples[i][0];
-          filt_mean_y += (float)samples[i][1];
-          good_samples++;
-        }        
-      }
-
-      s = String("Good samples = " + String(good_samples));
-      Serial.println(s);      
-
-      filt_mean_x = filt_mean_x / (float)good_samples;
-      filt_mean_y = filt_mean_y / (float)good_samples;
-      s = String("Filtered values:  filt_mean_x = " + String(filt_mean_x) + ", filt_mean_y = " + String(filt_mean_y));
+      s = String("stdev_x = " + String(uni_welford_stdev(&samples.all_x)) + ", stdev_y = " + String(uni_welford_stdev(&samples.all_y)));
+      Serial.println(s);
+      s = String("median_x = " + String(est.median_x) + ", median_y = " + String(est.median_y) + ", MAD_x = " + String(est.mad_x) + ", MAD_y = " + String(est.mad_y));
+      Serial.println(s);
+      s = String("Good samples = " + String(est.good) + " of " + String(est.num) + ", residual error = " + String(est.residual));
+      Serial.println(s);
+      s = String("Filtered values:  filt_mean_x = " + String(est.x) + ", filt_mean_y = " + String(est.y));
       Serial.println(s);
       Serial.println();
 
-      *x_avg = (int)mean_x;
-      *y_avg = (int)mean_y;
+      *residual = est.residual;
+      *x_avg = (int) lroundf(est.x);
+      *y_avg = (int) lroundf(est.y);
 
       *finished = true;
     }
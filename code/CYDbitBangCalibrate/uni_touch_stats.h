@@ -0,0 +1,202 @@
+/* Author: https://github.com/Mark-MDO47  Mar. 2, 2025
+ *  https://github.com/Mark-MDO47/UniRemote
+ */
+
+/*
+   Copyright 2025 Mark Olson
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+/*
+ * uni_touch_stats - statistics for touchscreen samples at one calibration point
+ *
+ * Used by CYDbitBangCalibrate; no Arduino or LVGL calls, so other sketches can include it too.
+ *
+ * Welford    - mean and standard deviation in one pass, a sample at a time, without keeping the samples.
+ *              Used for the unfiltered statistics of all samples and for the filtered mean.
+ * median/MAD - the median and the median absolute deviation of the samples are not pulled around by
+ *              outliers the way the mean and standard deviation are. A sample is an outlier if it is
+ *              more than UNI_TS_OUTLIER_K robust standard deviations (1.4826 * MAD) from the median
+ *              in x or in y.
+ * converged  - the standard error of the filtered mean (its standard deviation divided by the square
+ *              root of the number of good samples) is the "residual error" of the point. Once it is
+ *              at most UNI_TS_STDERR_MAX after at least UNI_TS_MIN_SAMPLES samples, more samples
+ *              will not move the point enough to matter and sampling can stop.
+ *
+ * Raw touchscreen units are about 12 per screen pixel on the CYD, so UNI_TS_STDERR_MAX 2.0 is
+ *    well under a pixel.
+ */
+
+#ifndef UNI_TOUCH_STATS_H
+#define UNI_TOUCH_STATS_H 1
+
+#include <stdint.h>
+#include <stdlib.h> // for qsort()
+#include <math.h>   // for sqrtf() and fabsf()
+
+#define UNI_TS_MAX_SAMPLES 100     // most samples at one point
+#define UNI_TS_MIN_SAMPLES 20      // fewest samples before converged can be declared
+#define UNI_TS_STDERR_MAX 2.0f     // converged when the residual error is at most this, raw touchscreen units
+#define UNI_TS_OUTLIER_K 3.0f      // outlier if more than this many robust standard deviations from the median
+#define UNI_TS_MAD_TO_SIGMA 1.4826f // MAD times this estimates the standard deviation for normal noise
+
+// Welford running mean and variance
+typedef struct {
+  uint32_t num;   // samples so far
+  float    mean;  // mean so far
+  float    m2;    // sum of squared differences from the mean so far
+} uni_welford_t;
+
+// all the samples at one point plus the unfiltered running statistics
+typedef struct {
+  uint16_t      x[UNI_TS_MAX_SAMPLES];
+  uint16_t      y[UNI_TS_MAX_SAMPLES];
+  uint16_t      num;    // samples in x[] and y[]
+  uni_welford_t all_x;  // unfiltered statistics of all samples
+  uni_welford_t all_y;
+} uni_ts_point_t;
+
+// the filtered estimate of one point
+typedef struct {
+  float    x, y;          // filtered mean
+  float    median_x, median_y;
+  float    mad_x, mad_y;  // median absolute deviation
+  float    stdev_x, stdev_y; // of the good samples
+  float    residual;      // standard error of the filtered mean; raw touchscreen units
+  uint16_t good;          // samples that were not outliers
+  uint16_t num;           // samples taken
+} uni_ts_estimate_t;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_welford_reset() - start over
+//       returns: nothing
+//
+static void uni_welford_reset(uni_welford_t * p_w) {
+  p_w->num = 0;
+  p_w->mean = p_w->m2 = 0.0f;
+} // end uni_welford_reset()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_welford_add() - add one sample
+//       returns: nothing
+//
+static void uni_welford_add(uni_welford_t * p_w, float p_val) {
+  float delta = p_val - p_w->mean;
+  p_w->num += 1;
+  p_w->mean += delta / (float) p_w->num;
+  p_w->m2 += delta * (p_val - p_w->mean);
+} // end uni_welford_add()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_welford_stdev() - population standard deviation so far
+//       returns: the standard deviation; zero if no samples
+//
+static float uni_welford_stdev(const uni_welford_t * p_w) {
+  return((0 == p_w->num) ? 0.0f : sqrtf(p_w->m2 / (float) p_w->num));
+} // end uni_welford_stdev()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_ts_cmp_float() - qsort() compare for float
+//
+static int uni_ts_cmp_float(const void * p_a, const void * p_b) {
+  float a = *(const float *) p_a;
+  float b = *(const float *) p_b;
+  return((a < b) ? -1 : ((a > b) ? 1 : 0));
+} // end uni_ts_cmp_float()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_ts_median() - median of p_num values; p_vals is sorted in place
+//       returns: the median; zero if p_num is zero
+//
+static float uni_ts_median(float * p_vals, uint16_t p_num) {
+  if (0 == p_num) return(0.0f);
+  qsort(p_vals, p_num, sizeof(p_vals[0]), uni_ts_cmp_float);
+  if (1 == (p_num % 2)) return(p_vals[p_num/2]);
+  return((p_vals[p_num/2 - 1] + p_vals[p_num/2]) / 2.0f);
+} // end uni_ts_median()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_ts_point_reset() - start a new point
+//       returns: nothing
+//
+static void uni_ts_point_reset(uni_ts_point_t * p_pt) {
+  p_pt->num = 0;
+  uni_welford_reset(&p_pt->all_x);
+  uni_welford_reset(&p_pt->all_y);
+} // end uni_ts_point_reset()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_ts_point_add() - add one sample
+//       returns: non-zero if the sample was kept; zero if UNI_TS_MAX_SAMPLES were already taken
+//
+static uint8_t uni_ts_point_add(uni_ts_point_t * p_pt, uint16_t p_x, uint16_t p_y) {
+  if (p_pt->num >= UNI_TS_MAX_SAMPLES) return(0);
+  p_pt->x[p_pt->num] = p_x;
+  p_pt->y[p_pt->num] = p_y;
+  p_pt->num += 1;
+  uni_welford_add(&p_pt->all_x, (float) p_x);
+  uni_welford_add(&p_pt->all_y, (float) p_y);
+  return(1);
+} // end uni_ts_point_add()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_ts_point_estimate() - filtered estimate of the point from the samples so far
+//       returns: non-zero if converged (see top of file) or UNI_TS_MAX_SAMPLES were taken
+//
+// p_est gets the filtered mean (outliers by median/MAD removed), the robust statistics and the residual error
+//
+static uint8_t uni_ts_point_estimate(const uni_ts_point_t * p_pt, uni_ts_estimate_t * p_est) {
+  float work[UNI_TS_MAX_SAMPLES];
+  float limit_x, limit_y;
+  uni_welford_t good_x, good_y;
+  uint16_t idx;
+
+  p_est->num = p_pt->num;
+
+  for (idx = 0; idx < p_pt->num; idx++) work[idx] = (float) p_pt->x[idx];
+  p_est->median_x = uni_ts_median(work, p_pt->num);
+  for (idx = 0; idx < p_pt->num; idx++) work[idx] = fabsf((float) p_pt->x[idx] - p_est->median_x);
+  p_est->mad_x = uni_ts_median(work, p_pt->num);
+  for (idx = 0; idx < p_pt->num; idx++) work[idx] = (float) p_pt->y[idx];
+  p_est->median_y = uni_ts_median(work, p_pt->num);
+  for (idx = 0; idx < p_pt->num; idx++) work[idx] = fabsf((float) p_pt->y[idx] - p_est->median_y);
+  p_est->mad_y = uni_ts_median(work, p_pt->num);
+
+  // at least one raw unit so a quiet touchscreen (MAD zero) does not throw out samples one unit off
+  limit_x = UNI_TS_OUTLIER_K * UNI_TS_MAD_TO_SIGMA * p_est->mad_x;
+  if (limit_x < 1.0f) limit_x = 1.0f;
+  limit_y = UNI_TS_OUTLIER_K * UNI_TS_MAD_TO_SIGMA * p_est->mad_y;
+  if (limit_y < 1.0f) limit_y = 1.0f;
+
+  uni_welford_reset(&good_x);
+  uni_welford_reset(&good_y);
+  for (idx = 0; idx < p_pt->num; idx++) {
+    if (fabsf((float) p_pt->x[idx] - p_est->median_x) > limit_x) continue;
+    if (fabsf((float) p_pt->y[idx] - p_est->median_y) > limit_y) continue;
+    uni_welford_add(&good_x, (float) p_pt->x[idx]);
+    uni_welford_add(&good_y, (float) p_pt->y[idx]);
+  }
+  p_est->good = (uint16_t) good_x.num;
+  p_est->x = good_x.mean;
+  p_est->y = good_y.mean;
+  p_est->stdev_x = uni_welford_stdev(&good_x);
+  p_est->stdev_y = uni_welford_stdev(&good_y);
+  p_est->residual = (0 == p_est->good) ? 0.0f :
+      sqrtf((p_est->stdev_x * p_est->stdev_x + p_est->stdev_y * p_est->stdev_y) / (float) p_est->good);
+
+  if (p_pt->num >= UNI_TS_MAX_SAMPLES) return(1);
+  return(((p_pt->num >= UNI_TS_MIN_SAMPLES) && (p_est->good > 0) && (p_est->residual <= UNI_TS_STDERR_MAX)) ? 1 : 0);
+} // end uni_ts_point_estimate()
+
+#endif // UNI_TOUCH_STATS_H
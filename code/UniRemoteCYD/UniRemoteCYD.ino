@@ -179,7 +179,29 @@ MFRC522::MIFARE_Key key;
 
 #include <esp_now.h>   // for ESP-NOW
 #include <WiFi.h>      // for ESP-NOW
+#include <esp_timer.h> // for esp_timer_get_time() command latency timing
+#include <esp_wifi.h>  // for the ESP-NOW PHY rate and WiFi channel
+#include <Preferences.h> // for remembering the WiFi channel of each receiver in NVS
 #include "../wifi_key.h"  // WiFi secrets
+#include "../UniRemoteRcvrTemplate/UniRemoteFrames.h" // what goes in an ESP-NOW message besides the command
+#include "../UniRemoteRcvrTemplate/UniRemoteTimer.h"  // deadlines and periodic jobs; safe when millis() wraps
+#include "../UniRemoteRcvrTemplate/UniRemotePerf.h"   // performance counters and latency histograms
+#include "../UniRemoteRcvrTemplate/UniRemoteSerialCmd.h" // commands typed on the Serial port
+#include "../UniRemoteRcvrTemplate/UniRemoteStall.h"  // sections that stop loop() too long; watchdog; report survives a reset
+#include "../UniRemoteRcvrTemplate/UniRemoteTrace.h"  // timeline of states, scans, sends, callbacks, LVGL and buttons
+#include "../UniRemoteRcvrTemplate/UniRemoteCmdParse.h" // MAC address, alias, lead time and display of a command in one pass
+#include "../UniRemoteRcvrTemplate/UniRemoteJournal.h" // status events kept in flash across resets
+
+#define UNI_SEND_TIMING_TRAILER 1 // non-zero to append timing trailer after the command; see UniRemoteFrames.h
+#define UNI_SEND_TIME_BEACON_MSEC 1000 // how often to broadcast a time beacon so receivers can "execute at"; zero to never send
+#define UNI_ADAPTIVE_RATE 1       // non-zero to pick the ESP-NOW PHY rate for each receiver from its link quality
+#define UNI_CHANNEL_PROBE 1       // non-zero to find the WiFi channel of each receiver and remember it in NVS
+#define UNI_RCVR_DIRECTORY 1      // non-zero to keep a directory of receivers from their announcements; cards can use an alias
+#define UNI_PEERS_PREWARM 1       // non-zero to remember recently used receivers in NVS and register them at boot
+#define UNI_PERF 1                // non-zero to keep latency histograms; "perf" on Serial and a diagnostics screen show them
+#define UNI_STALL_WDT_MSEC 8000   // loop() must come around this often or the watchdog resets the CYD; zero for no watchdog
+#define UNI_TRACE 1               // non-zero to keep a timeline of what happened; "trace" on Serial, then uni_trace_json.py
+#define UNI_JOURNAL 1             // non-zero to keep status events in flash across resets; "journal" on Serial prints them
 
 
 #if INCLUDE_QR_SENSOR
@@ -256,8 +278,86 @@ XPT2046_Touchscreen touchscreen(XPT2046_CS, XPT2046_IRQ);
 // Touchscreen coordinates: (x, y) and pressure (z)
 int x, y, z;
 
+// Touchscreen calibration - raw touch (p.x, p.y) to screen (x, y)
+//   x = alpha_y * p.x + beta_y * p.y + delta_y     y = alpha_x * p.x + beta_x * p.y + delta_x
+//   CYDbitBangCalibrate stores the six coefficients in NVS (namespace UNI_NVS_NAMESPACE, key UNI_TOUCH_CAL_NVS_KEY)
+//      in the order it prints them: alpha_x, beta_x, delta_x, alpha_y, beta_y, delta_y
+//   setup() turns them into Q16 fixed point once so cyd_input_read() does no float math
+//   if none are stored (or they make no sense) the defaults below are used; they came from one CYD
+#define UNI_TOUCH_CAL_NVS_KEY "touchcal"  // NVS blob: six float coefficients from CYDbitBangCalibrate
+#define UNI_TOUCH_CAL_NUM 6
+#define UNI_TOUCH_CAL_Q 16                // fraction bits in the fixed point coefficients
+#define UNI_TOUCH_CAL_MAX_SLOPE 1.0       // larger alpha or beta is not a calibration; also keeps the math inside int32_t
+#define UNI_TOUCH_CAL_MAX_OFFSET 8192.0   // same for delta
+static const float g_touch_cal_default[UNI_TOUCH_CAL_NUM] = { -0.092, 0.000, 334.610, -0.001, 0.066, -14.307 };
+typedef struct {
+  int32_t alpha_x, beta_x, delta_x; // Q16; gives screen y
+  int32_t alpha_y, beta_y, delta_y; // Q16; gives screen x
+  uint8_t from_nvs;                 // non-zero if the coefficients came from NVS
+} uni_touch_cal_t;
+static uni_touch_cal_t g_touch_cal;
+
+// Touchscreen sampling - see uni_touch_sample()
+//   UNI_TOUCH_FILTER 0 - cyd_input_read() bit-bangs one reading every time LVGL asks and takes it if zRaw > 200
+//   UNI_TOUCH_FILTER 1 - a timer job reads the touchscreen every UNI_TOUCH_SAMPLE_MSEC and filters it;
+//                        cyd_input_read() just hands LVGL the last filtered point
+#define UNI_TOUCH_FILTER 1            // non-zero for filtered touch sampling on a schedule
+#define UNI_TOUCH_SAMPLE_MSEC 15      // read the touchscreen this often (LVGL reads the input every 30 msec)
+#define UNI_TOUCH_USE_IRQ 1           // non-zero to skip the bit-bang read when T_IRQ says nobody is touching
+#define UNI_TOUCH_MEDIAN_N 3          // readings per sample; the median of each of x, y, z is used (odd, at most 7)
+#define UNI_TOUCH_IIR_SHIFT 1         // smoothing while pressed: point += (new - point) / 2^UNI_TOUCH_IIR_SHIFT
+#define UNI_TOUCH_Z_PRESS 300         // pressure needed to become pressed
+#define UNI_TOUCH_Z_RELEASE 150       // pressure below this is released; between the two the state does not change
+#define UNI_TOUCH_PRESS_SAMPLES 2     // this many samples in a row above UNI_TOUCH_Z_PRESS to become pressed
+#define UNI_TOUCH_REPORT_MSEC 0       // non-zero: print touch sampling counts on Serial this often (60000 is good)
+static_assert((1 == (UNI_TOUCH_MEDIAN_N % 2)) && (UNI_TOUCH_MEDIAN_N <= 7), "UNI_TOUCH_MEDIAN_N must be odd and at most 7");
+static_assert(UNI_TOUCH_Z_RELEASE < UNI_TOUCH_Z_PRESS, "UNI_TOUCH_Z_RELEASE must be below UNI_TOUCH_Z_PRESS");
+#define UNI_TOUCH_IIR_FRAC 4          // fraction bits of the smoothed point
+
+typedef struct {
+  uint8_t  pressed;         // filtered state given to LVGL
+  uint8_t  press_count;     // samples in a row above UNI_TOUCH_Z_PRESS while released
+  int32_t  x_iir, y_iir;    // smoothed screen point, UNI_TOUCH_IIR_FRAC fraction bits
+  int16_t  x, y;            // last filtered screen point given to LVGL
+  uint16_t z;               // median pressure of the last sample
+  uint32_t sample_num;      // samples taken
+  uint32_t bitbang_num;     // ts.getTouch() calls
+  uint32_t usec_bitbang;    // time in ts.getTouch()
+  uint32_t press_num;       // released to pressed
+} uni_touch_t;
+static uni_touch_t g_touch;
+
 #define DRAW_BUF_SIZE (SCREEN_WIDTH * SCREEN_HEIGHT / 10 * (LV_COLOR_DEPTH / 8))
-uint32_t draw_buf[DRAW_BUF_SIZE / 4];
+
+// display flushing
+//   USE_DISPLAY_DMA 0 - lv_tft_espi_create(): one draw buffer; LVGL renders a stripe, then waits while it goes out over SPI
+//   USE_DISPLAY_DMA 1 - two draw buffers in DMA-capable memory; each stripe goes out by SPI DMA while
+//                       LVGL renders the next stripe into the other buffer
+#define USE_DISPLAY_DMA 1             // 1 for two draw buffers and SPI DMA flush; 0 for lv_tft_espi_create()
+#define UNI_DISPLAY_TIMING_MSEC 0     // non-zero: print frame and flush times on Serial this often (10000 is good)
+#if USE_DISPLAY_DMA
+// A library for interfacing with LCD displays; lv_tft_espi_create() uses it too
+// https://github.com/Bodmer/TFT_eSPI
+#include <TFT_eSPI.h>
+#include <esp_heap_caps.h> // for heap_caps_malloc() of DMA-capable memory
+static TFT_eSPI g_tft = TFT_eSPI(SCREEN_WIDTH, SCREEN_HEIGHT);
+static uint8_t * g_draw_buf_dma[2] = { 0, 0 };
+static uint8_t * g_draw_buf_one = (uint8_t *) 0; // malloc() only if the DMA buffers cannot be allocated
+#else  // not USE_DISPLAY_DMA
+uint32_t draw_buf[DRAW_BUF_SIZE / 4]; // the one draw buffer for lv_tft_espi_create()
+#endif // USE_DISPLAY_DMA
+
+// frame and flush times from the LVGL display events; see uni_display_timing_event()
+typedef struct {
+  int64_t  usec_refr_start;   // esp_timer_get_time() at LV_EVENT_REFR_START
+  int64_t  usec_flush_start;  // esp_timer_get_time() at LV_EVENT_FLUSH_START
+  uint32_t frame_num;         // screen refreshes
+  uint32_t flush_num;         // stripes flushed
+  uint32_t usec_frame_max;    // longest refresh
+  uint64_t usec_frame_sum;    // time in refreshes: rendering plus flushing
+  uint64_t usec_flush_sum;    // time LVGL spent in the flush callback (waiting for SPI)
+} uni_display_timing_t;
+static uni_display_timing_t g_display_timing;
 
 // coloration
 lv_style_t g_style_blue, g_style_yellow, g_style_red, g_style_green, g_style_grey, g_style_ghost;
@@ -266,7 +366,8 @@ lv_style_t g_style_blue, g_style_yellow, g_style_red, g_style_green, g_style_gre
 lv_style_t g_style_screen_width_btn_height;
 lv_style_t g_style_screen_width_comm_height;
 
-const int32_t CYDsampleDelayMsec = 5;
+const int32_t CYDsampleDelayMsec = 5; // loop() sleep while a message is being sent or waiting for its callback
+#define UNI_LOOP_SLEEP_MAX_MSEC 30     // longest loop() sleep; the RFID reader and touch screen are polled at least this often
 
 // ESP-NOW definitions
 static uint8_t g_rcvr_mac_addr[ESP_NOW_ETH_ALEN * ESP_NOW_MAX_TOTAL_PEER_NUM];
@@ -277,14 +378,71 @@ esp_now_peer_info_t rcvr_peer_info; // will be filled in later
 
 typedef int32_t uni_esp_now_status_t;
 #define UNI_ESP_NOW_CB_NEVER_HAPPENED -1 // my own status
-static uni_esp_now_status_t g_last_send_callback_status = UNI_ESP_NOW_CB_NEVER_HAPPENED; // -1 means never happened
-static uint16_t g_msg_last_esp_now_rebuild_msg_cb = 0;    // nonzero when need to rebuild status message
+static uni_esp_now_status_t g_last_send_callback_status = UNI_ESP_NOW_CB_NEVER_HAPPENED; // most recent command outcome; -1 means never happened
 static uint16_t g_msg_last_esp_now_display_status_cb = 0; // nonzero when need to display status message on screen
 static uint16_t g_msg_last_esp_now_reset_esp_now = 0;     // nonzero when need to completely reset esp-now
-static char g_msg_last_esp_now_result_status[1024];
-static char g_msg_last_opr_comm_status[1024];
-static char g_msg_prev_opr_comm_status[1024];
+
+// status events - what happened to each command, kept as small records and made into text only when
+//    a label is about to show it (see uni_status_text()). Each code has up to two texts:
+//    the result for the last status label and the operator text shown while sending.
+#define UNI_STATUS_NONE        0 // nothing yet
+#define UNI_STATUS_OPR_SENDING 1 // operator pressed SEND
+#define UNI_STATUS_OPR_CLEAR   2 // operator pressed CLEAR
+#define UNI_STATUS_OPR_ABORT   3 // operator pressed ABORT
+#define UNI_STATUS_SEND_OK     4 // esp_now_send() took it
+#define UNI_STATUS_SEND_ERR    5 // esp_now_send() did not; arg is the esp_err_t
+#define UNI_STATUS_CB_OK       6 // send callback success; arg is link OK %, arg2 the rate index
+#define UNI_STATUS_CB_FAIL     7 // send callback fail; arg is link OK %, arg2 the rate index
+#define UNI_STATUS_BAD_ADDR    8 // bad MAC address or unknown alias
+#define UNI_STATUS_PEER_FAIL   9 // could not register the receiver as a peer
+#define UNI_STATUS_CODE_NUM   10
+
+#define UNI_STATUS_F_CMD_TEXT 0x01 // result text ends with the command as scanned; kept in g_status_cmd_text
+#define UNI_STATUS_F_ESP_ERR  0x02 // result text ends with the esp_err_t text of arg
+#define UNI_STATUS_F_LINK     0x04 // result text ends with the link quality, unless arg2 is UNI_STATUS_NO_LINK
+
+#define UNI_STATUS_RESULT 0        // uni_status_text(): the last status label
+#define UNI_STATUS_OPR    1        // uni_status_text(): the operator text
+#define UNI_STATUS_RING_NUM 16     // status events kept for "status" on Serial
+#define UNI_STATUS_TEXT_LEN 384    // longest status text: the longest format, a whole command and an error text
+#define UNI_STATUS_NO_LINK 0xFF    // arg2: no link quality for this one
+
+typedef struct {
+  const char * name;               // for "status" on Serial
+  const char * result_fmt;         // printf format with the cmd_num; NULL if it does not change the result
+  const char * opr_fmt;            // printf format with the cmd_num; NULL if it does not change the operator text
+  uint8_t flags;                   // UNI_STATUS_F_*
+} uni_status_def_t;
+static const uni_status_def_t g_status_defs[UNI_STATUS_CODE_NUM] = {
+  { "none",        "",                                                NULL,                                 0 },
+  { "opr_sending", NULL,                                              "\nESP-NOW sending CMD #%d ",         0 },
+  { "opr_clear",   NULL,                                              "\nESP-NOW OPR CLEAR CMD #%d ",       0 },
+  { "opr_abort",   NULL,                                              "\nESP-NOW OPR ABORT CMD #%d ",       0 },
+  { "send_ok",     "ESP-NOW send success CMD #%d",                    "\nESP-NOW send success CMD #%d ",    UNI_STATUS_F_CMD_TEXT },
+  { "send_err",    "ESP-NOW ERROR: sending CMD #%d:",                 "\nESP-NOW send ERROR CMD #%d ",      UNI_STATUS_F_CMD_TEXT | UNI_STATUS_F_ESP_ERR },
+  { "cb_ok",       "ESP-Now callback OK CMD #%d",                     "\nESP-NOW success CMD #%d ",         UNI_STATUS_F_LINK },
+  { "cb_fail",     "ESP-Now callback FAIL CMD #%d",                   "\nESP-NOW FAIL CMD #%d ",            UNI_STATUS_F_LINK },
+  { "bad_addr",    "ERROR: CMD #%d bad MAC address or unknown alias", NULL,                                 0 },
+  { "peer_fail",   "ERROR: CMD #%d ESP-NOW reg/add peer failed",      NULL,                                 0 },
+};
+
+typedef struct {
+  uint32_t msec;                   // millis() when it happened
+  int32_t  arg;                    // see UNI_STATUS_*
+  uint8_t  cmd_num;                // g_last_scanned_cmd_count of the command
+  uint8_t  code;                   // UNI_STATUS_*
+  uint8_t  arg2;                   // see UNI_STATUS_*
+} uni_status_ev_t;
+static uni_status_ev_t g_status_ring[UNI_STATUS_RING_NUM];
+static uint16_t g_status_ring_put = 0;   // next record to write
+static uint32_t g_status_num = 0;        // status events ever; the ring has the last UNI_STATUS_RING_NUM
+static uni_status_ev_t g_status_latest[2];  // latest that has a UNI_STATUS_RESULT text, and UNI_STATUS_OPR text
+static uint32_t g_status_waiting_shown = 0; // g_status_num+1 when the last status label shows "No scanned command" for it
+static char g_status_text[UNI_STATUS_TEXT_LEN]; // the one place status text is made
+static char g_status_cmd_text[ESP_NOW_MAX_DATA_LEN+1]; // the scanned command of the latest UNI_STATUS_F_CMD_TEXT event
+static uint8_t g_status_cmd_text_num = 0;  // its cmd_num; uni_read_picc() clears g_cmd_queue while polling, so keep a copy
 static char g_cmd_in_proc_or_prev[ESP_NOW_MAX_DATA_LEN+1];
+static uint32_t g_cmd_in_proc_or_prev_num = 0; // changes each time g_cmd_in_proc_or_prev is filled
 
 #define UNI_CMD_QNUM_NOW    0 // 0==sending now, 1==next up
 #define UNI_CMD_QNUM_NEXT   1 // 0==sending now, 1==next up
@@ -294,9 +452,141 @@ typedef struct {
   uint16_t scanned_cmd_len;
 } uni_cmd_queue_t;
 static uni_cmd_queue_t g_cmd_queue[UNI_CMD_QNUM_NUM]; // queue for msgs; 0==sending now, 1==next up
+static_assert(sizeof(g_cmd_queue[0].scanned_cmd) >= sizeof(g_status_cmd_text), "uni_status_note() copies sizeof(g_status_cmd_text)-1 bytes of scanned_cmd");
+
+// per-stage latency for the command being sent; all from esp_timer_get_time()
+//   reported at loop() level after the send callback; the receiver reports its own stages
+typedef struct {
+  int64_t usec_scan_start;   // before the scan that found the command
+  int64_t usec_scan_done;    // scan found the command
+  int64_t usec_parse_done;   // MAC address decoded and peer registered
+  int64_t usec_sent;         // just before esp_now_send()
+  int64_t usec_cb;           // send callback (MAC ACK or fail)
+} uni_cmd_timing_t;
+static uni_cmd_timing_t g_cmd_timing;
+static int16_t g_esp_now_peer_idx = -1; // index into g_rcvr_mac_addr[] for command being sent
+static uint32_t g_rcvr_usec_air_min[ESP_NOW_MAX_TOTAL_PEER_NUM]; // smallest send-to-ACK time to each peer; 0 if none yet
+static uint32_t g_rcvr_msec_prev_send[ESP_NOW_MAX_TOTAL_PEER_NUM]; // millis() of last command sent to each peer
+
+// link quality to each peer from the send callbacks; used to pick the PHY rate for each peer
+//   a receiver only sees its own side (signal strength; see uni_remote_rcvr_get_sender_stats())
+//   we see whether the MAC layer got an ACK, which is what costs airtime and retries
+#define UNI_LINK_OK_AVG_DIV   8  // success average moves 1/UNI_LINK_OK_AVG_DIV of the way each send
+#define UNI_LINK_UP_OK_NUM    8  // this many successes in a row (and a good average) to try the next faster rate
+#define UNI_LINK_UP_OK_PCT   95  // success average (percent) needed to try the next faster rate
+#define UNI_LINK_SCREEN_NUM   4  // most peers in the link table on the screen; Serial gets all of them
+typedef struct {
+  uint32_t send_num;     // commands sent to this peer that got a send callback
+  uint32_t fail_num;     // of those, how many were ESP_NOW_SEND_FAIL
+  uint16_t ok_avg_x100;  // success average in hundredths of a percent (10000 == every one OK)
+  uint8_t  ok_in_row;    // successes since the last fail or rate change
+  uint8_t  fail_in_row;  // fails since the last success
+  uint8_t  rate_idx;     // index into g_link_rates[]
+} uni_link_t;
+static uni_link_t g_rcvr_link[ESP_NOW_MAX_TOTAL_PEER_NUM];
+typedef struct {
+  wifi_phy_rate_t rate;
+  wifi_phy_mode_t phymode;
+  const char *    name;
+} uni_link_rate_t;
+// slowest (most robust; the ESP-NOW default) to fastest (least airtime)
+static const uni_link_rate_t g_link_rates[] = {
+  { WIFI_PHY_RATE_1M_L,  WIFI_PHY_MODE_11B, "1M"  },
+  { WIFI_PHY_RATE_2M_L,  WIFI_PHY_MODE_11B, "2M"  },
+  { WIFI_PHY_RATE_5M_L,  WIFI_PHY_MODE_11B, "5M"  },
+  { WIFI_PHY_RATE_11M_L, WIFI_PHY_MODE_11B, "11M" },
+  { WIFI_PHY_RATE_12M,   WIFI_PHY_MODE_11G, "12M" },
+  { WIFI_PHY_RATE_24M,   WIFI_PHY_MODE_11G, "24M" },
+};
+#define UNI_LINK_RATE_NUM (sizeof(g_link_rates)/sizeof(g_link_rates[0]))
+static uint16_t g_show_link_table = 0; // non-zero to show the link table instead of the status on the SHOW_STAT screen
+
+// WiFi channel of each peer; ESP-NOW only reaches a receiver on its own channel
+//   a receiver that connected to a router (for instance mdo_ota_web_start()) is on the router's channel
+#define UNI_CHANNEL_MAX 13              // WiFi channels 1 through 13
+#define UNI_CHANNEL_PROBE_MSEC 50       // longest wait for the send callback of a probe on one channel
+#define UNI_CHANNEL_FAIL_REPROBE 3      // this many ESP_NOW_SEND_FAIL in a row to a receiver and probe for its channel again
+#define UNI_NVS_NAMESPACE "uniremote"   // Preferences (NVS) namespace for what we remember across power off
+static uint8_t g_rcvr_channel[ESP_NOW_MAX_TOTAL_PEER_NUM]; // WiFi channel of each peer; 0 if not known
+static uint8_t g_channel_now = 0;       // WiFi channel we are on now
+static uint32_t g_probe_seq = 0;        // number of channel probes sent
+static Preferences g_nvs;
+
+// receivers that answered a command, most recently used first; kept in NVS so setup() can register them
+//   at boot instead of the first command to each one paying for esp_now_add_peer()
+//   bounded well under ESP_NOW_MAX_TOTAL_PEER_NUM to leave room for the broadcast address and new receivers
+#define UNI_PEERS_PREWARM_NUM 12       // most receivers remembered and registered at boot
+#define UNI_PEERS_NVS_KEY "peers"      // NVS blob: UNI_PEERS_PREWARM_NUM MAC addresses, most recent first
+static_assert(UNI_PEERS_PREWARM_NUM <= ESP_NOW_MAX_TOTAL_PEER_NUM-2, "UNI_PEERS_PREWARM_NUM must leave room for broadcast and a new receiver");
+static uint8_t g_peers_mru[ESP_NOW_ETH_ALEN * UNI_PEERS_PREWARM_NUM];
+static uint16_t g_peers_mru_num = 0;  // valid entries in g_peers_mru[]
+static uint8_t g_peers_mru_dirty = 0; // non-zero: g_peers_mru[] changed since it was written to NVS
+#define UNI_PEERS_SAVE_MSEC 5000       // how often uni_peers_save() looks for a changed list to write
+static int16_t g_timer_id_peers_save = UNI_TIMER_ID_NONE; // job for uni_peers_save()
+
+// in-flight table - one entry for each ESP-NOW message waiting for its send callback
+//   The send callback gives only the destination MAC address, so there is at most one message in flight
+//      to each destination; that makes (MAC address, seq) match each callback to its send.
+//   loop() level fills in an entry before esp_now_send() and frees it after reporting the outcome;
+//      the send callback only fills in status and usec_cb and then sets done (last).
+#define UNI_IN_FLIGHT_NUM 4      // most messages waiting for their send callback at once
+#define UNI_PIPELINE_SENDS 1     // non-zero: when sending immediately, scan the next command without waiting for the send callback
+#define UNI_IN_FLIGHT_KIND_CMD    0 // a scanned command
+#define UNI_IN_FLIGHT_KIND_BEACON 1 // a time beacon
+#define UNI_IN_FLIGHT_KIND_PROBE  2 // a channel probe
+#define UNI_IN_FLIGHT_KIND_ANNOUNCE_REQ 3 // a request to announce
+typedef struct {
+  uint8_t  mac_addr[ESP_NOW_ETH_ALEN]; // destination MAC address
+  uint8_t  in_use;                     // non-zero == sent and not yet reported
+  uint8_t  done;                       // non-zero == send callback happened; set by send callback
+  uint8_t  kind;                       // UNI_IN_FLIGHT_KIND_CMD etc.
+  uint8_t  cmd_num;                    // g_last_scanned_cmd_count for this command (what the screen shows)
+  int16_t  peer_idx;                   // index into g_rcvr_mac_addr[]; -1 if none
+  uint32_t seq;                        // g_send_seq for this message; also in the timing trailer
+  uni_esp_now_status_t status;         // status from send callback
+  uni_cmd_timing_t timing;             // per-stage timing; usec_cb filled in by send callback
+} uni_in_flight_t;
+static uni_in_flight_t g_in_flight[UNI_IN_FLIGHT_NUM];
+static uint32_t g_send_seq = 0;                // number of messages sent
+static uint32_t g_in_flight_unmatched_num = 0; // send callbacks that matched no in-flight message
+static int16_t g_in_flight_idx_cmd = -1;       // entry for the command in g_cmd_in_proc_or_prev; -1 if none
+static uint32_t g_cmd_exec_lead_msec = 0; // non-zero: receivers execute the command this long after it is sent
+
+// time beacons so receivers can line up on an "execute at" time; see UniRemoteFrames.h
+static uint8_t g_broadcast_mac_addr[ESP_NOW_ETH_ALEN] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+static uint32_t g_beacon_seq = 0;       // beacon number
+static int16_t g_timer_id_beacon = UNI_TIMER_ID_NONE; // job for uni_time_beacon_send()
+
+// directory of receivers from their announcements (see UniRemoteFrames.h)
+//   the ESP-NOW rcvr callback only writes g_announce_ring[g_announce_ring_put] and then g_announce_ring_put;
+//   loop() level (uni_dir_update()) only writes g_announce_ring_get and g_dir[]
+#define UNI_DIR_NUM 16             // most receivers in the directory; the one heard longest ago is replaced
+#define UNI_ANNOUNCE_RING_NUM 8    // announcements waiting for loop(); holds NUM-1
+typedef struct {
+  uint8_t  mac_addr[ESP_NOW_ETH_ALEN]; // receiver MAC address
+  int8_t   rssi;                       // signal strength of the announcement
+  uni_frame_announce_t announce;       // what it said
+} uni_announce_rcvd_t;
+static uni_announce_rcvd_t g_announce_ring[UNI_ANNOUNCE_RING_NUM];
+static uint16_t g_announce_ring_put = 0;    // only written by the callback
+static uint16_t g_announce_ring_get = 0;    // only written by loop() level
+static uint32_t g_announce_dropped_num = 0; // only written by the callback
+typedef struct {
+  uint8_t  mac_addr[ESP_NOW_ETH_ALEN]; // receiver MAC address
+  uint8_t  in_use;                     // non-zero == this entry is for mac_addr
+  uint8_t  caps;                       // UNI_FRAME_CAP_* bits
+  int8_t   rssi;                       // signal strength of the latest announcement
+  char     alias[UNI_FRAME_ANNOUNCE_ALIAS_LEN+1]; // zero terminated; "" if none
+  char     name[UNI_FRAME_ANNOUNCE_NAME_LEN+1];   // zero terminated
+  uint32_t msec_heard;                 // millis() of the latest announcement
+} uni_dir_t;
+static uni_dir_t g_dir[UNI_DIR_NUM];
+static uint16_t g_announce_req_pending = 0; // non-zero: broadcast a request to announce when the broadcast address is free
+static uint32_t g_announce_req_seq = 0;     // number of requests to announce sent
+static uint16_t g_cmd_decode_addr_len = 3*ESP_NOW_ETH_ALEN; // chars of MAC address or alias, and the '|', in the last command decoded
 
 // UNI REMOTE definitions
-#define UNI_ESP_NOW_MSEC_PER_MSG_MIN 500 // minimum millisec between sending messages
+#define UNI_ESP_NOW_MSEC_PER_MSG_MIN 500 // minimum millisec between sending messages to the same receiver
 
 #define UNI_STATE_WAIT_CMD     0    // last cmd all done, wait for next cmd (any source OK)
 #define UNI_STATE_CMD_SEEN     1    // command in queue, waiting for GO or CLEAR
@@ -313,8 +603,48 @@ uint8_t g_uni_state_error = UNI_STATE_NO_ERROR;
 // some error codes that can be displayed just as if ESP_ERR_ESPNOW_ code
 #define UNI_ERR_TOO_SOON        501 // too soon to send another ESP-NOW message
 #define UNI_ERR_CMD_DECODE_FAIL 502 // could not decode MAC from CMD
-
-uint32_t g_uni_state_times[UNI_STATE_NUM];
+#define UNI_ERR_DEST_BUSY       503 // message to this receiver still waiting for send callback (or in-flight table full)
+#define UNI_ERR_NO_CHANNEL      504 // receiver did not answer a channel probe on any WiFi channel
+
+int64_t g_uni_state_times[UNI_STATE_NUM]; // esp_timer_get_time() when each state was last entered; see uni_perf_loop_end()
+
+// performance histograms (microseconds) and counters; see UniRemotePerf.h
+//   "perf" on Serial dumps them, "perf clear" starts the histograms over
+//   a long press on the middle button while waiting for a command shows the diagnostics screen
+static uni_perf_hist_t g_perf_loop_period;        // start of loop() to start of the next loop(), sleep included
+static uni_perf_hist_t g_perf_loop_busy;          // start of loop() to just before its sleep
+static uni_perf_hist_t g_perf_lvgl;               // lv_task_handler()
+static uni_perf_hist_t g_perf_scan;               // uni_get_command(): looking for an RFID card or QR code
+static uni_perf_hist_t g_perf_air;                // esp_now_send() to the send callback for a command
+static uni_perf_hist_t g_perf_state[UNI_STATE_NUM]; // time spent in each UNI_STATE_*
+static uint32_t g_perf_send_cb_num = 0;           // send callbacks; written only by uni_esp_now_cmd_send_callback()
+static uint8_t g_show_diag = 0;                   // non-zero to show the diagnostics instead of the command on the WAIT_CMD screen
+static uint32_t g_msec_diag_next = 0;             // millis() to make the diagnostics text again; set to now when g_show_diag turns on
+
+// sections of loop() that can take a long time; see UniRemoteStall.h and "stall" on Serial
+static uni_stall_section_t g_stall_scan = UNI_STALL_SECTION("scan", 250);  // uni_get_command(): RFID card or QR code; a card read is about 184 msec
+static uni_stall_section_t g_stall_send = UNI_STALL_SECTION("send", 100);  // uni_esp_now_cmd_send() after any channel probe
+static uni_stall_section_t g_stall_probe = UNI_STALL_SECTION("probe", UNI_CHANNEL_MAX*UNI_CHANNEL_PROBE_MSEC+100); // uni_channel_probe(): every channel, no answer
+static uni_stall_section_t g_stall_lvgl = UNI_STALL_SECTION("lvgl", 100);  // lv_task_handler()
+static uni_stall_section_t g_stall_journal = UNI_STALL_SECTION("journal", 100); // uni_journal_flush(): status events to flash
+#define UNI_DIAG_REFRESH_MSEC 1000                // how often the diagnostics screen text is made again
+
+// timeline; see UniRemoteTrace.h and "trace" on Serial
+#define UNI_TRACE_LOOP_NUM 512      // events kept from loop(); a power of 2, 12 bytes each
+#define UNI_TRACE_CB_NUM 64         // events kept from the send callback; a power of 2
+#define UNI_TRACE_MIN_USEC 1000     // scans and lv_task_handler() shorter than this are not kept
+#define UNI_TRACE_ID_STATE    0     // instant: g_uni_state changed; arg is the new state
+#define UNI_TRACE_ID_SCAN     1     // complete: uni_get_command()
+#define UNI_TRACE_ID_SEND     2     // complete: uni_esp_now_cmd_send(); arg is its esp_err_t
+#define UNI_TRACE_ID_SEND_CB  3     // instant: send callback; arg is the ESP-NOW status (0 is success)
+#define UNI_TRACE_ID_LVGL     4     // complete: lv_task_handler()
+#define UNI_TRACE_ID_BUTTON   5     // instant: button event; arg is ACTION_BUTTON_* plus 0x100 if a long press
+#if UNI_TRACE
+static uni_trace_rec_t g_trace_loop_recs[UNI_TRACE_LOOP_NUM];
+static uni_trace_ring_t g_trace_loop;   // written only at loop() level
+static uni_trace_rec_t g_trace_cb_recs[UNI_TRACE_CB_NUM];
+static uni_trace_ring_t g_trace_cb;     // written only by uni_esp_now_cmd_send_callback()
+#endif // UNI_TRACE
 
 uint8_t g_change_send_no_view = 1;  // 1==send command immediately, 0==view command before sending
 
@@ -338,6 +668,7 @@ action_button_t g_action_buttons[ACTION_BUTTON_NUM]; // for three buttons on top
 
 typedef struct {
   uint8_t  pressed;             // non-zero for new button press
+  uint8_t  long_press;          // non-zero if the button was held (LV_EVENT_LONG_PRESSED) instead of clicked
   uint8_t  btn_idx;             // index to the action button
   uint8_t  uni_state;           // g_uni_state at time of button press
   uint8_t  uni_state_error;     // g_uni_state_error at time of button press
@@ -353,17 +684,134 @@ styled_label_t g_styled_label_opr_comm;    // 5 lines storage for opr communicat
 
 char g_msg[1025]; // for generating text strings
 
+// view model - what each widget shows now
+//   loop() asks for the whole screen every time through; LVGL is only called when something changed,
+//   so unchanged widgets are not invalidated and redrawn
+#define UNI_VIEW_BTN_LABEL_MAX 24 // longest button label remembered; longer ones are always set
+#define UNI_VIEW_BTN_TEXT_MAX  48 // longest text under a button remembered; longer ones are always set
+typedef struct {
+  lv_style_t * style;                    // style shown now; 0 if none yet
+  char label[UNI_VIEW_BTN_LABEL_MAX];    // label within button shown now
+  char text[UNI_VIEW_BTN_TEXT_MAX];      // text under button shown now
+} uni_view_button_t;
+static uni_view_button_t g_view_buttons[ACTION_BUTTON_NUM];
+static lv_style_t * g_view_last_status_style = 0; // color of last status shown now
+static char g_view_last_status_text[1025];        // last status shown now
+static char g_view_opr_comm_text[1025];           // operator communication shown now
+static uint32_t g_view_set_num = 0;     // LVGL text and style changes made
+static uint32_t g_view_avoided_num = 0; // LVGL text and style changes avoided because nothing changed
+#define UNI_VIEW_REPORT_MSEC 60000 // how often to print the view model counts on Serial; zero to never print
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_view_text() - set label text if it changed
+//       returns: non-zero if the label was changed
+//
+//    p_label      - LVGL label
+//    p_shown      - what p_label shows now; updated
+//    p_shown_size - sizeof(p_shown); text that does not fit is always set
+//    p_text       - text wanted
+//
+int16_t uni_view_text(lv_obj_t * p_label, char * p_shown, uint16_t p_shown_size, const char * p_text) {
+  if ((strlen(p_text) < p_shown_size) && (0 == strcmp(p_shown, p_text))) {
+    g_view_avoided_num += 1;
+    return(0);
+  }
+  lv_label_set_text(p_label, p_text);
+  strncpy(p_shown, p_text, p_shown_size-1);
+  p_shown[p_shown_size-1] = '\0';
+  g_view_set_num += 1;
+  return(1);
+} // end uni_view_text()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_view_style() - change object color style if it changed
+//       returns: non-zero if the style was changed
+//
+//    p_obj       - LVGL object
+//    p_shown_ptr - style p_obj has now (0 if none); updated
+//    p_style     - style wanted
+//
+// the old style is removed so styles do not pile up on the object
+//
+int16_t uni_view_style(lv_obj_t * p_obj, lv_style_t ** p_shown_ptr, lv_style_t * p_style) {
+  if (*p_shown_ptr == p_style) {
+    g_view_avoided_num += 1;
+    return(0);
+  }
+  if ((lv_style_t *) 0 != *p_shown_ptr) lv_obj_remove_style(p_obj, *p_shown_ptr, 0);
+  lv_obj_add_style(p_obj, p_style, 0);
+  *p_shown_ptr = p_style;
+  g_view_set_num += 1;
+  return(1);
+} // end uni_view_style()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_view_opr_comm_text() - set the operator communication text in the middle of the screen
+//       returns: non-zero if it changed
+//
+int16_t uni_view_opr_comm_text(const char * p_text) {
+  return(uni_view_text(g_styled_label_opr_comm.label_text, g_view_opr_comm_text, sizeof(g_view_opr_comm_text), p_text));
+} // end uni_view_opr_comm_text()
+
+// what the operator communication text was made from; the text is made again only when one of these changes
+typedef struct {
+  uint32_t status_num;             // g_status_num: status events and link quality
+  uint32_t cmd_num;                // g_cmd_in_proc_or_prev_num: the command shown
+  uint8_t  state;                  // g_uni_state
+  uint8_t  cmd_count;              // g_last_scanned_cmd_count
+  uint8_t  variant;                // what else the screen depends on (view before send, link table)
+} uni_view_opr_key_t;
+static uni_view_opr_key_t g_view_opr_key;
+static uint8_t g_view_opr_key_valid = 0; // zero: text on screen was not made from g_view_opr_key
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_view_opr_comm_stale() - does the operator communication text need to be made again?
+//       returns: non-zero if anything it is made from changed since it was last made; then remembers them
+//
+//    p_variant - anything else the text of this state depends on
+//
+int16_t uni_view_opr_comm_stale(uint8_t p_variant) {
+  uni_view_opr_key_t key;
+  memset(&key, 0, sizeof(key)); // no stray padding bytes for memcmp()
+  key.status_num = g_status_num;
+  key.cmd_num = g_cmd_in_proc_or_prev_num;
+  key.state = g_uni_state;
+  key.cmd_count = g_last_scanned_cmd_count;
+  key.variant = p_variant;
+  if ((0 != g_view_opr_key_valid) && (0 == memcmp(&key, &g_view_opr_key, sizeof(key)))) {
+    g_view_avoided_num += 1;
+    return(0);
+  }
+  memcpy(&g_view_opr_key, &key, sizeof(key)); // padding too
+  g_view_opr_key_valid = 1;
+  return(1);
+} // end uni_view_opr_comm_stale()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_view_report() - print the view model counts on Serial
+//       returns: nothing
+//
+// a periodic job every UNI_VIEW_REPORT_MSEC (see setup())
+//
+void uni_view_report(uint32_t p_msec_now) {
+  DBG_SERIALPRINT("VIEW LVGL changes made ");  DBG_SERIALPRINT(g_view_set_num);
+  DBG_SERIALPRINT(" avoided ");                DBG_SERIALPRINTLN(g_view_avoided_num);
+} // end uni_view_report()
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 // uni_lv_button_text_style - set button texts and style
 //    p_btn_idx - within g_action_buttons[]
 //    p_label   - label within button
 //    p_text    - text under button
 //    p_style   - button style to use
+//
+// only what changed is passed on to LVGL (see uni_view_text())
 //    
 void uni_lv_button_text_style(uint8_t p_btn_idx, const char * p_label, const char * p_text, lv_style_t * p_style) {
-  lv_obj_add_style(g_action_buttons[p_btn_idx].button, p_style, 0);
-  lv_label_set_text(g_action_buttons[p_btn_idx].button_label, p_label);
-  lv_label_set_text(g_action_buttons[p_btn_idx].button_text_label, p_text);
+  uni_view_button_t * view_ptr = &g_view_buttons[p_btn_idx];
+  uni_view_style(g_action_buttons[p_btn_idx].button, &view_ptr->style, p_style);
+  uni_view_text(g_action_buttons[p_btn_idx].button_label, view_ptr->label, sizeof(view_ptr->label), p_label);
+  uni_view_text(g_action_buttons[p_btn_idx].button_text_label, view_ptr->text, sizeof(view_ptr->text), p_text);
 } // end uni_lv_button_text_style()
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -372,33 +820,211 @@ void uni_lv_button_text_style(uint8_t p_btn_idx, const char * p_label, const cha
 //
 // uses g_style_green if no FAIL found in p_text
 // else g_style_yellow
+// only what changed is passed on to LVGL (see uni_view_text())
 //    
-void uni_lv_last_status_text_style(char * p_text) {
+void uni_lv_last_status_text_style(const char * p_text) {
+    g_status_waiting_shown = 0;
     if (NULL == strstr(p_text,"FAIL"))
-      lv_obj_add_style(g_styled_label_last_status.label_obj, &g_style_green, 0);
+      uni_view_style(g_styled_label_last_status.label_obj, &g_view_last_status_style, &g_style_green);
     else
-      lv_obj_add_style(g_styled_label_last_status.label_obj, &g_style_yellow, 0);
-    lv_label_set_text(g_styled_label_last_status.label_text, p_text);
+      uni_view_style(g_styled_label_last_status.label_obj, &g_view_last_status_style, &g_style_yellow);
+    uni_view_text(g_styled_label_last_status.label_text, g_view_last_status_text, sizeof(g_view_last_status_text), p_text);
 } // end uni_lv_last_status_text_style()
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_status_note() - record a status event; its text is made later, only if a label shows it
+//       returns: nothing
+//
+// p_code - UNI_STATUS_*; p_cmd_num, p_arg and p_arg2 as that code says
+//
+void uni_status_note(uint8_t p_code, uint8_t p_cmd_num, int32_t p_arg, uint8_t p_arg2) {
+  uni_status_ev_t * ev_ptr = &g_status_ring[g_status_ring_put];
+  ev_ptr->msec = millis();
+  ev_ptr->arg = p_arg;
+  ev_ptr->cmd_num = p_cmd_num;
+  ev_ptr->code = p_code;
+  ev_ptr->arg2 = p_arg2;
+  g_status_ring_put = (g_status_ring_put + 1) % UNI_STATUS_RING_NUM;
+  g_status_num += 1;
+  if (NULL != g_status_defs[p_code].result_fmt) g_status_latest[UNI_STATUS_RESULT] = *ev_ptr;
+  if (NULL != g_status_defs[p_code].opr_fmt)    g_status_latest[UNI_STATUS_OPR] = *ev_ptr;
+  if (0 != (UNI_STATUS_F_CMD_TEXT & g_status_defs[p_code].flags)) {
+    // scanned_cmd[] is bigger than g_status_cmd_text[] so the copy stays inside it; the terminator is explicit
+    memcpy(g_status_cmd_text, g_cmd_queue[UNI_CMD_QNUM_NOW].scanned_cmd, sizeof(g_status_cmd_text)-1);
+    g_status_cmd_text[sizeof(g_status_cmd_text)-1] = '\0';
+    g_status_cmd_text_num = p_cmd_num;
+  }
+#if UNI_JOURNAL
+  uni_journal_add(UNI_JOURNAL_ID_FIRST + p_code, p_arg, p_cmd_num); // RAM only; uni_status_journal_flush() writes it
+#endif // UNI_JOURNAL
+} // end uni_status_note()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_status_clear_opr() - no operator text until the next status event that has one
+//       returns: nothing
+//
+void uni_status_clear_opr() {
+  g_status_latest[UNI_STATUS_OPR].code = UNI_STATUS_NONE;
+} // end uni_status_clear_opr()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_status_printf() - snprintf() onto the end of p_buf[p_len]; never past p_size
+//       returns: new length of p_buf
+//
+uint16_t uni_status_printf(char * p_buf, uint16_t p_size, uint16_t p_len, const char * p_fmt, ...) {
+  va_list args;
+  if ((p_len + 1) >= p_size) return(p_len);
+  va_start(args, p_fmt);
+  int added = vsnprintf(&p_buf[p_len], p_size - p_len, p_fmt, args);
+  va_end(args);
+  if (added < 0) added = 0;
+  p_len += added;
+  return((p_len < p_size) ? p_len : (p_size - 1));
+} // end uni_status_printf()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_status_format() - the text for one status event
+//       returns: length of the text in p_buf
+//
+// p_which - UNI_STATUS_RESULT or UNI_STATUS_OPR; empty if the event has no text of that kind
+// the command itself is only in the text for the latest event that has it (see g_status_cmd_text)
+//
+uint16_t uni_status_format(char * p_buf, uint16_t p_size, const uni_status_ev_t * p_ev, uint8_t p_which) {
+  const uni_status_def_t * def_ptr = &g_status_defs[p_ev->code];
+  const char * fmt = (UNI_STATUS_OPR == p_which) ? def_ptr->opr_fmt : def_ptr->result_fmt;
+  uint16_t len = 0;
+
+  if (0 == p_size) return(0);
+  p_buf[0] = '\0';
+  if (NULL == fmt) return(0);
+  len = uni_status_printf(p_buf, p_size, len, fmt, p_ev->cmd_num);
+  if (UNI_STATUS_OPR == p_which) return(len);
+  if ((0 != (UNI_STATUS_F_CMD_TEXT & def_ptr->flags)) && (p_ev->cmd_num == g_status_cmd_text_num))
+    len = uni_status_printf(p_buf, p_size, len, " %s", g_status_cmd_text);
+  if (0 != (UNI_STATUS_F_ESP_ERR & def_ptr->flags))
+    len = uni_status_printf(p_buf, p_size, len, "\n  %s", uni_esp_now_decode_error((uint16_t) p_ev->arg));
+  if ((0 != (UNI_STATUS_F_LINK & def_ptr->flags)) && (UNI_STATUS_NO_LINK != p_ev->arg2))
+    len = uni_status_printf(p_buf, p_size, len, "\n  link OK %d%% rate %s", (int) p_ev->arg, g_link_rates[p_ev->arg2].name);
+  return(len);
+} // end uni_status_format()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_status_text() - text of the latest status event of one kind
+//       returns: g_status_text; good until the next uni_status_*() call
+//
+// p_which - UNI_STATUS_RESULT or UNI_STATUS_OPR
+//
+const char * uni_status_text(uint8_t p_which) {
+  uni_status_format(g_status_text, sizeof(g_status_text), &g_status_latest[p_which], p_which);
+  return(g_status_text);
+} // end uni_status_text()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_status_show_result() - latest result on the last status label
+//       returns: nothing
+//
+void uni_status_show_result() {
+  uni_lv_last_status_text_style(uni_status_text(UNI_STATUS_RESULT)); // yellow if "FAIL"
+} // end uni_status_show_result()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_status_show_waiting() - "No scanned command" and the latest result on the last status label
+//       returns: nothing
+//
+// called on every loop() while waiting for a card; the text is only made again after a status event
+//    or after something else was put on the label
+//
+void uni_status_show_waiting() {
+  if ((g_status_num + 1) == g_status_waiting_shown) return; // already showing it
+  uint16_t len = uni_status_printf(g_status_text, sizeof(g_status_text), 0, "No scanned command found, waiting...\n  ");
+  uni_status_format(&g_status_text[len], sizeof(g_status_text) - len, &g_status_latest[UNI_STATUS_RESULT], UNI_STATUS_RESULT);
+  uni_lv_last_status_text_style(g_status_text);
+  g_status_waiting_shown = g_status_num + 1;
+} // end uni_status_show_waiting()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_status_cmd() - the "status" Serial command: the status events in the ring, oldest first
+//       returns: nothing
+//
+void uni_status_cmd(const char * p_args) {
+  uint16_t num = (g_status_num < UNI_STATUS_RING_NUM) ? (uint16_t) g_status_num : UNI_STATUS_RING_NUM;
+  Serial.printf("STATUS %lu events, last %d\n", (unsigned long) g_status_num, num);
+  for (uint16_t idx = 0; idx < num; idx++) {
+    uni_status_ev_t * ev_ptr = &g_status_ring[(g_status_ring_put + UNI_STATUS_RING_NUM - num + idx) % UNI_STATUS_RING_NUM];
+    uint8_t which = (NULL != g_status_defs[ev_ptr->code].result_fmt) ? UNI_STATUS_RESULT : UNI_STATUS_OPR;
+    uni_status_format(g_status_text, sizeof(g_status_text), ev_ptr, which);
+    for (char * ptr = g_status_text; '\0' != *ptr; ptr++) if ('\n' == *ptr) *ptr = ' '; // one line each
+    Serial.printf("STATUS %10lu %-11s CMD #%3d arg %ld %d |%s|\n", (unsigned long) ev_ptr->msec, g_status_defs[ev_ptr->code].name,
+      ev_ptr->cmd_num, (long) ev_ptr->arg, ev_ptr->arg2, g_status_text);
+  }
+} // end uni_status_cmd()
+
+#if UNI_JOURNAL
+#define UNI_STATUS_JOURNAL_MSEC 1000 // how often to see if status events should go to flash
+static int16_t g_timer_id_journal = UNI_TIMER_ID_NONE; // job for uni_status_journal_flush()
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_status_journal_flush() - status events from RAM to flash, but not while a command is going out
+//       returns: nothing
+//
+// a periodic job every UNI_STATUS_JOURNAL_MSEC (see uni_status_journal_setup())
+// a flash write can take milliseconds; a command being sent or waiting for its callback should not
+//    wait for it. While one is, full pages stay in RAM and this tries again CYDsampleDelayMsec later.
+//
+void uni_status_journal_flush(uint32_t p_msec_now) {
+  if ((UNI_STATE_SENDING_CMD == g_uni_state) || (UNI_STATE_WAIT_CB == g_uni_state) || (0 != uni_in_flight_num())) {
+    uni_timer_start(g_timer_id_journal, CYDsampleDelayMsec);
+    return;
+  }
+  UNI_STALL_SCOPE(g_stall_journal);
+  uni_journal_flush(p_msec_now, 0);
+} // end uni_status_journal_flush()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_status_journal_setup() - open the journal, name the status events, add the flush job and "journal" Serial command
+//       returns: nothing
+//
+void uni_status_journal_setup() {
+  if (0 != uni_journal_setup()) {
+    DBG_SERIALPRINTLN("ERROR: LittleFS journal not available; is there a SPIFFS partition?");
+  }
+  for (uint8_t code = 0; code < UNI_STATUS_CODE_NUM; code++) uni_journal_name(UNI_JOURNAL_ID_FIRST + code, g_status_defs[code].name);
+  g_timer_id_journal = uni_timer_add(uni_status_journal_flush, UNI_STATUS_JOURNAL_MSEC, UNI_STATUS_JOURNAL_MSEC, 1);
+  uni_serial_cmd_add("journal", uni_journal_cmd, "journal [clear] - print the status events kept in flash, every boot; clear empties it");
+} // end uni_status_journal_setup()
+#endif // UNI_JOURNAL
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 // uni_alert_4_wait_new_cmd
 //
 void uni_alert_4_wait_new_cmd() {
+#if UNI_PERF
+  if (0 != g_show_diag) {
+    uni_lv_button_text_style(ACTION_BUTTON_LEFT, "CLEAR", "Start diag\nover", &g_style_blue);
+    uni_lv_button_text_style(ACTION_BUTTON_MID, "BACK", "back to\ncommands", &g_style_grey);
+    uni_lv_button_text_style(ACTION_BUTTON_RIGHT, "LED OFF", "Lights off", &g_style_red);
+    if (uni_msec_reached(millis(), g_msec_diag_next)) { // numbers change all the time; no need to redraw them every loop
+      g_msec_diag_next = millis() + UNI_DIAG_REFRESH_MSEC;
+      uni_diag_text(g_msg);
+      uni_view_opr_comm_text(g_msg);
+      g_view_opr_key_valid = 0; // commands again when BACK is pressed
+    }
+    return;
+  }
+#endif // UNI_PERF
   uni_lv_button_text_style(ACTION_BUTTON_LEFT, "LED ON", "Lights on", &g_style_blue);
   if (0 != g_change_send_no_view)
     uni_lv_button_text_style(ACTION_BUTTON_MID, "SEND CMD", "press to\nchange state", &g_style_grey);
   else
     uni_lv_button_text_style(ACTION_BUTTON_MID, "VIEW B4\n  SEND", "press to\nchange state", &g_style_grey);
   uni_lv_button_text_style(ACTION_BUTTON_RIGHT, "LED OFF", "Lights off", &g_style_red);
-  strcpy(g_msg, "Scan Command");
-  char tmp_msg[36];
-  sprintf(tmp_msg, "Previous CMD #%d: ", g_last_scanned_cmd_count);
-  str_display_cmd(g_msg, g_cmd_in_proc_or_prev, tmp_msg);
-  if (0 != strcmp(g_msg_prev_opr_comm_status, g_msg)) {
-    lv_label_set_text(g_styled_label_opr_comm.label_text, g_msg);
-    strcpy(g_msg_prev_opr_comm_status, g_msg);
-    Serial.printf("DBG 05 proc_or_prev=|%s| msg=|%s|\n", g_cmd_in_proc_or_prev, g_msg);
+  if (0 != uni_view_opr_comm_stale(0)) {
+    strcpy(g_msg, "Scan Command");
+    char tmp_msg[36];
+    sprintf(tmp_msg, "Previous CMD #%d: ", g_last_scanned_cmd_count);
+    str_display_cmd(g_msg, sizeof(g_msg), g_cmd_in_proc_or_prev, tmp_msg);
+    if (0 != uni_view_opr_comm_text(g_msg)) {
+      Serial.printf("DBG 05 proc_or_prev=|%s| msg=|%s|\n", g_cmd_in_proc_or_prev, g_msg);
+    }
   }
   if (UNI_STATE_NO_ERROR == g_uni_state_error) {
     // NO ERROR
@@ -425,11 +1051,13 @@ void uni_alert_4_wait_send_or_clear_cmd() {
   uni_lv_button_text_style(ACTION_BUTTON_LEFT, "SEND", "Send Command", &g_style_blue);
   uni_lv_button_text_style(ACTION_BUTTON_MID, "", "", &g_style_ghost);
   uni_lv_button_text_style(ACTION_BUTTON_RIGHT, "CLEAR", "Clear Command", &g_style_red);
-  strcpy(g_msg, "Send or Clear Command");
-  str_display_cmd(g_msg, g_cmd_in_proc_or_prev, "This CMD: ");
-  lv_label_set_text(g_styled_label_opr_comm.label_text, g_msg);
-  strcpy(g_msg_prev_opr_comm_status, g_msg);
-  Serial.printf("DBG 04 proc_or_prev=|%s| msg=|%s|\n", g_cmd_in_proc_or_prev, g_msg);
+  if (0 != uni_view_opr_comm_stale(0)) {
+    strcpy(g_msg, "Send or Clear Command");
+    str_display_cmd(g_msg, sizeof(g_msg), g_cmd_in_proc_or_prev, "This CMD: ");
+    if (0 != uni_view_opr_comm_text(g_msg)) {
+      Serial.printf("DBG 04 proc_or_prev=|%s| msg=|%s|\n", g_cmd_in_proc_or_prev, g_msg);
+    }
+  }
   if (UNI_STATE_NO_ERROR == g_uni_state_error) {
     // NO ERROR
   } else {
@@ -465,11 +1093,9 @@ void uni_alert_4_sending_cmd() {
   uni_lv_button_text_style(ACTION_BUTTON_LEFT, "", "", &g_style_ghost);
   uni_lv_button_text_style(ACTION_BUTTON_MID, "", "", &g_style_ghost);
   uni_lv_button_text_style(ACTION_BUTTON_RIGHT, "ABORT", "Abort send and\nClear Command", &g_style_red);
-  sprintf(g_msg, "\nSending CMD #%d - please wait ", g_last_scanned_cmd_count);
-  lv_label_set_text(g_styled_label_opr_comm.label_text, g_msg_last_opr_comm_status);
-  str_display_cmd(g_msg, g_cmd_in_proc_or_prev, "This CMD: ");
-  strcpy(g_msg_prev_opr_comm_status, g_msg);
-  Serial.printf("DBG 03 proc_or_prev=|%s| msg=|%s|\n", g_cmd_in_proc_or_prev, g_msg);
+  if ((0 != uni_view_opr_comm_stale(0)) && (0 != uni_view_opr_comm_text(uni_status_text(UNI_STATUS_OPR)))) {
+    Serial.printf("DBG 03 proc_or_prev=|%s| msg=|%s|\n", g_cmd_in_proc_or_prev, g_view_opr_comm_text);
+  }
   if (UNI_STATE_NO_ERROR == g_uni_state_error) {
     // NO ERROR
   } else {
@@ -484,12 +1110,14 @@ void uni_alert_4_wait_callback() {
   uni_lv_button_text_style(ACTION_BUTTON_LEFT, "", "", &g_style_ghost);
   uni_lv_button_text_style(ACTION_BUTTON_MID, "", "", &g_style_ghost);
   uni_lv_button_text_style(ACTION_BUTTON_RIGHT, "ABORT", "Abort send and\nClear Command", &g_style_red);
-  strcpy(g_msg_last_opr_comm_status, "");
-  sprintf(g_msg, "\nWaiting CMD #%d callback - please wait ", g_last_scanned_cmd_count);
-  str_display_cmd(g_msg, g_cmd_in_proc_or_prev, "This CMD: ");
-  lv_label_set_text(g_styled_label_opr_comm.label_text, g_msg);
-  strcpy(g_msg_prev_opr_comm_status, g_msg);
-  Serial.printf("DBG 02 proc_or_prev=|%s| msg=|%s|\n", g_cmd_in_proc_or_prev, g_msg_last_opr_comm_status);
+  if (0 != uni_view_opr_comm_stale(0)) {
+    uni_status_clear_opr();
+    sprintf(g_msg, "\nWaiting CMD #%d callback - please wait ", g_last_scanned_cmd_count);
+    str_display_cmd(g_msg, sizeof(g_msg), g_cmd_in_proc_or_prev, "This CMD: ");
+    if (0 != uni_view_opr_comm_text(g_msg)) {
+      Serial.printf("DBG 02 proc_or_prev=|%s| msg=|%s|\n", g_cmd_in_proc_or_prev, g_msg);
+    }
+  }
   if (UNI_STATE_NO_ERROR == g_uni_state_error) {
     // NO ERROR
   } else {
@@ -505,13 +1133,22 @@ void uni_alert_4_rcvd_callback() {
   // TODO sprintf(g_msg, "ESP-NOW ERROR: sending msg %d\n  %s", g_last_scanned_cmd_count, g_cmd_queue[UNI_CMD_QNUM_NOW].scanned_cmd, uni_esp_now_decode_error(g_last_send_callback_status));
   // lv_label_set_text(g_styled_label_last_status.label_text, g_msg);
   uni_lv_button_text_style(ACTION_BUTTON_LEFT, "SEND", "Send again", &g_style_blue);
-  uni_lv_button_text_style(ACTION_BUTTON_MID, "", "", &g_style_ghost);
+  if (0 != g_show_link_table)
+    uni_lv_button_text_style(ACTION_BUTTON_MID, "STATUS", "show status", &g_style_grey);
+  else
+    uni_lv_button_text_style(ACTION_BUTTON_MID, "LINKS", "show link\nquality", &g_style_grey);
   uni_lv_button_text_style(ACTION_BUTTON_RIGHT, "ABORT", "Abort send and\nClear Command", &g_style_red);
-  strcpy(g_msg, "CMD Send failed; SEND again or ABORT...");
-  str_display_cmd(g_msg, g_cmd_in_proc_or_prev, "This CMD: ");
-  lv_label_set_text(g_styled_label_opr_comm.label_text, g_msg);
-  strcpy(g_msg_prev_opr_comm_status, g_msg);
-  Serial.print("DBG 01 "); Serial.println(g_msg);
+  if (0 != uni_view_opr_comm_stale((0 != g_show_link_table) ? 1 : 0)) {
+    if (0 != g_show_link_table) {
+      uni_link_table_text(g_msg);
+    } else {
+      strcpy(g_msg, "CMD Send failed; SEND again or ABORT...");
+      str_display_cmd(g_msg, sizeof(g_msg), g_cmd_in_proc_or_prev, "This CMD: ");
+    }
+    if (0 != uni_view_opr_comm_text(g_msg)) {
+      Serial.print("DBG 01 "); Serial.println(g_msg);
+    }
+  }
   if (UNI_STATE_NO_ERROR == g_uni_state_error) {
     // NO ERROR
   } else {
@@ -545,49 +1182,162 @@ void uni_display_state() {
   }
 } // end uni_display_state()
 
-/////////////////////////////////////////////////////////////////////////////////////////////////////////
-// str_trim - trim tabs & spaces from front and back
-// MODIFIES p_str
-//
-char* str_trim(char* p_str) {
-  char* my_str = p_str;
-  while ((' ' == my_str[0]) || ('\t' == my_str[0])) {
-    my_str += 1;
-  }
-  size_t my_len = strlen(my_str);
-  while ((' ' == my_str[my_len - 1]) || ('\t' == my_str[my_len - 1])) {
-    my_len -= 1;
-    my_str[my_len] = 0;
-  }
-  return(my_str);
-} // end str_trim()
-
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 // str_display_cmd - builds formatted string from command into p_msg_str; preserving existing contents
-// returns: pointer to formatted string
 //     p_msg_str      - writeable string to append our formatted command display text
+//     p_msg_size     - size of p_msg_str; the display is cut short to fit
 //     p_cmd          - ESP-NOW text message we will format into p_msg_str
 //     p_insert_words - typically "Processing CMD " or "Last CMD "; ends with a space
 //
-void str_display_cmd(char* p_msg_str, char* p_cmd, const char* p_insert_words) {
-  char delimiters[] = ";";
-  char* token;
-  const char* my_insert_word = p_insert_words;
-  static char tmp_msg[ESP_NOW_MAX_DATA_LEN + 1];
-
-  if('\0' == p_cmd[0]) return;
-  strncpy(tmp_msg, p_cmd, ESP_NOW_MAX_DATA_LEN);
-
-  token = strtok(tmp_msg, delimiters);
-  if (token == NULL) { sprintf(p_msg_str, "%s\n\n%sERROR no command found", p_msg_str, p_insert_words);  return; }
-  while (token != NULL) {
-    sprintf(p_msg_str, "%s\n%s%s", p_msg_str, my_insert_word, str_trim(token));
-    my_insert_word = "";
-    token = strtok(NULL, delimiters);
-  } // end while
-  return;
+// one line per ';' separated command (see uni_cmd_display() in UniRemoteCmdParse.h)
+//
+void str_display_cmd(char* p_msg_str, uint16_t p_msg_size, const char* p_cmd, const char* p_insert_words) {
+  uni_cmd_display(p_msg_str, p_msg_size, p_cmd, p_insert_words);
 }   // end str_display_cmd()
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_touch_cal_q16() - float coefficient to Q16 fixed point, rounded
+//       returns: the Q16 coefficient
+//
+static int32_t uni_touch_cal_q16(float p_coeff) {
+  return((int32_t) lroundf(p_coeff * (float) (1L << UNI_TOUCH_CAL_Q)));
+} // end uni_touch_cal_q16()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_touch_cal_load() - load the touchscreen calibration from NVS into g_touch_cal
+//       returns: nothing
+//
+// uses g_touch_cal_default if there is no calibration in NVS or it is out of range (or NaN)
+// call after g_nvs.begin()
+//
+void uni_touch_cal_load() {
+  float coeffs[UNI_TOUCH_CAL_NUM];
+  const float * use_ptr = g_touch_cal_default;
+  char line[120];
+
+  g_touch_cal.from_nvs = 0;
+  if (sizeof(coeffs) == g_nvs.getBytes(UNI_TOUCH_CAL_NVS_KEY, coeffs, sizeof(coeffs))) {
+    g_touch_cal.from_nvs = 1;
+    for (int idx = 0; idx < UNI_TOUCH_CAL_NUM; idx++) {
+      float limit = (2 == (idx % 3)) ? UNI_TOUCH_CAL_MAX_OFFSET : UNI_TOUCH_CAL_MAX_SLOPE;
+      if (!(fabsf(coeffs[idx]) <= limit)) g_touch_cal.from_nvs = 0; // written this way so NaN fails too
+    }
+    if (0 != g_touch_cal.from_nvs) {
+      use_ptr = coeffs;
+    } else {
+      DBG_SERIALPRINTLN("ERROR: touchscreen calibration in NVS out of range; using defaults");
+    }
+  }
+  g_touch_cal.alpha_x = uni_touch_cal_q16(use_ptr[0]);
+  g_touch_cal.beta_x  = uni_touch_cal_q16(use_ptr[1]);
+  g_touch_cal.delta_x = uni_touch_cal_q16(use_ptr[2]);
+  g_touch_cal.alpha_y = uni_touch_cal_q16(use_ptr[3]);
+  g_touch_cal.beta_y  = uni_touch_cal_q16(use_ptr[4]);
+  g_touch_cal.delta_y = uni_touch_cal_q16(use_ptr[5]);
+  sprintf(line, "TOUCH calibration %s: %.3f %.3f %.3f %.3f %.3f %.3f", g_touch_cal.from_nvs ? "from NVS" : "defaults",
+          use_ptr[0], use_ptr[1], use_ptr[2], use_ptr[3], use_ptr[4], use_ptr[5]);
+  DBG_SERIALPRINTLN(line);
+} // end uni_touch_cal_load()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_touch_cal_apply() - raw touchscreen point to screen point with g_touch_cal
+//       returns: nothing; screen point in *p_x and *p_y, clamped to the screen
+//
+// Q16 fixed point, rounded: raw p.x and p.y are 12 bits so the sums stay inside int32_t
+//
+void uni_touch_cal_apply(int32_t p_raw_x, int32_t p_raw_y, int * p_x, int * p_y) {
+  int cal_x = (g_touch_cal.alpha_y * p_raw_x + g_touch_cal.beta_y * p_raw_y + g_touch_cal.delta_y + (1L << (UNI_TOUCH_CAL_Q-1))) >> UNI_TOUCH_CAL_Q;
+  int cal_y = (g_touch_cal.alpha_x * p_raw_x + g_touch_cal.beta_x * p_raw_y + g_touch_cal.delta_x + (1L << (UNI_TOUCH_CAL_Q-1))) >> UNI_TOUCH_CAL_Q;
+  // clamp x between 0 and SCREEN_WIDTH - 1, y between 0 and SCREEN_HEIGHT - 1
+  *p_x = min(SCREEN_WIDTH - 1, max(0, cal_x));
+  *p_y = min(SCREEN_HEIGHT - 1, max(0, cal_y));
+} // end uni_touch_cal_apply()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_touch_median() - median of p_num values; p_num is odd
+//       returns: the median; p_vals is sorted
+//
+uint16_t uni_touch_median(uint16_t * p_vals, int p_num) {
+  for (int idx = 1; idx < p_num; idx++) { // insertion sort; p_num is tiny
+    uint16_t val = p_vals[idx];
+    int jdx = idx - 1;
+    for ( ; (jdx >= 0) && (p_vals[jdx] > val); jdx--) p_vals[jdx+1] = p_vals[jdx];
+    p_vals[jdx+1] = val;
+  }
+  return(p_vals[p_num/2]);
+} // end uni_touch_median()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_touch_sample() - read and filter the touchscreen; a periodic job every UNI_TOUCH_SAMPLE_MSEC
+//       returns: nothing; g_touch has the filtered state and point for cyd_input_read()
+//
+// T_IRQ     - the XPT2046 pulls T_IRQ low while touched; if it is high we skip the bit-bang read altogether
+// median    - UNI_TOUCH_MEDIAN_N readings; the median of each of x, y and z throws out a single bad reading
+// pressure  - becomes pressed after UNI_TOUCH_PRESS_SAMPLES samples in a row above UNI_TOUCH_Z_PRESS,
+//             released at the first sample below UNI_TOUCH_Z_RELEASE; light or bouncing touches do not press
+// IIR       - while pressed the point is smoothed; a new press starts from its own first point
+//
+void uni_touch_sample(uint32_t p_msec_now) {
+  uint16_t xs[UNI_TOUCH_MEDIAN_N], ys[UNI_TOUCH_MEDIAN_N], zs[UNI_TOUCH_MEDIAN_N];
+  uint16_t z_med = 0;
+  int cal_x, cal_y;
+
+  g_touch.sample_num += 1;
+#if UNI_TOUCH_USE_IRQ
+  if (HIGH != digitalRead(XPT2046_IRQ))
+#endif // UNI_TOUCH_USE_IRQ
+  {
+    uint32_t usec_start = micros();
+    for (int idx = 0; idx < UNI_TOUCH_MEDIAN_N; idx++) {
+      TouchPoint p = ts.getTouch();
+      xs[idx] = p.xRaw; ys[idx] = p.yRaw; zs[idx] = p.zRaw;
+    }
+    g_touch.usec_bitbang += micros() - usec_start;
+    g_touch.bitbang_num += UNI_TOUCH_MEDIAN_N;
+    z_med = uni_touch_median(zs, UNI_TOUCH_MEDIAN_N);
+  }
+  g_touch.z = z = z_med;
+
+  if (z_med < UNI_TOUCH_Z_RELEASE) {
+    g_touch.pressed = 0;
+    g_touch.press_count = 0;
+    return;
+  }
+  if ((0 == g_touch.pressed) && (z_med < UNI_TOUCH_Z_PRESS)) {
+    g_touch.press_count = 0; // in between: a released touch stays released
+    return;
+  }
+
+  uni_touch_cal_apply(uni_touch_median(xs, UNI_TOUCH_MEDIAN_N), uni_touch_median(ys, UNI_TOUCH_MEDIAN_N), &cal_x, &cal_y);
+  if (0 == g_touch.pressed) {
+    g_touch.press_count += 1;
+    if (g_touch.press_count < UNI_TOUCH_PRESS_SAMPLES) return;
+    g_touch.pressed = 1;
+    g_touch.press_num += 1;
+    g_touch.x_iir = cal_x << UNI_TOUCH_IIR_FRAC;
+    g_touch.y_iir = cal_y << UNI_TOUCH_IIR_FRAC;
+  } else {
+    g_touch.x_iir += ((cal_x << UNI_TOUCH_IIR_FRAC) - g_touch.x_iir) >> UNI_TOUCH_IIR_SHIFT;
+    g_touch.y_iir += ((cal_y << UNI_TOUCH_IIR_FRAC) - g_touch.y_iir) >> UNI_TOUCH_IIR_SHIFT;
+  }
+  g_touch.x = x = (g_touch.x_iir + (1 << (UNI_TOUCH_IIR_FRAC-1))) >> UNI_TOUCH_IIR_FRAC;
+  g_touch.y = y = (g_touch.y_iir + (1 << (UNI_TOUCH_IIR_FRAC-1))) >> UNI_TOUCH_IIR_FRAC;
+} // end uni_touch_sample()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_touch_report() - print touch sampling counts on Serial and start over
+//       returns: nothing
+//
+// a periodic job every UNI_TOUCH_REPORT_MSEC; bit-bang reads should only add up while someone is touching
+//
+void uni_touch_report(uint32_t p_msec_now) {
+  DBG_SERIALPRINT("TOUCH samples ");   DBG_SERIALPRINT(g_touch.sample_num);
+  DBG_SERIALPRINT(" bitbang reads ");  DBG_SERIALPRINT(g_touch.bitbang_num);
+  DBG_SERIALPRINT(" usec ");           DBG_SERIALPRINT(g_touch.usec_bitbang);
+  DBG_SERIALPRINT(" presses ");        DBG_SERIALPRINTLN(g_touch.press_num);
+  g_touch.sample_num = g_touch.bitbang_num = g_touch.usec_bitbang = g_touch.press_num = 0;
+} // end uni_touch_report()
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 // static void cyd_input_read(lv_indev_t * indev, lv_indev_data_t * data)
 //
@@ -595,40 +1345,28 @@ void str_display_cmd(char* p_msg_str, char* p_cmd, const char* p_insert_words) {
 //   from https://randomnerdtutorials.com/esp32-cheap-yellow-display-cyd-resistive-touchscreen-calibration/
 //
 // Modified by https://github.com/Mark-MDO47/ to use XPT2046_Bitbang instead of TFT_eSPI
+//    and to use the Q16 fixed point calibration from uni_touch_cal_load()
 //
 static void cyd_input_read(lv_indev_t * indev, lv_indev_data_t * data) {
+#if UNI_TOUCH_FILTER
+  // uni_touch_sample() already did the reading and filtering
+  if (0 != g_touch.pressed) {
+    data->state = LV_INDEV_STATE_PRESSED;
+    data->point.x = g_touch.x;
+    data->point.y = g_touch.y;
+  } else {
+    data->state = LV_INDEV_STATE_RELEASED;
+    return;
+  }
+#else // not UNI_TOUCH_FILTER
 // NOTE WE ARE USING XPT2046_Bitbang INSTEAD OF TFT_eSPI
   // Checks if Touchscreen was touched, and prints X, Y and Pressure (Z)
   TouchPoint p = ts.getTouch();
   if (p.zRaw > 200) { // this threshold of 200 seems to work pretty well
-    // Get Touchscreen points
-    p.x = p.xRaw; // we will recalculate x & y values; use same names as TFT_eSPI
-    p.y = p.yRaw;
-// NOTE WE ARE USING XPT2046_Bitbang INSTEAD OF TFT_eSPI
-
     // Advanced Touchscreen calibration, LEARN MORE » https://RandomNerdTutorials.com/touchscreen-calibration/
-    float alpha_x, beta_x, alpha_y, beta_y, delta_x, delta_y;
-
-    // REPLACE WITH YOUR OWN CALIBRATION VALUES » https://RandomNerdTutorials.com/touchscreen-calibration/
-    //   or this modified calibrate using XPT2046_Bitbang
+    // Run this modified calibrate using XPT2046_Bitbang once on each CYD; it stores the coefficients in NVS
     //      https://github.com/Mark-MDO47/UniRemote/tree/master/code/CYDbitBangCalibrate
-    alpha_x = -0.092;
-    beta_x = 0.000;
-    delta_x = 334.610;
-    alpha_y = -0.001;
-    beta_y = 0.066;
-    delta_y = -14.307;
-
-    x = alpha_y * p.x + beta_y * p.y + delta_y;
-    // clamp x between 0 and SCREEN_WIDTH - 1
-    x = max(0, x);
-    x = min(SCREEN_WIDTH - 1, x);
-
-    y = alpha_x * p.x + beta_x * p.y + delta_x;
-    // clamp y between 0 and SCREEN_HEIGHT - 1
-    y = max(0, y);
-    y = min(SCREEN_HEIGHT - 1, y);
-
+    uni_touch_cal_apply(p.xRaw, p.yRaw, &x, &y);
 
 // NOTE WE ARE USING XPT2046_Bitbang INSTEAD OF TFT_eSPI
     z = p.zRaw;
@@ -639,16 +1377,18 @@ static void cyd_input_read(lv_indev_t * indev, lv_indev_data_t * data) {
     // Set the coordinates
     data->point.x = x;
     data->point.y = y;
-
-#if DEBUG_PRINT_TOUCHSCREEN_INFO
-    // Print Touchscreen info about X, Y and Pressure (Z) on the Serial Monitor
-    Serial.print("X = "); Serial.print(x); Serial.print(" | Y = "); Serial.print(y);
-    Serial.print(" | Pressure = "); Serial.print(z); Serial.println();
-#endif // DEBUG_PRINT_TOUCHSCREEN_INFO
   }
   else {
     data->state = LV_INDEV_STATE_RELEASED;
+    return;
   }
+#endif // not UNI_TOUCH_FILTER
+
+#if DEBUG_PRINT_TOUCHSCREEN_INFO
+  // Print Touchscreen info about X, Y and Pressure (Z) on the Serial Monitor
+  Serial.print("X = "); Serial.print(x); Serial.print(" | Y = "); Serial.print(y);
+  Serial.print(" | Pressure = "); Serial.print(z); Serial.println();
+#endif // DEBUG_PRINT_TOUCHSCREEN_INFO
 } // end cyd_input_read()
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -660,15 +1400,28 @@ static void button_event_callback(lv_event_t * e) {
   static lv_obj_t * button;
   static action_button_t * action_button_ptr;
 
+  static uint8_t long_pressed = 0; // LVGL also sends LV_EVENT_CLICKED when a long press is released; ignore that one
+
   code = lv_event_get_code(e);
-  if ((LV_EVENT_CLICKED == code) && (0 == g_button_press.pressed)) {
+  if (LV_EVENT_PRESSED == code) {
+    long_pressed = 0;
+  } else if (LV_EVENT_LONG_PRESSED == code) {
+    long_pressed = 1;
+  }
+  if ((LV_EVENT_CLICKED == code) && (0 != long_pressed)) {
+    long_pressed = 0;
+  } else if (((LV_EVENT_CLICKED == code) || (LV_EVENT_LONG_PRESSED == code)) && (0 == g_button_press.pressed)) {
     button = (lv_obj_t*) lv_event_get_target(e);
     action_button_ptr = (action_button_t*) lv_event_get_user_data(e); // &action_buttons[idx]
     counter++;
     g_button_press.btn_idx = (uint8_t) action_button_ptr->btn_idx;
     g_button_press.uni_state = g_uni_state;
     g_button_press.uni_state_error = g_uni_state_error;
+    g_button_press.long_press = (LV_EVENT_LONG_PRESSED == code) ? 1 : 0;
     g_button_press.pressed = (uint8_t) 1; // handle_button_press() clears it
+#if UNI_TRACE
+    uni_trace_instant(&g_trace_loop, UNI_TRACE_ID_BUTTON, (uint16_t) (g_button_press.btn_idx | (g_button_press.long_press ? 0x100 : 0)));
+#endif // UNI_TRACE
     // LV_LOG_USER("Counter: %d", counter);
     DBG_SERIALPRINT("button_event_callback() ");
     DBG_SERIALPRINT(g_button_press.btn_idx);
@@ -685,6 +1438,21 @@ int32_t handle_button_press() {
   DBG_SERIALPRINTLN("handle_button_press() 0");
   switch (g_button_press.uni_state) {
     case UNI_STATE_WAIT_CMD:    // last cmd all done, wait for next cmd
+#if UNI_PERF
+      if ((ACTION_BUTTON_MID == g_button_press.btn_idx) && (0 != g_button_press.long_press)) {
+        // held middle button: diagnostics screen
+        g_show_diag = 1;
+        g_msec_diag_next = millis(); // show it now whatever millis() is
+        break;
+      } else if ((0 != g_show_diag) && (ACTION_BUTTON_LEFT == g_button_press.btn_idx)) {
+        uni_perf_clear();
+        g_msec_diag_next = millis(); // show the cleared numbers now
+        break;
+      } else if ((0 != g_show_diag) && (ACTION_BUTTON_MID == g_button_press.btn_idx)) {
+        g_show_diag = 0;
+        break;
+      }
+#endif // UNI_PERF
       if (ACTION_BUTTON_LEFT == g_button_press.btn_idx) {
         // turn on LEDs
         digitalWrite(CYD_LED_RED, CYD_LED_ON);
@@ -704,12 +1472,12 @@ int32_t handle_button_press() {
       if (ACTION_BUTTON_LEFT == g_button_press.btn_idx) {
         // send ESP_NOW command
         g_uni_state = UNI_STATE_SENDING_CMD;
-        sprintf(g_msg_last_opr_comm_status, "\nESP-NOW sending CMD #%d ", g_last_scanned_cmd_count);
+        uni_status_note(UNI_STATUS_OPR_SENDING, g_last_scanned_cmd_count, 0, 0);
         DBG_SERIALPRINTLN("Change state to UNI_STATE_SENDING_CMD");
       } else if (ACTION_BUTTON_RIGHT == g_button_press.btn_idx) {
         // clear ESP_NOW command
         g_uni_state = UNI_STATE_WAIT_CMD;
-        sprintf(g_msg_last_opr_comm_status, "\nESP-NOW OPR CLEAR CMD #%d ", g_last_scanned_cmd_count);
+        uni_status_note(UNI_STATUS_OPR_CLEAR, g_last_scanned_cmd_count, 0, 0);
         DBG_SERIALPRINTLN("Change state to UNI_STATE_WAIT_CMD");
       }
       break;
@@ -718,15 +1486,20 @@ int32_t handle_button_press() {
     case UNI_STATE_WAIT_CB:     // waiting for send callback (very short state)
       break;
     case UNI_STATE_SHOW_STAT:      // show error status and allow abort
-      if (ACTION_BUTTON_LEFT == g_button_press.btn_idx) {
+      if (ACTION_BUTTON_MID == g_button_press.btn_idx) {
+        // switch between status and link table
+        g_show_link_table = 1-g_show_link_table;
+      } else if (ACTION_BUTTON_LEFT == g_button_press.btn_idx) {
         // send ESP_NOW command
+        g_show_link_table = 0;
         g_uni_state = UNI_STATE_SENDING_CMD;
-        sprintf(g_msg_last_opr_comm_status, "\nESP-NOW sending CMD #%d ", g_last_scanned_cmd_count);
+        uni_status_note(UNI_STATUS_OPR_SENDING, g_last_scanned_cmd_count, 0, 0);
         DBG_SERIALPRINTLN("Change state to UNI_STATE_SENDING_CMD");
       } else if (ACTION_BUTTON_RIGHT == g_button_press.btn_idx) {
         // clear ESP_NOW command
+        g_show_link_table = 0;
         g_uni_state = UNI_STATE_WAIT_CMD;
-        sprintf(g_msg_last_opr_comm_status, "\nESP-NOW OPR ABORT CMD #%d ", g_last_scanned_cmd_count);
+        uni_status_note(UNI_STATUS_OPR_ABORT, g_last_scanned_cmd_count, 0, 0);
         DBG_SERIALPRINTLN("Change state to UNI_STATE_WAIT_CMD");
       }
       break;
@@ -814,12 +1587,12 @@ void lv_create_main_gui(void) {
   uni_lv_button_create(2, LV_ALIGN_TOP_RIGHT, "3 Label", "Some Text 3\nMore and\n   ... more", &g_style_red);
 
   g_styled_label_last_status.label_obj = lv_obj_create(lv_screen_active());
-  lv_obj_add_style(g_styled_label_last_status.label_obj, &g_style_green, 0);
+  uni_view_style(g_styled_label_last_status.label_obj, &g_view_last_status_style, &g_style_green);
   lv_obj_add_style(g_styled_label_last_status.label_obj, &g_style_screen_width_btn_height, 0);
   lv_obj_align(g_styled_label_last_status.label_obj, LV_ALIGN_BOTTOM_LEFT, 0, 0);
   g_styled_label_last_status.label_text = lv_label_create(g_styled_label_last_status.label_obj);
   lv_obj_align_to(g_styled_label_last_status.label_text, g_styled_label_last_status.label_obj, LV_ALIGN_TOP_LEFT, 0, -8);
-  lv_label_set_text(g_styled_label_last_status.label_text, "Waiting for\nCommand scan");
+  uni_lv_last_status_text_style("Waiting for\nCommand scan");
 
   g_styled_label_opr_comm.label_obj = lv_obj_create(lv_screen_active());
   lv_obj_add_style(g_styled_label_opr_comm.label_obj, &g_style_grey, 0);
@@ -827,10 +1600,100 @@ void lv_create_main_gui(void) {
   lv_obj_align_to(g_styled_label_opr_comm.label_obj, g_styled_label_last_status.label_obj, LV_ALIGN_OUT_TOP_LEFT, 0, 0);
   g_styled_label_opr_comm.label_text = lv_label_create(g_styled_label_opr_comm.label_obj);
   lv_obj_align_to(g_styled_label_opr_comm.label_text, g_styled_label_opr_comm.label_obj, LV_ALIGN_TOP_LEFT, 0, -14);
-  lv_label_set_text(g_styled_label_opr_comm.label_text, "No Instructions Yet\nNext 2\nNext  3\nNext   4\nNext    5");
+  uni_view_opr_comm_text("No Instructions Yet\nNext 2\nNext  3\nNext   4\nNext    5");
 } // end lv_create_main_gui()
 
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_dir_find_alias() - find a receiver in the directory by its alias
+//       returns: index in g_dir[]; -1 if not found
+//
+// aliases are not case sensitive
+//
+int16_t uni_dir_find_alias(const char * p_alias) {
+  for (int16_t i = 0; i < UNI_DIR_NUM; i++) {
+    if ((0 != g_dir[i].in_use) && ('\0' != g_dir[i].alias[0]) && (0 == strcasecmp(g_dir[i].alias, p_alias))) return(i);
+  }
+  return(-1);
+} // end uni_dir_find_alias()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_dir_alias() - alias of a receiver for showing on the screen
+//       returns: the alias; "" if not in the directory or no alias
+//
+const char * uni_dir_alias(const uint8_t * p_mac_addr) {
+  for (int16_t i = 0; i < UNI_DIR_NUM; i++) {
+    if ((0 != g_dir[i].in_use) && (0 == memcmp(g_dir[i].mac_addr, p_mac_addr, ESP_NOW_ETH_ALEN))) return(g_dir[i].alias);
+  }
+  return("");
+} // end uni_dir_alias()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_announce_rcvd_callback() - ESP-NOW rcvr callback; keeps receiver announcements for uni_dir_update()
+//       returns: nothing
+//
+// UniRemoteCYD only sends commands; announcements are the only thing it listens for
+//
+void uni_announce_rcvd_callback(const esp_now_recv_info_t * p_info_ptr, const uint8_t * p_data, int p_data_len) {
+  uni_frame_announce_t announce;
+
+  if ((p_data_len <= 0) || (0 == uni_frame_find_announce(p_data, (uint16_t) p_data_len, &announce))) return;
+  uint16_t put_next = (g_announce_ring_put + 1) % UNI_ANNOUNCE_RING_NUM;
+  if (put_next == g_announce_ring_get) { // full; loop() will hear it next time it asks
+    g_announce_dropped_num += 1;
+    return;
+  }
+  uni_announce_rcvd_t * rcvd_ptr = &g_announce_ring[g_announce_ring_put];
+  memcpy(rcvd_ptr->mac_addr, p_info_ptr->src_addr, ESP_NOW_ETH_ALEN);
+  rcvd_ptr->rssi = ((wifi_pkt_rx_ctrl_t *) 0 != p_info_ptr->rx_ctrl) ? p_info_ptr->rx_ctrl->rssi : 0;
+  rcvd_ptr->announce = announce;
+  g_announce_ring_put = put_next; // last, so loop() never sees a partly filled entry
+} // end uni_announce_rcvd_callback()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_dir_update() - put the announcements from the callback into the directory
+//       returns: nothing
+//
+// a receiver already in the directory is updated; a new one takes a free entry or the one heard longest ago
+// two receivers with the same alias get a warning on Serial; cards with that alias go to the first one
+//
+void uni_dir_update() {
+  uint32_t msec_now = millis();
+  char line[100];
+
+  while (g_announce_ring_get != g_announce_ring_put) {
+    uni_announce_rcvd_t * rcvd_ptr = &g_announce_ring[g_announce_ring_get];
+    int16_t idx = -1;
+    for (int16_t i = 0; i < UNI_DIR_NUM; i++) {
+      if ((0 != g_dir[i].in_use) && (0 == memcmp(g_dir[i].mac_addr, rcvd_ptr->mac_addr, ESP_NOW_ETH_ALEN))) { idx = i; break; }
+      if ((idx < 0) || ((0 != g_dir[idx].in_use) &&
+          ((0 == g_dir[i].in_use) || ((msec_now - g_dir[i].msec_heard) > (msec_now - g_dir[idx].msec_heard))))) {
+        idx = i; // best entry to replace so far
+      }
+    }
+    uni_dir_t * dir_ptr = &g_dir[idx];
+    memcpy(dir_ptr->mac_addr, rcvd_ptr->mac_addr, ESP_NOW_ETH_ALEN);
+    dir_ptr->in_use = 1;
+    dir_ptr->caps = rcvd_ptr->announce.caps;
+    dir_ptr->rssi = rcvd_ptr->rssi;
+    memcpy(dir_ptr->alias, rcvd_ptr->announce.alias, UNI_FRAME_ANNOUNCE_ALIAS_LEN);
+    dir_ptr->alias[UNI_FRAME_ANNOUNCE_ALIAS_LEN] = '\0';
+    memcpy(dir_ptr->name, rcvd_ptr->announce.name, UNI_FRAME_ANNOUNCE_NAME_LEN);
+    dir_ptr->name[UNI_FRAME_ANNOUNCE_NAME_LEN] = '\0';
+    dir_ptr->msec_heard = msec_now;
+    g_announce_ring_get = (g_announce_ring_get + 1) % UNI_ANNOUNCE_RING_NUM;
+
+    sprintf(line, "DIR %02x:%02x:%02x:%02x:%02x:%02x alias \"%s\" name \"%s\" caps 0x%02x rssi %d",
+      dir_ptr->mac_addr[0], dir_ptr->mac_addr[1], dir_ptr->mac_addr[2], dir_ptr->mac_addr[3], dir_ptr->mac_addr[4], dir_ptr->mac_addr[5],
+      dir_ptr->alias, dir_ptr->name, dir_ptr->caps, dir_ptr->rssi);
+    DBG_SERIALPRINTLN(line);
+    if (('\0' != dir_ptr->alias[0]) && (uni_dir_find_alias(dir_ptr->alias) != idx)) {
+      sprintf(line, "WARNING: alias \"%s\" is used by more than one receiver", dir_ptr->alias);
+      DBG_SERIALPRINTLN(line);
+    }
+  }
+} // end uni_dir_update()
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 // uni_cmd_decode_get_mac_addr()
 //       returns: (uint8_t *) pointer to MAC address; pointer is zero if bad decode
@@ -840,41 +1703,51 @@ void lv_create_main_gui(void) {
 // 000000000011111111
 // 012345678901234567
 //
+// or with UNI_RCVR_DIRECTORY, starting with the alias a receiver announced; something like this
+// K2|the-rest-is-the-command
+// an alias not in the directory asks all receivers to announce, so scanning the card again should work
+// sets g_cmd_decode_addr_len to where the rest of the command starts
+//
 static uint8_t cmd_decode_mac_addr[ESP_NOW_ETH_ALEN];
 uint8_t * uni_cmd_decode_get_mac_addr(char * p_cmd) {
-  uint8_t * ret_addr = cmd_decode_mac_addr;
-  uint8_t tmp;
-
-  // make sure MAC address is of the correct form and decode piece by piece
-  if ((3*ESP_NOW_ETH_ALEN+1) > strlen(p_cmd)) {
-    ret_addr = ((uint8_t *) 0);
-  } else { // at least one character after MAC address
-    for (int i = 0; i < 3*ESP_NOW_ETH_ALEN; i += 3) {
-      if (!isHexadecimalDigit(p_cmd[i]) || !isHexadecimalDigit(p_cmd[i+1])) {
-        ret_addr = ((uint8_t *) 0);
-        break;
-      }
-      tmp = 0;
-      if ( ((3*(ESP_NOW_ETH_ALEN-1) != i) && (':' != p_cmd[i+2])) ||
-           ((3*(ESP_NOW_ETH_ALEN-1) == i) && ('|' != p_cmd[i+2])) ) {
-        ret_addr = ((uint8_t *) 0);
-        break;
-      }
-      // these two hex digits are good
-      for (int j = 0; j < 2; j += 1) {
-        tmp <<= 4;
-        if      (p_cmd[i+j] <= '9') tmp |= p_cmd[i+j] - '0';
-        else if (p_cmd[i+j] <= 'F') tmp |= p_cmd[i+j] - 'A' + 10;
-        else                          tmp |= p_cmd[i+j] - 'a' + 10;
-      }
-      ret_addr[i/3] = tmp;
-    } // end check MAC address
+  g_cmd_decode_addr_len = 3*ESP_NOW_ETH_ALEN;
+#if UNI_RCVR_DIRECTORY
+  char alias[UNI_FRAME_ANNOUNCE_ALIAS_LEN+1];
+  uint16_t alias_len = uni_cmd_parse_alias(p_cmd, alias, UNI_FRAME_ANNOUNCE_ALIAS_LEN);
+  if (alias_len > 0) {
+    int16_t dir_idx = uni_dir_find_alias(alias);
+    if (dir_idx < 0) {
+      g_announce_req_pending = 1; // maybe it just has not announced to us yet
+      return((uint8_t *) 0);
+    }
+    memcpy(cmd_decode_mac_addr, g_dir[dir_idx].mac_addr, ESP_NOW_ETH_ALEN);
+    g_cmd_decode_addr_len = alias_len+1;
+    return(cmd_decode_mac_addr);
   }
+#endif // UNI_RCVR_DIRECTORY
 
-  // if ret_addr is not 0 then the address is good; status msg generated by caller
-  return(ret_addr);
+  // MAC address of the correct form with at least one character after; status msg generated by caller
+  if (UNI_CMD_PARSE_NONE == uni_cmd_parse_mac(p_cmd, cmd_decode_mac_addr)) return((uint8_t *) 0);
+  return(cmd_decode_mac_addr);
 } // uni_cmd_decode_get_mac_addr
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_cmd_decode_exec_lead()
+//       returns: index in p_cmd where the command to send starts
+//
+// after the MAC address (or alias) there can be an "execute at" lead time in millisec; something like this
+// ff:ff:ff:ff:ff:ff|@500|the-rest-is-the-command
+// 0000000000111111111122
+// 0123456789012345678901
+// the receivers execute the command 500 millisec after it is sent, all at the same time
+//    (as well as they know the UniRemoteCYD clock from the time beacons)
+// call after uni_cmd_decode_get_mac_addr(); it sets g_cmd_decode_addr_len
+// sets g_cmd_exec_lead_msec; zero if there is no lead time
+//
+uint16_t uni_cmd_decode_exec_lead(char * p_cmd) {
+  return(uni_cmd_parse_exec_lead(p_cmd, g_cmd_decode_addr_len, &g_cmd_exec_lead_msec));
+} // end uni_cmd_decode_exec_lead()
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 // uni_esp_now_decode_error() - return string with ESP-NOW error
 //
@@ -916,33 +1789,413 @@ const char * uni_esp_now_decode_error(uint16_t errcode) {
     case UNI_ERR_CMD_DECODE_FAIL:
       str = " could not decode MAC from CMD";
       break;
+    case UNI_ERR_DEST_BUSY:
+      str = " previous message to this receiver still in flight";
+      break;
+    case UNI_ERR_NO_CHANNEL:
+      str = " receiver did not answer on any WiFi channel";
+      break;
     default:
       str = " ESPNOW UNKNOWN ERROR CODE";
   }
   return(str);
 } // end uni_esp_now_decode_error()
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_cmd_timing_report() - report sender per-stage latency for the command just sent
+//       returns: nothing
+//
+// called at loop() level after the send callback
+//   scan  - reading the command from the RFID card or QR code
+//   parse - decoding the MAC address and registering the ESP-NOW peer
+//   queue - from parse done until esp_now_send(); includes waiting for GO if not "send immediately"
+//   air   - from esp_now_send() until the send callback (MAC ACK or fail)
+// the receiver reports these plus its own stages from the timing trailer
+//
+void uni_cmd_timing_report(const uni_in_flight_t * p_msg_ptr) {
+  const uni_cmd_timing_t * timing_ptr = &p_msg_ptr->timing;
+  uint32_t usec_air = (uint32_t) (timing_ptr->usec_cb - timing_ptr->usec_sent);
+
+#if UNI_PERF
+  uni_perf_hist_add(&g_perf_air, usec_air);
+#endif // UNI_PERF
+
+  // remember the smallest air time to this peer; the receiver uses it for the clock offset
+  if ((ESP_NOW_SEND_SUCCESS == p_msg_ptr->status) && (p_msg_ptr->peer_idx >= 0) &&
+      ((0 == g_rcvr_usec_air_min[p_msg_ptr->peer_idx]) || (usec_air < g_rcvr_usec_air_min[p_msg_ptr->peer_idx]))) {
+    g_rcvr_usec_air_min[p_msg_ptr->peer_idx] = usec_air;
+  }
+
+  DBG_SERIALPRINT("TIMING CMD #"); DBG_SERIALPRINT(p_msg_ptr->cmd_num);
+  DBG_SERIALPRINT(" seq ");        DBG_SERIALPRINT(p_msg_ptr->seq);
+  DBG_SERIALPRINT(" usec scan ");  DBG_SERIALPRINT((uint32_t) (timing_ptr->usec_scan_done - timing_ptr->usec_scan_start));
+  DBG_SERIALPRINT(" parse ");      DBG_SERIALPRINT((uint32_t) (timing_ptr->usec_parse_done - timing_ptr->usec_scan_done));
+  DBG_SERIALPRINT(" queue ");      DBG_SERIALPRINT((uint32_t) (timing_ptr->usec_sent - timing_ptr->usec_parse_done));
+  DBG_SERIALPRINT(" air ");        DBG_SERIALPRINT(usec_air);
+  DBG_SERIALPRINT(" total ");      DBG_SERIALPRINTLN((uint32_t) (timing_ptr->usec_cb - timing_ptr->usec_scan_start));
+} // end uni_cmd_timing_report()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_link_apply_rate() - use the PHY rate g_link_rates[p_rate_idx] for messages to p_mac_addr
+//       returns: nothing
+//
+// call just before esp_now_send()
+// ESP-IDF 5.4 and later keep a rate for each peer; before that there is one ESP-NOW rate for everybody,
+//    so it is set before each send (a message already in flight may go at the new rate)
+//
+void uni_link_apply_rate(const uint8_t * p_mac_addr, uint8_t p_rate_idx) {
+#if UNI_ADAPTIVE_RATE
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 4, 0)
+  esp_now_rate_config_t rate_config;
+  memset(&rate_config, 0, sizeof(rate_config));
+  rate_config.phymode = g_link_rates[p_rate_idx].phymode;
+  rate_config.rate = g_link_rates[p_rate_idx].rate;
+  esp_now_set_peer_rate_config(p_mac_addr, &rate_config);
+#else  // one rate for all ESP-NOW peers
+  esp_wifi_config_espnow_rate(WIFI_IF_STA, g_link_rates[p_rate_idx].rate);
+#endif // ESP_IDF_VERSION
+#endif // UNI_ADAPTIVE_RATE
+} // end uni_link_apply_rate()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_link_note() - update link quality for a peer from a send callback and pick its next PHY rate
+//       returns: nothing
+//
+// a fail drops to the next slower rate right away; it takes UNI_LINK_UP_OK_NUM successes in a row
+//    with the success average at least UNI_LINK_UP_OK_PCT to try the next faster rate
+// a link that only works at a slow rate settles there, trying the faster rate once in a while
+//
+void uni_link_note(int16_t p_peer_idx, uni_esp_now_status_t p_status) {
+  if (p_peer_idx < 0) return;
+  uni_link_t * link_ptr = &g_rcvr_link[p_peer_idx];
+  int32_t sample = (ESP_NOW_SEND_SUCCESS == p_status) ? 10000 : 0;
+
+  link_ptr->send_num += 1;
+  if (1 == link_ptr->send_num) link_ptr->ok_avg_x100 = sample;
+  else link_ptr->ok_avg_x100 += (sample - (int32_t) link_ptr->ok_avg_x100) / UNI_LINK_OK_AVG_DIV;
+
+  if (ESP_NOW_SEND_SUCCESS == p_status) {
+    link_ptr->fail_in_row = 0;
+    if (link_ptr->ok_in_row < 255) link_ptr->ok_in_row += 1;
+    if ((UNI_ADAPTIVE_RATE) && (link_ptr->ok_in_row >= UNI_LINK_UP_OK_NUM) &&
+        (link_ptr->ok_avg_x100 >= UNI_LINK_UP_OK_PCT*100) && (link_ptr->rate_idx < UNI_LINK_RATE_NUM-1)) {
+      link_ptr->rate_idx += 1;
+      link_ptr->ok_in_row = 0;
+    }
+  } else { // ESP_NOW_SEND_FAIL
+    link_ptr->fail_num += 1;
+    link_ptr->ok_in_row = 0;
+    if (link_ptr->fail_in_row < 255) link_ptr->fail_in_row += 1;
+    if ((UNI_ADAPTIVE_RATE) && (link_ptr->rate_idx > 0)) link_ptr->rate_idx -= 1;
+  }
+} // end uni_link_note()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_link_table_text() - make the link table to show on the screen
+//       returns: nothing
+//
+// p_text must hold at least 40 chars per line for 2+UNI_LINK_SCREEN_NUM lines
+// one line per peer (last 2 bytes of MAC address): success average, PHY rate, sent, failed
+//
+void uni_link_table_text(char * p_text) {
+  uint16_t num_shown = 0;
+  uint16_t num_peers = 0;
+  p_text += sprintf(p_text, "Links: MAC  al OK%%  rate ch  sent  fail");
+  for (uint8_t i = 0; i < g_rcvr_peer_num; i++) {
+    if (0 == memcmp(&g_rcvr_mac_addr[i*ESP_NOW_ETH_ALEN], g_broadcast_mac_addr, ESP_NOW_ETH_ALEN)) continue; // no ACK for broadcast
+    num_peers += 1;
+    if (num_shown >= UNI_LINK_SCREEN_NUM) continue;
+    num_shown += 1;
+    p_text += sprintf(p_text, "\n  %02x:%02x %2s %3d%% %4s %2d %5lu %5lu",
+      g_rcvr_mac_addr[i*ESP_NOW_ETH_ALEN+4], g_rcvr_mac_addr[i*ESP_NOW_ETH_ALEN+5], uni_dir_alias(&g_rcvr_mac_addr[i*ESP_NOW_ETH_ALEN]),
+      g_rcvr_link[i].ok_avg_x100 / 100, g_link_rates[g_rcvr_link[i].rate_idx].name, g_rcvr_channel[i],
+      (unsigned long) g_rcvr_link[i].send_num, (unsigned long) g_rcvr_link[i].fail_num);
+  }
+  if (0 == num_peers) sprintf(p_text, "\n  no commands sent yet");
+  else if (num_shown < num_peers) sprintf(p_text, "\n  +%d more on Serial", num_peers - num_shown);
+} // end uni_link_table_text()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_perf_usec() - microseconds between two esp_timer_get_time() for a histogram
+//       returns: p_usec_end - p_usec_start, at most 0xFFFFFFFF (71 minutes)
+//
+static inline uint32_t uni_perf_usec(int64_t p_usec_start, int64_t p_usec_end) {
+  int64_t usec = p_usec_end - p_usec_start;
+  if (usec < 0) return(0);
+  return((usec > 0xFFFFFFFFLL) ? 0xFFFFFFFFUL : (uint32_t) usec);
+} // end uni_perf_usec()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_perf_loop_end() - end of the busy part of loop(); count busy time and time in the state just left
+//       returns: nothing
+//
+// states can change several times in one loop(); only the state at the end of loop() is counted
+//
+void uni_perf_loop_end(int64_t p_usec_loop_start) {
+  static uint8_t state_prev = UNI_STATE_WAIT_CMD;
+  int64_t usec_now = esp_timer_get_time();
+
+  uni_perf_hist_add(&g_perf_loop_busy, uni_perf_usec(p_usec_loop_start, usec_now));
+  if (state_prev != g_uni_state) {
+    uni_perf_hist_add(&g_perf_state[state_prev], uni_perf_usec(g_uni_state_times[state_prev], usec_now));
+    g_uni_state_times[g_uni_state] = usec_now;
+    state_prev = g_uni_state;
+  }
+} // end uni_perf_loop_end()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_diag_text() - make the diagnostics screen text
+//       returns: nothing
+//
+// p_text must hold at least 44 chars per line for 6 lines; "perf" on Serial has all of it
+//
+void uni_diag_text(char * p_text) {
+  static const char * const names[] = { "loop", "lvgl", "scan", "air" };
+  const uni_perf_hist_t * hists[] = { &g_perf_loop_period, &g_perf_lvgl, &g_perf_scan, &g_perf_air };
+
+  p_text += sprintf(p_text, "Diag usec    n    p50    p90     max");
+  for (uint16_t idx = 0; idx < sizeof(hists)/sizeof(hists[0]); idx++) {
+    p_text += sprintf(p_text, "\n  %-4s %6lu %6lu %6lu %7lu", names[idx], (unsigned long) hists[idx]->num,
+      (unsigned long) uni_perf_hist_pct(hists[idx], 50), (unsigned long) uni_perf_hist_pct(hists[idx], 90),
+      (unsigned long) hists[idx]->max);
+  }
+  sprintf(p_text, "\n  avg ms wait %lu seen %lu send %lu cb %lu stat %lu",
+    (unsigned long) (uni_perf_hist_avg(&g_perf_state[UNI_STATE_WAIT_CMD]) / 1000),
+    (unsigned long) (uni_perf_hist_avg(&g_perf_state[UNI_STATE_CMD_SEEN]) / 1000),
+    (unsigned long) (uni_perf_hist_avg(&g_perf_state[UNI_STATE_SENDING_CMD]) / 1000),
+    (unsigned long) (uni_perf_hist_avg(&g_perf_state[UNI_STATE_WAIT_CB]) / 1000),
+    (unsigned long) (uni_perf_hist_avg(&g_perf_state[UNI_STATE_SHOW_STAT]) / 1000));
+} // end uni_diag_text()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_perf_cmd() - Serial command "perf": dump the histograms and counters; "perf clear" starts them over
+//       returns: nothing
+//
+void uni_perf_cmd(const char * p_args) {
+  if (0 == strcmp(p_args, "clear")) {
+    uni_perf_clear();
+    Serial.printf("PERF cleared\n");
+  } else {
+    uni_perf_dump();
+  }
+} // end uni_perf_cmd()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_stall_cmd() - Serial command "stall": print the timed sections
+//       returns: nothing
+//
+void uni_stall_cmd(const char * p_args) {
+  uni_stall_dump();
+} // end uni_stall_cmd()
+
+#if UNI_TRACE
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_trace_state() - trace g_uni_state if it changed since the last call
+//       returns: nothing
+//
+// call after each part of loop() that can change state
+//
+void uni_trace_state() {
+  static uint8_t state_traced = 0xFF; // none yet
+  if (state_traced == g_uni_state) return;
+  state_traced = g_uni_state;
+  uni_trace_instant(&g_trace_loop, UNI_TRACE_ID_STATE, g_uni_state);
+} // end uni_trace_state()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_trace_cmd() - Serial command "trace": dump the timeline; "trace clear" forgets it
+//       returns: nothing
+//
+void uni_trace_cmd(const char * p_args) {
+  if (0 == strcmp(p_args, "clear")) {
+    uni_trace_clear();
+    Serial.printf("TRACE cleared\n");
+  } else {
+    uni_trace_dump();
+  }
+} // end uni_trace_cmd()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_trace_setup() - set up the rings, name the events and add the "trace" Serial command
+//       returns: nothing
+//
+void uni_trace_setup() {
+  static const char * const state_names[UNI_STATE_NUM] = { "WAIT_CMD", "CMD_SEEN", "SENDING_CMD", "WAIT_CB", "SHOW_STAT" };
+
+  uni_trace_ring_init(&g_trace_loop, "loop", g_trace_loop_recs, UNI_TRACE_LOOP_NUM);
+  uni_trace_ring_init(&g_trace_cb, "send_cb", g_trace_cb_recs, UNI_TRACE_CB_NUM);
+  uni_trace_name(UNI_TRACE_ID_STATE, "state", 0);
+  for (uint16_t idx = 0; idx < UNI_STATE_NUM; idx++) uni_trace_arg_name(UNI_TRACE_ID_STATE, idx, state_names[idx]);
+  uni_trace_name(UNI_TRACE_ID_SCAN, "scan", UNI_TRACE_MIN_USEC);
+  uni_trace_name(UNI_TRACE_ID_SEND, "send", 0);
+  uni_trace_name(UNI_TRACE_ID_SEND_CB, "send_cb", 0);
+  uni_trace_name(UNI_TRACE_ID_LVGL, "lvgl", UNI_TRACE_MIN_USEC);
+  uni_trace_name(UNI_TRACE_ID_BUTTON, "button", 0);
+  uni_trace_state();
+  uni_serial_cmd_add("trace", uni_trace_cmd, "trace [clear] - print the timeline for uni_trace_json.py; clear forgets it");
+} // end uni_trace_setup()
+#endif // UNI_TRACE
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_perf_setup() - register the histograms, counters and the "perf" Serial command
+//       returns: nothing
+//
+void uni_perf_setup() {
+  static const char * const state_names[UNI_STATE_NUM] = { "state_wait_cmd", "state_cmd_seen", "state_sending_cmd", "state_wait_cb", "state_show_stat" };
+
+  uni_perf_hist_register(&g_perf_loop_period, "loop_period");
+  uni_perf_hist_register(&g_perf_loop_busy, "loop_busy");
+  uni_perf_hist_register(&g_perf_lvgl, "lvgl");
+  uni_perf_hist_register(&g_perf_scan, "scan");
+  uni_perf_hist_register(&g_perf_air, "air");
+  for (uint16_t idx = 0; idx < UNI_STATE_NUM; idx++) {
+    uni_perf_hist_register(&g_perf_state[idx], state_names[idx]);
+    g_uni_state_times[idx] = esp_timer_get_time();
+  }
+  uni_perf_ctr_register(&g_send_seq, "send_num");
+  uni_perf_ctr_register(&g_perf_send_cb_num, "send_cb_num");
+  uni_perf_ctr_register(&g_in_flight_unmatched_num, "send_cb_unmatched");
+  uni_perf_ctr_register(&g_probe_seq, "channel_probe_num");
+  uni_perf_ctr_register(&g_announce_req_seq, "announce_req_num");
+  uni_perf_ctr_register(&g_view_set_num, "view_set_num");
+  uni_perf_ctr_register(&g_view_avoided_num, "view_avoided_num");
+  uni_serial_cmd_add("perf", uni_perf_cmd, "perf [clear] - print performance histograms and counters; clear starts the histograms over");
+} // end uni_perf_setup()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_link_report() - print the link quality to each peer on Serial
+//       returns: nothing
+//
+void uni_link_report() {
+  for (uint8_t i = 0; i < g_rcvr_peer_num; i++) {
+    if (0 == g_rcvr_link[i].send_num) continue;
+    DBG_SERIALPRINT("LINK ");
+    for (uint8_t j = 0; j < ESP_NOW_ETH_ALEN; j++) {
+      if (0 != j) DBG_SERIALPRINT(":");
+      if (g_rcvr_mac_addr[i*ESP_NOW_ETH_ALEN+j] < 16) DBG_SERIALPRINT("0");
+      DBG_SERIALPRINT(g_rcvr_mac_addr[i*ESP_NOW_ETH_ALEN+j], HEX);
+    }
+    DBG_SERIALPRINT(" ok% ");   DBG_SERIALPRINT(g_rcvr_link[i].ok_avg_x100 / 100);
+    DBG_SERIALPRINT(" rate ");  DBG_SERIALPRINT(g_link_rates[g_rcvr_link[i].rate_idx].name);
+    DBG_SERIALPRINT(" channel "); DBG_SERIALPRINT(g_rcvr_channel[i]);
+    DBG_SERIALPRINT(" sent ");  DBG_SERIALPRINT(g_rcvr_link[i].send_num);
+    DBG_SERIALPRINT(" fail ");  DBG_SERIALPRINT(g_rcvr_link[i].fail_num);
+    DBG_SERIALPRINT(" air min usec "); DBG_SERIALPRINTLN(g_rcvr_usec_air_min[i]);
+  }
+} // end uni_link_report()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_in_flight_add() - get an in-flight entry for a message about to be sent
+//       returns: index into g_in_flight[], or -1 if a message to p_mac_addr is already in flight or table full
+//
+// call before esp_now_send(); the send callback can happen before esp_now_send() returns
+// if esp_now_send() fails, call uni_in_flight_free() since there will be no callback
+//
+int16_t uni_in_flight_add(const uint8_t * p_mac_addr, uint8_t p_kind, int16_t p_peer_idx) {
+  int16_t idx_free = -1;
+  for (int16_t i = 0; i < UNI_IN_FLIGHT_NUM; i++) {
+    if (0 == g_in_flight[i].in_use) {
+      if (idx_free < 0) idx_free = i;
+    } else if (0 == memcmp(g_in_flight[i].mac_addr, p_mac_addr, ESP_NOW_ETH_ALEN)) {
+      return(-1); // one at a time to each destination so callbacks match sends
+    }
+  }
+  if (idx_free < 0) return(-1); // table full
+
+  uni_in_flight_t * msg_ptr = &g_in_flight[idx_free];
+  memcpy(msg_ptr->mac_addr, p_mac_addr, ESP_NOW_ETH_ALEN);
+  msg_ptr->done = 0;
+  msg_ptr->kind = p_kind;
+  msg_ptr->cmd_num = g_last_scanned_cmd_count;
+  msg_ptr->peer_idx = p_peer_idx;
+  msg_ptr->seq = ++g_send_seq;
+  msg_ptr->status = UNI_ESP_NOW_CB_NEVER_HAPPENED;
+  msg_ptr->in_use = 1; // last; now the send callback can match it
+  return(idx_free);
+} // end uni_in_flight_add()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_in_flight_free() - done with an in-flight entry
+//
+void uni_in_flight_free(int16_t p_idx) {
+  g_in_flight[p_idx].in_use = 0;
+  if (p_idx == g_in_flight_idx_cmd) g_in_flight_idx_cmd = -1;
+} // end uni_in_flight_free()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_in_flight_num() - how many messages are waiting for their send callback
+//
+uint16_t uni_in_flight_num() {
+  uint16_t num = 0;
+  for (int16_t i = 0; i < UNI_IN_FLIGHT_NUM; i++) {
+    if (0 != g_in_flight[i].in_use) num += 1;
+  }
+  return(num);
+} // end uni_in_flight_num()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_in_flight_report() - report the outcome of each message whose send callback happened
+//       returns: nothing
+//
+// called at loop() level; builds the status messages for the screen for each command
+// if waiting in UNI_STATE_WAIT_CB for the current command, changes state the way the send callback used to
+//
+void uni_in_flight_report() {
+  for (int16_t i = 0; i < UNI_IN_FLIGHT_NUM; i++) {
+    uni_in_flight_t * msg_ptr = &g_in_flight[i];
+    if ((0 == msg_ptr->in_use) || (0 == msg_ptr->done)) continue;
+    if (UNI_IN_FLIGHT_KIND_CMD != msg_ptr->kind) { // beacon, or probe whose callback came too late; nothing to report
+      uni_in_flight_free(i);
+      continue;
+    }
+
+    g_last_send_callback_status = msg_ptr->status;
+    uni_link_note(msg_ptr->peer_idx, msg_ptr->status);
+#if UNI_CHANNEL_PROBE
+    if ((msg_ptr->peer_idx >= 0) && (g_rcvr_link[msg_ptr->peer_idx].fail_in_row >= UNI_CHANNEL_FAIL_REPROBE)) {
+      g_rcvr_channel[msg_ptr->peer_idx] = 0; // receiver may have moved; probe again on the next send
+      g_rcvr_link[msg_ptr->peer_idx].fail_in_row = 0;
+    }
+#endif // UNI_CHANNEL_PROBE
+    if (ESP_NOW_SEND_SUCCESS == msg_ptr->status) {
+      uni_peers_note_used(msg_ptr->mac_addr);
+      g_uni_state_error = UNI_STATE_NO_ERROR;
+    } else { // ESP_NOW_SEND_FAIL
+      g_uni_state_error = UNI_STATE_IN_ERROR;
+    }
+    if (msg_ptr->peer_idx >= 0) {
+      uni_link_t * link_ptr = &g_rcvr_link[msg_ptr->peer_idx];
+      uni_status_note((ESP_NOW_SEND_SUCCESS == msg_ptr->status) ? UNI_STATUS_CB_OK : UNI_STATUS_CB_FAIL, msg_ptr->cmd_num,
+        link_ptr->ok_avg_x100 / 100, link_ptr->rate_idx);
+    } else {
+      uni_status_note((ESP_NOW_SEND_SUCCESS == msg_ptr->status) ? UNI_STATUS_CB_OK : UNI_STATUS_CB_FAIL, msg_ptr->cmd_num, 0, UNI_STATUS_NO_LINK);
+    }
+    g_msg_last_esp_now_display_status_cb = 1;
+    uni_cmd_timing_report(msg_ptr);
+    uni_link_report();
+
+    // transition states based on status if we were waiting for this one
+    if ((i == g_in_flight_idx_cmd) && (UNI_STATE_WAIT_CB == g_uni_state)) {
+      if ((ESP_NOW_SEND_SUCCESS == msg_ptr->status) || (0 != g_change_send_no_view))
+        g_uni_state = UNI_STATE_WAIT_CMD;  // all done or show error status and scan next cmd
+      else
+        g_uni_state = UNI_STATE_SHOW_STAT; // show error status and allow abort
+    }
+    uni_in_flight_free(i);
+  }
+} // end uni_in_flight_report()
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 // uni_do_esp_now_callback_status() - ESP-NOW sending callback function
 //       returns: nothing
 //
-// if needed, generates ESP-NOW callback status when at loop level
+// if needed, displays ESP-NOW callback status (noted by uni_in_flight_report()) when at loop level
 // if needed, completely reset esp-now due to message fail in attempt to not crash on next message to non-existent
 //
 void uni_do_esp_now_callback_status() {
-  if (0 != g_msg_last_esp_now_rebuild_msg_cb) {
-    g_msg_last_esp_now_rebuild_msg_cb = 0;
-    if (ESP_NOW_SEND_SUCCESS == g_last_send_callback_status) {
-      sprintf(g_msg_last_esp_now_result_status, "ESP-Now callback OK CMD #%d", g_last_scanned_cmd_count);
-      sprintf(g_msg_last_opr_comm_status, "\nESP-NOW success CMD #%d ", g_last_scanned_cmd_count);
-    } else { // ESP_NOW_SEND_FAIL
-      sprintf(g_msg_last_esp_now_result_status, "ESP-Now callback FAIL CMD #%d", g_last_scanned_cmd_count);
-      sprintf(g_msg_last_opr_comm_status, "\nESP-NOW FAIL CMD #%d ", g_last_scanned_cmd_count);
-    }
-  } // end if need to rebuild status message from callback
   if (0 != g_msg_last_esp_now_display_status_cb) {
     g_msg_last_esp_now_display_status_cb = 0;
-    uni_lv_last_status_text_style(g_msg_last_esp_now_result_status); // yellow if "FAIL"
+    uni_status_show_result(); // yellow if "FAIL"
   } // end if need to display status on screen
   if (0 != g_msg_last_esp_now_reset_esp_now) {
     g_msg_last_esp_now_reset_esp_now = 0;
@@ -954,25 +2207,152 @@ void uni_do_esp_now_callback_status() {
 //       returns: nothing
 //
 void uni_esp_now_cmd_send_callback(const uint8_t *mac_addr, esp_now_send_status_t status) {
-  // crude way to save last status - works OK if not sending too fast
-  g_last_send_callback_status = (uni_esp_now_status_t)status;
-  // tell loop() to call uni_do_esp_now_callback_status() to display status
-  //   don't call lvgl routines at callback level; that may contribute to LVGL timeout crashing
-  g_msg_last_esp_now_rebuild_msg_cb = g_msg_last_esp_now_display_status_cb = 1;
+  int64_t usec_cb = esp_timer_get_time(); // first so air time is as accurate as we can make it
 
-  // transition states based on status
-  if (ESP_NOW_SEND_SUCCESS == g_last_send_callback_status) {
-    g_uni_state_error = UNI_STATE_NO_ERROR;
-    g_uni_state = UNI_STATE_WAIT_CMD;
-  } else { // ESP_NOW_SEND_FAIL
-    g_uni_state_error = UNI_STATE_IN_ERROR;
-    if (0 != g_change_send_no_view)
-      g_uni_state = UNI_STATE_WAIT_CMD;  // show error status and scan next cmd
-    else
-      g_uni_state = UNI_STATE_SHOW_STAT; // show error status and allow abort
+  g_perf_send_cb_num += 1; // only written here
+#if UNI_TRACE
+  uni_trace_put(&g_trace_cb, UNI_TRACE_ID_SEND_CB, UNI_TRACE_PH_INSTANT, (uint32_t) usec_cb, 0, (uint16_t) status);
+#endif // UNI_TRACE
+
+  // find the message in flight to this destination; there is at most one
+  //   don't call lvgl routines at callback level; that may contribute to LVGL timeout crashing
+  //   loop() calls uni_in_flight_report() to report it and change state
+  for (int16_t i = 0; i < UNI_IN_FLIGHT_NUM; i++) {
+    uni_in_flight_t * msg_ptr = &g_in_flight[i];
+    if ((0 != msg_ptr->in_use) && (0 == msg_ptr->done) && (0 == memcmp(msg_ptr->mac_addr, mac_addr, ESP_NOW_ETH_ALEN))) {
+      msg_ptr->timing.usec_cb = usec_cb;
+      msg_ptr->status = (uni_esp_now_status_t)status;
+      msg_ptr->done = 1; // last
+      return;
+    }
   }
+  g_in_flight_unmatched_num += 1; // should not happen
 } // end uni_esp_now_cmd_send_callback()
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_channel_nvs_key() - NVS key for the WiFi channel of p_mac_addr
+//       returns: nothing
+//
+// p_key must hold 15 chars; NVS keys are at most 15 chars
+//
+void uni_channel_nvs_key(const uint8_t * p_mac_addr, char * p_key) {
+  sprintf(p_key, "ch%02x%02x%02x%02x%02x%02x", p_mac_addr[0], p_mac_addr[1], p_mac_addr[2], p_mac_addr[3], p_mac_addr[4], p_mac_addr[5]);
+} // end uni_channel_nvs_key()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_channel_recall() - WiFi channel of p_mac_addr remembered in NVS
+//       returns: channel, or 0 if not known
+//
+uint8_t uni_channel_recall(const uint8_t * p_mac_addr) {
+#if UNI_CHANNEL_PROBE
+  char key[16];
+  uni_channel_nvs_key(p_mac_addr, key);
+  uint8_t channel = g_nvs.getUChar(key, 0);
+  return((channel <= UNI_CHANNEL_MAX) ? channel : 0);
+#else  // use whatever channel we are on
+  return(0);
+#endif // UNI_CHANNEL_PROBE
+} // end uni_channel_recall()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_channel_set() - move our radio to WiFi channel p_channel
+//       returns: nothing
+//
+// we are not connected to a router, so we can go to any channel
+// only call when no message is in flight; it could go out on the wrong channel
+//
+void uni_channel_set(uint8_t p_channel) {
+  if (p_channel == g_channel_now) return;
+  esp_wifi_set_channel(p_channel, WIFI_SECOND_CHAN_NONE);
+  g_channel_now = p_channel;
+} // end uni_channel_set()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_channel_set_peer() - register the ESP-NOW peer p_mac_addr on WiFi channel p_channel
+//       returns: nothing
+//
+void uni_channel_set_peer(const uint8_t * p_mac_addr, uint8_t p_channel) {
+  memcpy(rcvr_peer_info.peer_addr, p_mac_addr, ESP_NOW_ETH_ALEN);
+  rcvr_peer_info.channel = p_channel;
+  rcvr_peer_info.encrypt = false;
+  esp_now_mod_peer(&rcvr_peer_info);
+} // end uni_channel_set_peer()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_channel_remember() - peer p_peer_idx is on WiFi channel p_channel; keep it in RAM and NVS
+//       returns: nothing
+//
+// NVS is only written if the channel changed
+//
+void uni_channel_remember(int16_t p_peer_idx, uint8_t p_channel) {
+  g_rcvr_channel[p_peer_idx] = p_channel;
+#if UNI_CHANNEL_PROBE
+  char key[16];
+  uni_channel_nvs_key(&g_rcvr_mac_addr[p_peer_idx*ESP_NOW_ETH_ALEN], key);
+  if (p_channel != g_nvs.getUChar(key, 0)) g_nvs.putUChar(key, p_channel);
+#endif // UNI_CHANNEL_PROBE
+} // end uni_channel_remember()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_channel_probe() - find the WiFi channel of peer p_peer_idx
+//       returns: channel, or 0 if it did not answer on any channel
+//
+// sends a channel probe (see UniRemoteFrames.h) on one channel after another until the send callback
+//    says the MAC layer got an ACK. Tries the channel we are on first, then the usual router
+//    channels 1, 6 and 11, then the rest. On success we are left on the receiver's channel
+//    and the peer is registered on it; otherwise we go back to the channel we were on.
+// waits for each send callback here (at most UNI_CHANNEL_PROBE_MSEC); an answer on the first
+//    try takes a couple of millisec, all 13 channels with no answer well under a second
+// only call when no message is in flight
+//
+uint8_t uni_channel_probe(int16_t p_peer_idx) {
+  UNI_STALL_SCOPE(g_stall_probe);
+  static const uint8_t channel_order[] = { 1, 6, 11, 2, 3, 4, 5, 7, 8, 9, 10, 12, 13 };
+  static uint8_t frame[1+sizeof(uni_frame_probe_t)];
+  const uint8_t * mac_addr = &g_rcvr_mac_addr[p_peer_idx*ESP_NOW_ETH_ALEN];
+  uni_frame_probe_t probe;
+  uint8_t channel_prev = g_channel_now;
+  uint8_t channel_found = 0;
+  uint8_t probe_num = 0;
+  uint32_t msec_start = millis();
+
+  for (int16_t i = -1; (i < (int16_t) sizeof(channel_order)) && (0 == channel_found); i++) {
+    uint8_t channel = (i < 0) ? channel_prev : channel_order[i];
+    if ((i >= 0) && (channel == channel_prev)) continue; // already tried it first
+    if ((channel < 1) || (channel > UNI_CHANNEL_MAX)) continue;
+    uni_channel_set(channel);
+    uni_channel_set_peer(mac_addr, channel);
+
+    int16_t in_flight_idx = uni_in_flight_add(mac_addr, UNI_IN_FLIGHT_KIND_PROBE, p_peer_idx);
+    if (in_flight_idx < 0) break; // should not happen; nothing is in flight
+    probe.seq = ++g_probe_seq;
+    probe.channel = channel;
+    uint16_t frame_len = uni_frame_make_probe(frame, sizeof(frame), &probe);
+    if (ESP_OK != esp_now_send(mac_addr, frame, frame_len)) {
+      uni_in_flight_free(in_flight_idx); // no callback coming
+      continue;
+    }
+    probe_num += 1;
+    uint32_t msec_sent = millis();
+    while ((0 == g_in_flight[in_flight_idx].done) && ((millis() - msec_sent) < UNI_CHANNEL_PROBE_MSEC)) {
+      delay(1);
+    }
+    if (0 == g_in_flight[in_flight_idx].done) break; // leave it for uni_in_flight_report(); can't change channel now
+    if (ESP_NOW_SEND_SUCCESS == g_in_flight[in_flight_idx].status) channel_found = channel;
+    uni_in_flight_free(in_flight_idx);
+  } // end for each channel
+
+  if (0 == channel_found) {
+    if (0 == uni_in_flight_num()) uni_channel_set(channel_prev);
+    uni_channel_set_peer(mac_addr, 0); // whatever channel we are on
+  }
+  DBG_SERIALPRINT("CHANNEL probe peer "); DBG_SERIALPRINT(p_peer_idx);
+  DBG_SERIALPRINT(" found channel ");     DBG_SERIALPRINT(channel_found);
+  DBG_SERIALPRINT(" probes ");            DBG_SERIALPRINT(probe_num);
+  DBG_SERIALPRINT(" msec ");              DBG_SERIALPRINTLN(millis() - msec_start);
+  return(channel_found);
+} // end uni_channel_probe()
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 // uni_esp_now_register_peer() - 
 //       returns: index to peer or -1 for failure
@@ -1004,8 +2384,9 @@ int16_t uni_esp_now_register_peer(uint8_t * mac_addr) {
     reg_index = g_rcvr_peer_num;
     memcpy(&g_rcvr_mac_addr[g_rcvr_peer_num*ESP_NOW_ETH_ALEN], mac_addr, ESP_NOW_ETH_ALEN);
     g_rcvr_peer_num += 1;
+    g_rcvr_channel[reg_index] = uni_channel_recall(mac_addr); // 0 if never found; probe before first send
     memcpy(rcvr_peer_info.peer_addr, mac_addr, ESP_NOW_ETH_ALEN);
-    rcvr_peer_info.channel = 0;  
+    rcvr_peer_info.channel = g_rcvr_channel[reg_index]; // 0 means whatever channel we are on
     rcvr_peer_info.encrypt = false;
     // Add peer
     reg_status = esp_now_add_peer(&rcvr_peer_info);
@@ -1017,6 +2398,78 @@ int16_t uni_esp_now_register_peer(uint8_t * mac_addr) {
   return(reg_index);
 } // end uni_esp_now_register_peer()
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_peers_note_used() - move a receiver that answered a command to the front of the recently used list
+//       returns: nothing
+//
+// called from the in-flight report; it only changes the list in RAM. uni_peers_save() writes it to NVS
+//    later, so a command never waits for a flash write even when the front of the list changes
+//
+void uni_peers_note_used(const uint8_t * p_mac_addr) {
+#if UNI_PEERS_PREWARM
+  uint16_t idx;
+
+  if (0 == memcmp(p_mac_addr, g_broadcast_mac_addr, ESP_NOW_ETH_ALEN)) return; // always registered
+  if ((0 != g_peers_mru_num) && (0 == memcmp(p_mac_addr, g_peers_mru, ESP_NOW_ETH_ALEN))) return; // already first
+  for (idx = 0; idx < g_peers_mru_num; idx++) {
+    if (0 == memcmp(p_mac_addr, &g_peers_mru[idx*ESP_NOW_ETH_ALEN], ESP_NOW_ETH_ALEN)) break;
+  }
+  if (idx >= UNI_PEERS_PREWARM_NUM) idx = UNI_PEERS_PREWARM_NUM-1; // not in the list and list full; last one drops off
+  else if (idx >= g_peers_mru_num) g_peers_mru_num += 1;          // not in the list; list grows
+  memmove(&g_peers_mru[ESP_NOW_ETH_ALEN], g_peers_mru, idx*ESP_NOW_ETH_ALEN);
+  memcpy(g_peers_mru, p_mac_addr, ESP_NOW_ETH_ALEN);
+  g_peers_mru_dirty = 1;
+#endif // UNI_PEERS_PREWARM
+} // end uni_peers_note_used()
+
+#if UNI_PEERS_PREWARM
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_peers_save() - write the recently used list to NVS if it changed
+//       returns: nothing
+//
+// a periodic job every UNI_PEERS_SAVE_MSEC (see setup()); alternating between two receivers writes
+//    at most once per period instead of once per command. Not while a message is in flight; then it
+//    tries again CYDsampleDelayMsec later.
+//
+void uni_peers_save(uint32_t p_msec_now) {
+  if (0 == g_peers_mru_dirty) return;
+  if ((UNI_STATE_SENDING_CMD == g_uni_state) || (UNI_STATE_WAIT_CB == g_uni_state) || (0 != uni_in_flight_num())) {
+    uni_timer_start(g_timer_id_peers_save, CYDsampleDelayMsec);
+    return;
+  }
+  g_nvs.putBytes(UNI_PEERS_NVS_KEY, g_peers_mru, g_peers_mru_num*ESP_NOW_ETH_ALEN);
+  g_peers_mru_dirty = 0;
+} // end uni_peers_save()
+#endif // UNI_PEERS_PREWARM
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_peers_prewarm() - register the recently used receivers from NVS
+//       returns: nothing
+//
+// called from setup() so the first command to each of them does not wait for esp_now_add_peer();
+//    uni_esp_now_register_peer() also recalls each one's WiFi channel, so no probe is needed either
+// prints how long it took on Serial
+//
+void uni_peers_prewarm() {
+#if UNI_PEERS_PREWARM
+  int64_t usec_start = esp_timer_get_time();
+  uint16_t reg_num = 0;
+
+  size_t len = g_nvs.getBytes(UNI_PEERS_NVS_KEY, g_peers_mru, sizeof(g_peers_mru));
+  g_peers_mru_num = len / ESP_NOW_ETH_ALEN;
+  for (uint16_t i = 0; i < g_peers_mru_num; i++) {
+    if (uni_esp_now_register_peer(&g_peers_mru[i*ESP_NOW_ETH_ALEN]) >= 0) reg_num += 1;
+  }
+  uint32_t usec_took = (uint32_t) (esp_timer_get_time() - usec_start);
+
+  DBG_SERIALPRINT("BOOT prewarm registered "); DBG_SERIALPRINT(reg_num);
+  DBG_SERIALPRINT(" of ");                     DBG_SERIALPRINT(g_peers_mru_num);
+  DBG_SERIALPRINT(" peers in usec ");          DBG_SERIALPRINT(usec_took);
+  DBG_SERIALPRINT(" (per peer ");              DBG_SERIALPRINT((0 == reg_num) ? 0 : usec_took / reg_num);
+  DBG_SERIALPRINTLN(")");
+#endif // UNI_PEERS_PREWARM
+} // end uni_peers_prewarm()
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 // uni_esp_now_cmd_parse() - decipher PICC or QR code and register the MAC address
 //       returns: status from call
@@ -1031,25 +2484,27 @@ int16_t uni_esp_now_register_peer(uint8_t * mac_addr) {
 static uint8_t * g_esp_now_mac_addr_ptr;
 esp_err_t uni_esp_now_cmd_parse(char * p_cmd) {
   memset(g_cmd_in_proc_or_prev, '\0', sizeof(g_cmd_in_proc_or_prev));
+  g_cmd_in_proc_or_prev_num += 1;
 
   // see if we can obtain and register the MAC address for sending
   g_esp_now_mac_addr_ptr = uni_cmd_decode_get_mac_addr(p_cmd);
   int16_t mac_addr_index;
   if ((uint8_t *)0 != g_esp_now_mac_addr_ptr) {
-    mac_addr_index = uni_esp_now_register_peer(g_esp_now_mac_addr_ptr); // sets g_msg_last_esp_now_result_status
+    mac_addr_index = uni_esp_now_register_peer(g_esp_now_mac_addr_ptr);
   } else {
-  sprintf(g_msg_last_esp_now_result_status, "ERROR: CMD #%d bad MAC address", g_last_scanned_cmd_count);
-    DBG_SERIALPRINTLN(g_msg_last_esp_now_result_status);
+    uni_status_note(UNI_STATUS_BAD_ADDR, g_last_scanned_cmd_count, 0, 0);
+    DBG_SERIALPRINTLN(uni_status_text(UNI_STATUS_RESULT));
     return(UNI_ERR_CMD_DECODE_FAIL); // could not decode MAC from CMD
   }
+  g_esp_now_peer_idx = mac_addr_index;
   if (mac_addr_index < 0) {
-  sprintf(g_msg_last_esp_now_result_status, "ERROR: CMD #%d ESP-NOW reg/add peer failed", g_last_scanned_cmd_count);
-    DBG_SERIALPRINTLN(g_msg_last_esp_now_result_status);
+    uni_status_note(UNI_STATUS_PEER_FAIL, g_last_scanned_cmd_count, 0, 0);
+    DBG_SERIALPRINTLN(uni_status_text(UNI_STATUS_RESULT));
     return(ESP_ERR_ESPNOW_FULL); // could not register the MAC address
   }
 
-  // copy message over starting after the MAC address
-  strncpy(g_cmd_in_proc_or_prev, &p_cmd[3*ESP_NOW_ETH_ALEN], ESP_NOW_MAX_DATA_LEN-1); // max ESP-NOW msg size
+  // copy message over starting after the MAC address and the optional "execute at" lead time
+  strncpy(g_cmd_in_proc_or_prev, &p_cmd[uni_cmd_decode_exec_lead(p_cmd)], ESP_NOW_MAX_DATA_LEN-1); // max ESP-NOW msg size
   return(ESP_OK);
 } // end uni_esp_now_cmd_parse()
 
@@ -1062,26 +2517,143 @@ esp_err_t uni_esp_now_cmd_parse(char * p_cmd) {
 //   g_cmd_in_proc_or_prev is filled with the message to send up to length ESP_NOW_MAX_DATA_LEN (zero length if parse error)
 //   g_esp_now_mac_addr_ptr will point to the  MAC address of the target ##:##:##:##:##
 //
+// on exit with ESP_OK:
+//   g_in_flight_idx_cmd is the g_in_flight[] entry for the command; uni_in_flight_report() reports its outcome
+// returns UNI_ERR_DEST_BUSY if the previous message to this receiver is still in flight; try again later
+//
 esp_err_t uni_esp_now_cmd_send() {
   esp_err_t send_status = ESP_OK;
-  static uint32_t msec_prev_send = 0;
+  static uint8_t frame[ESP_NOW_MAX_DATA_LEN]; // command, zero termination, optional trailer
   uint32_t msec_now = millis();
 
   // if the message length is zero then the decode failed
   int len = strlen(g_cmd_in_proc_or_prev);
   if (0 == len) { return(UNI_ERR_CMD_DECODE_FAIL); }
 
-  // see if waited long enough to send another ESP-NOW message
-  if (msec_now < (UNI_ESP_NOW_MSEC_PER_MSG_MIN+msec_prev_send)) {
+  // see if waited long enough to send another ESP-NOW message to this receiver
+  //   messages to different receivers need not wait for each other
+  if ((g_esp_now_peer_idx >= 0) && (0 != g_rcvr_msec_prev_send[g_esp_now_peer_idx]) &&
+      ((msec_now - g_rcvr_msec_prev_send[g_esp_now_peer_idx]) < UNI_ESP_NOW_MSEC_PER_MSG_MIN)) {
     DBG_SERIALPRINTLN("ERROR: too soon to send");
     return(UNI_ERR_TOO_SOON); // too soon to send another message
   }
-  msec_prev_send = msec_now;
 
-  send_status = esp_now_send(g_esp_now_mac_addr_ptr, (uint8_t *) g_cmd_in_proc_or_prev, len+1);
+#if UNI_CHANNEL_PROBE
+  // go to the receiver's WiFi channel, finding it first if we don't know it (broadcast goes where we are)
+  //   never change channel with a message in flight; it could go out on the wrong channel
+  if ((g_esp_now_peer_idx >= 0) && (0 != memcmp(g_esp_now_mac_addr_ptr, g_broadcast_mac_addr, ESP_NOW_ETH_ALEN)) &&
+      (g_rcvr_channel[g_esp_now_peer_idx] != g_channel_now)) {
+    if (0 != uni_in_flight_num()) { return(UNI_ERR_DEST_BUSY); }
+    if (0 == g_rcvr_channel[g_esp_now_peer_idx]) {
+      uint8_t channel = uni_channel_probe(g_esp_now_peer_idx);
+      if (0 == channel) { return(UNI_ERR_NO_CHANNEL); }
+      uni_channel_remember(g_esp_now_peer_idx, channel);
+    } else {
+      uni_channel_set(g_rcvr_channel[g_esp_now_peer_idx]);
+    }
+  }
+#endif // UNI_CHANNEL_PROBE
+  UNI_STALL_SCOPE(g_stall_send); // after the probe; it has its own section and budget
+
+  // one message in flight to each receiver
+  int16_t in_flight_idx = uni_in_flight_add(g_esp_now_mac_addr_ptr, UNI_IN_FLIGHT_KIND_CMD, g_esp_now_peer_idx);
+  if (in_flight_idx < 0) { return(UNI_ERR_DEST_BUSY); }
+  uni_in_flight_t * msg_ptr = &g_in_flight[in_flight_idx];
+  if (g_esp_now_peer_idx >= 0) g_rcvr_msec_prev_send[g_esp_now_peer_idx] = msec_now;
+
+  // command and zero termination first so receivers that do not know about the trailer just see the command
+  uint16_t frame_len = len+1;
+  memcpy(frame, g_cmd_in_proc_or_prev, frame_len);
+#if UNI_SEND_TIMING_TRAILER
+  uni_frame_timing_t trailer;
+  trailer.seq = msg_ptr->seq;
+  trailer.usec_scan = (uint32_t) (g_cmd_timing.usec_scan_done - g_cmd_timing.usec_scan_start);
+  trailer.usec_parse = (uint32_t) (g_cmd_timing.usec_parse_done - g_cmd_timing.usec_scan_done);
+  trailer.usec_air_min = (g_esp_now_peer_idx >= 0) ? g_rcvr_usec_air_min[g_esp_now_peer_idx] : 0;
+  g_cmd_timing.usec_sent = trailer.usec_sent = esp_timer_get_time();
+  trailer.usec_queue = (uint32_t) (g_cmd_timing.usec_sent - g_cmd_timing.usec_parse_done);
+  frame_len = uni_frame_append_timing(frame, frame_len, sizeof(frame), &trailer);
+#else  // no timing trailer
+  g_cmd_timing.usec_sent = esp_timer_get_time();
+#endif // UNI_SEND_TIMING_TRAILER
+  if (0 != g_cmd_exec_lead_msec) {
+    uni_frame_exec_at_t exec_at;
+    exec_at.usec_exec_at = g_cmd_timing.usec_sent + (int64_t) g_cmd_exec_lead_msec * 1000;
+    frame_len = uni_frame_append_exec_at(frame, frame_len, sizeof(frame), &exec_at);
+  }
+
+  msg_ptr->timing = g_cmd_timing; // before esp_now_send(); send callback fills in usec_cb
+  g_in_flight_idx_cmd = in_flight_idx;
+  if (g_esp_now_peer_idx >= 0) uni_link_apply_rate(g_esp_now_mac_addr_ptr, g_rcvr_link[g_esp_now_peer_idx].rate_idx);
+  send_status = esp_now_send(g_esp_now_mac_addr_ptr, frame, frame_len);
+  if (ESP_OK != send_status) {
+    uni_in_flight_free(in_flight_idx); // no callback coming
+  }
   return (send_status);
 } // end uni_esp_now_cmd_send()
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_time_beacon_send() - broadcast a time beacon
+//       returns: nothing
+//
+// a periodic job every UNI_SEND_TIME_BEACON_MSEC (see uni_timer_add() in setup())
+// receivers use the beacons to keep track of our esp_timer_get_time() clock so they can all
+//    execute a command at the same "execute at" time (see uni_cmd_decode_exec_lead())
+// the beacon goes in g_in_flight[] under the broadcast MAC address; while the broadcast address
+//    is busy it tries again CYDsampleDelayMsec later
+//
+void uni_time_beacon_send(uint32_t p_msec_now) {
+  static uint8_t frame[1+sizeof(uni_frame_beacon_t)];
+  uni_frame_beacon_t beacon;
+
+  int16_t in_flight_idx = uni_in_flight_add(g_broadcast_mac_addr, UNI_IN_FLIGHT_KIND_BEACON, -1);
+  if (in_flight_idx < 0) { // previous beacon (or request to announce) still in flight
+    uni_timer_start(g_timer_id_beacon, CYDsampleDelayMsec);
+    return;
+  }
+
+  // smallest air time to any receiver; receivers use half of it to get closer to the true offset
+  beacon.usec_air_min = 0;
+  for (uint8_t i = 0; i < g_rcvr_peer_num; i++) {
+    if (0 == memcmp(&g_rcvr_mac_addr[i*ESP_NOW_ETH_ALEN], g_broadcast_mac_addr, ESP_NOW_ETH_ALEN)) continue; // no ACK for broadcast
+    if ((0 != g_rcvr_usec_air_min[i]) && ((0 == beacon.usec_air_min) || (g_rcvr_usec_air_min[i] < beacon.usec_air_min))) {
+      beacon.usec_air_min = g_rcvr_usec_air_min[i];
+    }
+  }
+  beacon.seq = ++g_beacon_seq;
+  beacon.msec_period = UNI_SEND_TIME_BEACON_MSEC;
+  uni_link_apply_rate(g_broadcast_mac_addr, 0); // slowest rate so every receiver hears it
+  beacon.usec_sent = esp_timer_get_time();
+  uint16_t frame_len = uni_frame_make_beacon(frame, sizeof(frame), &beacon);
+  if (ESP_OK != esp_now_send(g_broadcast_mac_addr, frame, frame_len)) {
+    uni_in_flight_free(in_flight_idx); // no callback coming
+  }
+} // end uni_time_beacon_send()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_announce_req_send() - broadcast a request to announce if one is wanted
+//       returns: nothing
+//
+// wanted at boot and when a card has an alias not in the directory (see uni_cmd_decode_get_mac_addr())
+// the request goes in g_in_flight[] under the broadcast MAC address; waits while a beacon is in flight
+//
+void uni_announce_req_send() {
+  static uint8_t frame[1+sizeof(uni_frame_announce_req_t)];
+  uni_frame_announce_req_t req;
+
+  if ((0 == UNI_RCVR_DIRECTORY) || (0 == g_announce_req_pending)) return;
+  int16_t in_flight_idx = uni_in_flight_add(g_broadcast_mac_addr, UNI_IN_FLIGHT_KIND_ANNOUNCE_REQ, -1);
+  if (in_flight_idx < 0) return; // broadcast busy; try next time
+  g_announce_req_pending = 0;
+
+  req.seq = ++g_announce_req_seq;
+  uni_link_apply_rate(g_broadcast_mac_addr, 0); // slowest rate so every receiver hears it
+  uint16_t frame_len = uni_frame_make_announce_req(frame, sizeof(frame), &req);
+  if (ESP_OK != esp_now_send(g_broadcast_mac_addr, frame, frame_len)) {
+    uni_in_flight_free(in_flight_idx); // no callback coming
+  }
+} // end uni_announce_req_send()
+
 #if INCLUDE_RFID_SENSOR
 // uni_read_picc(char my_picc_read[]) - get next PICC command
 //   PICC = Proximity Integrated Circuit Card (Contactless Card) - the RFID card we are reading
@@ -1099,8 +2671,12 @@ esp_err_t uni_esp_now_cmd_send() {
 // command would be copied into g_cmd_queue[UNI_CMD_QNUM_NOW]
 //
 uint16_t uni_get_command(uint32_t p_msec_now) {
+  UNI_STALL_SCOPE(g_stall_scan);
+#if UNI_TRACE
+  UNI_TRACE_SCOPE(g_trace_loop, UNI_TRACE_ID_SCAN);
+#endif // UNI_TRACE
+  int64_t usec_start = esp_timer_get_time(); // for g_perf_scan
   static uint8_t first_time = 0;      // 0 on first time through uni_get_command()
-  static uint32_t next_rfid_msec = 0; // p_msec_now must be >= this to do another RFID action
   uint16_t the_status;
 
 
@@ -1108,13 +2684,14 @@ uint16_t uni_get_command(uint32_t p_msec_now) {
 
 #if INCLUDE_RFID_SENSOR
   if (0 == first_time) { DBG_SERIALPRINTLN("first_time RFID PICC code"); }
-  if ((0 == num_cmds_scanned) && (next_rfid_msec <= p_msec_now)) {
+  if (0 == num_cmds_scanned) {
     // try RFID scanner
+    g_cmd_timing.usec_scan_start = esp_timer_get_time();
     if (0 == (the_status = uni_read_picc(g_cmd_queue[UNI_CMD_QNUM_NOW].scanned_cmd))) {
+      g_cmd_timing.usec_scan_done = esp_timer_get_time();
       DBG_SERIALPRINTLN("Doing RFID PICC Cmd");
       num_cmds_scanned = 1;
       g_last_scanned_cmd_count += 1;
-      g_uni_state_times[g_uni_state] = p_msec_now;
       g_cmd_queue[UNI_CMD_QNUM_NOW].scanned_cmd_len = strlen(g_cmd_queue[UNI_CMD_QNUM_NOW].scanned_cmd);
       sprintf(g_msg, "RFID PICC CMD #%d scanned:\n %s", g_last_scanned_cmd_count, g_cmd_queue[UNI_CMD_QNUM_NOW].scanned_cmd);
       g_cmd_scanned_by = UNI_CMD_SCANNED_BY_PICC;
@@ -1126,13 +2703,14 @@ uint16_t uni_get_command(uint32_t p_msec_now) {
   if (0 == first_time) { DBG_SERIALPRINTLN("first_time QR code"); }
   if (0 == num_cmds_scanned) {
     // try QR code reader
+    g_cmd_timing.usec_scan_start = esp_timer_get_time();
     if (!tiny_code_reader_read(&QRresults)) { // Perform a read action on the I2C address of the sensor
-      lv_label_set_text(g_styled_label_last_status.label_text, "I2C bus QR code sensor no response");
+      uni_lv_last_status_text_style("I2C bus QR code sensor no response");
     } else if (QRresults.content_length > 0) {
+      g_cmd_timing.usec_scan_done = esp_timer_get_time();
       DBG_SERIALPRINTLN("Doing QR Code");
       num_cmds_scanned = 1;
       g_last_scanned_cmd_count += 1;
-      g_uni_state_times[g_uni_state] = p_msec_now;
       strncpy(g_cmd_queue[UNI_CMD_QNUM_NOW].scanned_cmd, (char *)QRresults.content_bytes, sizeof(g_cmd_queue[0].scanned_cmd));
       g_cmd_queue[UNI_CMD_QNUM_NOW].scanned_cmd_len = strlen(g_cmd_queue[UNI_CMD_QNUM_NOW].scanned_cmd);
       sprintf(g_msg, "QR CMD #%d scanned:\n %s", g_last_scanned_cmd_count, g_cmd_queue[UNI_CMD_QNUM_NOW].scanned_cmd);
@@ -1144,6 +2722,7 @@ uint16_t uni_get_command(uint32_t p_msec_now) {
 
   if (0 != num_cmds_scanned) {
     uni_esp_now_cmd_parse(g_cmd_queue[UNI_CMD_QNUM_NOW].scanned_cmd);
+    g_cmd_timing.usec_parse_done = esp_timer_get_time();
     // Show new status and change state
     uni_lv_last_status_text_style(g_msg);
     if (0 == g_change_send_no_view) {
@@ -1156,6 +2735,9 @@ uint16_t uni_get_command(uint32_t p_msec_now) {
   }
 
   first_time = 1;
+#if UNI_PERF
+  uni_perf_hist_add(&g_perf_scan, uni_perf_usec(usec_start, esp_timer_get_time()));
+#endif // UNI_PERF
   return(num_cmds_scanned);
 } // end uni_get_command()
 
@@ -1166,6 +2748,140 @@ static uint32_t uni_tick(void)
     return millis();
 } // end uni_tick()
 
+#if USE_DISPLAY_DMA
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_display_dma_flush() - LVGL flush callback; sends one stripe by SPI DMA
+//       returns: nothing
+//
+// Waits for the previous stripe to finish, starts this one and tells LVGL it is done right away.
+//    LVGL then renders the next stripe into the other buffer while this one goes out. This buffer
+//    is not rendered into again until after the next flush, which waits for this DMA first.
+//
+void uni_display_dma_flush(lv_display_t * p_disp, const lv_area_t * p_area, uint8_t * p_px_map) {
+  g_tft.dmaWait(); // previous stripe done
+  g_tft.pushImageDMA(p_area->x1, p_area->y1, lv_area_get_width(p_area), lv_area_get_height(p_area), (uint16_t *) p_px_map);
+  lv_display_flush_ready(p_disp);
+} // end uni_display_dma_flush()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_display_dma_rotation() - LV_EVENT_RESOLUTION_CHANGED; turn the TFT to match lv_display_set_rotation()
+//       returns: nothing
+//
+void uni_display_dma_rotation(lv_event_t * p_event) {
+  lv_display_t * disp = (lv_display_t *) lv_event_get_current_target(p_event);
+  g_tft.dmaWait(); // do not change rotation under a stripe going out
+  g_tft.setRotation((uint8_t) lv_display_get_rotation(disp)); // LV_DISPLAY_ROTATION_0..270 match TFT_eSPI 0..3
+} // end uni_display_dma_rotation()
+#endif // USE_DISPLAY_DMA
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_display_create() - create the LVGL display
+//       returns: the display
+//
+// USE_DISPLAY_DMA: two DMA-capable draw buffers and uni_display_dma_flush();
+//    if the buffers cannot be allocated it falls back to lv_tft_espi_create() with one malloc() buffer
+// not USE_DISPLAY_DMA: lv_tft_espi_create() with the static draw_buf
+//
+lv_display_t * uni_display_create() {
+  lv_display_t * disp = (lv_display_t *) 0;
+
+#if USE_DISPLAY_DMA
+  g_draw_buf_dma[0] = (uint8_t *) heap_caps_malloc(DRAW_BUF_SIZE, MALLOC_CAP_DMA);
+  g_draw_buf_dma[1] = (uint8_t *) heap_caps_malloc(DRAW_BUF_SIZE, MALLOC_CAP_DMA);
+  if (((uint8_t *) 0 != g_draw_buf_dma[0]) && ((uint8_t *) 0 != g_draw_buf_dma[1])) {
+    g_tft.begin();
+    g_tft.initDMA();
+    g_tft.setSwapBytes(true); // LVGL RGB565 is little-endian, the display wants big-endian
+    g_tft.startWrite();       // the display has the HSPI bus to itself; keep it for DMA
+    disp = lv_display_create(SCREEN_WIDTH, SCREEN_HEIGHT);
+    lv_display_set_flush_cb(disp, uni_display_dma_flush);
+    lv_display_set_buffers(disp, g_draw_buf_dma[0], g_draw_buf_dma[1], DRAW_BUF_SIZE, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_add_event_cb(disp, uni_display_dma_rotation, LV_EVENT_RESOLUTION_CHANGED, NULL);
+    DBG_SERIALPRINTLN("Display: two DMA draw buffers");
+  } else {
+    heap_caps_free(g_draw_buf_dma[0]);
+    heap_caps_free(g_draw_buf_dma[1]);
+    g_draw_buf_dma[0] = g_draw_buf_dma[1] = (uint8_t *) 0;
+    DBG_SERIALPRINTLN("ERROR: no DMA memory for display buffers; using one buffer without DMA");
+    g_draw_buf_one = (uint8_t *) malloc(DRAW_BUF_SIZE);
+    if ((uint8_t *) 0 == g_draw_buf_one) {
+      DBG_SERIALPRINTLN("ERROR: no memory for the display buffer");
+    }
+    // Initialize the TFT display using the TFT_eSPI library
+    disp = lv_tft_espi_create(SCREEN_WIDTH, SCREEN_HEIGHT, g_draw_buf_one, DRAW_BUF_SIZE);
+  }
+#else  // not USE_DISPLAY_DMA
+  // Initialize the TFT display using the TFT_eSPI library
+  disp = lv_tft_espi_create(SCREEN_WIDTH, SCREEN_HEIGHT, draw_buf, sizeof(draw_buf));
+#endif // USE_DISPLAY_DMA
+
+#if UNI_DISPLAY_TIMING_MSEC
+  lv_display_add_event_cb(disp, uni_display_timing_event, LV_EVENT_ALL, NULL);
+  uni_timer_add(uni_display_timing_report, UNI_DISPLAY_TIMING_MSEC, UNI_DISPLAY_TIMING_MSEC, 1);
+#endif // UNI_DISPLAY_TIMING_MSEC
+  return(disp);
+} // end uni_display_create()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_display_timing_event() - LVGL display events; times each refresh and each flush
+//       returns: nothing
+//
+// a refresh is from LV_EVENT_REFR_START to LV_EVENT_REFR_READY: rendering all the stripes plus flushing them
+// a flush is from LV_EVENT_FLUSH_START to LV_EVENT_FLUSH_FINISH: the time LVGL is stuck in the flush callback
+//    without DMA that is the whole SPI transfer; with DMA it is only the wait for the previous stripe
+//
+void uni_display_timing_event(lv_event_t * p_event) {
+  int64_t usec_now = esp_timer_get_time();
+  uni_display_timing_t * timing_ptr = &g_display_timing;
+
+  switch (lv_event_get_code(p_event)) {
+    case LV_EVENT_REFR_START:
+      timing_ptr->usec_refr_start = usec_now;
+      break;
+    case LV_EVENT_REFR_READY:
+      if (0 != timing_ptr->usec_refr_start) {
+        uint32_t usec_frame = (uint32_t) (usec_now - timing_ptr->usec_refr_start);
+        timing_ptr->frame_num += 1;
+        timing_ptr->usec_frame_sum += usec_frame;
+        if (usec_frame > timing_ptr->usec_frame_max) timing_ptr->usec_frame_max = usec_frame;
+        timing_ptr->usec_refr_start = 0;
+      }
+      break;
+    case LV_EVENT_FLUSH_START:
+      timing_ptr->usec_flush_start = usec_now;
+      break;
+    case LV_EVENT_FLUSH_FINISH:
+      if (0 != timing_ptr->usec_flush_start) {
+        timing_ptr->flush_num += 1;
+        timing_ptr->usec_flush_sum += (uint64_t) (usec_now - timing_ptr->usec_flush_start);
+        timing_ptr->usec_flush_start = 0;
+      }
+      break;
+    default:
+      break;
+  }
+} // end uni_display_timing_event()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_display_timing_report() - print frame and flush times on Serial and start over
+//       returns: nothing
+//
+// a periodic job every UNI_DISPLAY_TIMING_MSEC (see uni_display_create())
+// compare a run with USE_DISPLAY_DMA 0 and 1 on the same screens; frame usec is what DMA should cut
+//
+void uni_display_timing_report(uint32_t p_msec_now) {
+  uni_display_timing_t * timing_ptr = &g_display_timing;
+  uint32_t frame_num = timing_ptr->frame_num;
+
+  DBG_SERIALPRINT("DISPLAY dma ");          DBG_SERIALPRINT(USE_DISPLAY_DMA);
+  DBG_SERIALPRINT(" frames ");              DBG_SERIALPRINT(frame_num);
+  DBG_SERIALPRINT(" avg frame usec ");      DBG_SERIALPRINT((0 == frame_num) ? 0 : (uint32_t) (timing_ptr->usec_frame_sum / frame_num));
+  DBG_SERIALPRINT(" max frame usec ");      DBG_SERIALPRINT(timing_ptr->usec_frame_max);
+  DBG_SERIALPRINT(" stripes ");             DBG_SERIALPRINT(timing_ptr->flush_num);
+  DBG_SERIALPRINT(" avg flush wait usec "); DBG_SERIALPRINTLN((0 == timing_ptr->flush_num) ? 0 : (uint32_t) (timing_ptr->usec_flush_sum / timing_ptr->flush_num));
+  memset(timing_ptr, 0, sizeof(*timing_ptr));
+} // end uni_display_timing_report()
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 // setup() - initialize hardware and software
 //       returns: nothing
@@ -1197,6 +2913,12 @@ void setup() {
   // Set device as a Wi-Fi Station
   WiFi.mode(WIFI_STA);
 
+  // what we remember across power off: the WiFi channel of each receiver, the touchscreen calibration
+  g_nvs.begin(UNI_NVS_NAMESPACE, false);
+  uni_touch_cal_load();
+  wifi_second_chan_t second_channel;
+  esp_wifi_get_channel(&g_channel_now, &second_channel);
+
   // init ESP-NOW
   esp_err_t status_init_espnow = esp_now_init();
   if (status_init_espnow != ESP_OK) {
@@ -1213,6 +2935,48 @@ void setup() {
     return;
   }
 
+  // time beacons and requests to announce go to the broadcast address
+  if (uni_esp_now_register_peer(g_broadcast_mac_addr) < 0) {
+    DBG_SERIALPRINTLN("ERROR: ESP-NOW register broadcast peer failed");
+  }
+
+  // receivers we used before power off; first command to each is as fast as the rest
+  uni_peers_prewarm();
+#if UNI_PEERS_PREWARM
+  g_timer_id_peers_save = uni_timer_add(uni_peers_save, UNI_PEERS_SAVE_MSEC, UNI_PEERS_SAVE_MSEC, 1);
+#endif // UNI_PEERS_PREWARM
+
+#if UNI_VIEW_REPORT_MSEC
+  // how much LVGL work the view model saves
+  uni_timer_add(uni_view_report, UNI_VIEW_REPORT_MSEC, UNI_VIEW_REPORT_MSEC, 1);
+#endif // UNI_VIEW_REPORT_MSEC
+#if UNI_PERF
+  uni_perf_setup(); // histograms, counters and the "perf" Serial command
+#endif // UNI_PERF
+  uni_serial_cmd_add("stall", uni_stall_cmd, "stall - print each timed section: times, overruns, longest and budget in usec");
+  uni_serial_cmd_add("status", uni_status_cmd, "status - print the last status events: what happened to each command");
+#if UNI_TRACE
+  uni_trace_setup(); // rings, event names and the "trace" Serial command
+#endif // UNI_TRACE
+#if UNI_JOURNAL
+  uni_status_journal_setup(); // status events in flash; the boot record says why we reset
+#endif // UNI_JOURNAL
+
+#if UNI_SEND_TIME_BEACON_MSEC
+  // time beacons are a periodic job run from loop()
+  g_timer_id_beacon = uni_timer_add(uni_time_beacon_send, UNI_SEND_TIME_BEACON_MSEC, UNI_SEND_TIME_BEACON_MSEC, 1);
+#endif // UNI_SEND_TIME_BEACON_MSEC
+
+#if UNI_RCVR_DIRECTORY
+  // listen for receiver announcements and ask everyone to announce
+  esp_err_t status_register_recv_cb = esp_now_register_recv_cb(uni_announce_rcvd_callback);
+  if (status_register_recv_cb != ESP_OK){
+    DBG_SERIALPRINT("ERROR: ESP-NOW register receive callback error ");
+    DBG_SERIALPRINTLN(status_register_recv_cb);
+  }
+  g_announce_req_pending = 1;
+#endif // UNI_RCVR_DIRECTORY
+
 #if INCLUDE_RFID_SENSOR
   // init RFID sensor
   mfrc522.PCD_Init();    // Init MFRC522 board.
@@ -1241,13 +3005,23 @@ void setup() {
 // NOTE WE ARE USING XPT2046_Bitbang INSTEAD OF TFT_eSPI
   // Start the SPI for the touch screen and init the TS library
   ts.begin();
+#if UNI_TOUCH_FILTER
+  // read and filter the touchscreen on a schedule; cyd_input_read() uses the result
+#if UNI_TOUCH_USE_IRQ
+  pinMode(XPT2046_IRQ, INPUT); // GPIO 36 is input only with no internal pullup; set UNI_TOUCH_USE_IRQ 0 if touches are never seen
+#endif // UNI_TOUCH_USE_IRQ
+  uni_timer_add(uni_touch_sample, 0, UNI_TOUCH_SAMPLE_MSEC, 1);
+#if UNI_TOUCH_REPORT_MSEC
+  uni_timer_add(uni_touch_report, UNI_TOUCH_REPORT_MSEC, UNI_TOUCH_REPORT_MSEC, 1);
+#endif // UNI_TOUCH_REPORT_MSEC
+#endif // UNI_TOUCH_FILTER
   //    I have not yet done the experiment of changing rotation with XPT2046_Bitbang
   //ts.setRotation(1);
 
   // Create a display object
   lv_display_t * disp;
-  // Initialize the TFT display using the TFT_eSPI library
-  disp = lv_tft_espi_create(SCREEN_WIDTH, SCREEN_HEIGHT, draw_buf, sizeof(draw_buf));
+  // Initialize the TFT display using the TFT_eSPI library; with DMA if we can (see USE_DISPLAY_DMA)
+  disp = uni_display_create();
   lv_display_set_rotation(disp, LV_DISPLAY_ROTATION_90); // landscape
   
   // Initialize an LVGL input device object (Touchscreen)
@@ -1257,6 +3031,9 @@ void setup() {
 
   // Function to draw the GUI
   lv_create_main_gui();
+
+  // last so setup() itself does not trip the watchdog; prints what stalled before a watchdog reset
+  uni_stall_setup(UNI_STALL_WDT_MSEC);
 } // end setup()
 
 
@@ -1265,36 +3042,63 @@ void setup() {
 //       returns: nothing
 //  if command (QR code or RFID) seen
 //    send to ESP-NOW destination
-//  give a slight delay
+//  report the outcome of each message sent
+//  run the periodic jobs (time beacons)
+//  sleep until the next job or GUI timer is due; only a short time while a message is in progress
 //
 void loop() {
   uint32_t msec_now = millis();
   esp_err_t send_status;
-
+#if UNI_TRACE
+  int64_t usec_send_start; // for the "send" trace event
+#endif // UNI_TRACE
+#if UNI_PERF
+  static int64_t usec_loop_prev = 0;
+  int64_t usec_loop_start = esp_timer_get_time();
+  if (0 != usec_loop_prev) uni_perf_hist_add(&g_perf_loop_period, uni_perf_usec(usec_loop_prev, usec_loop_start));
+  usec_loop_prev = usec_loop_start;
+#endif // UNI_PERF
+
+  uni_serial_cmd_poll();  // commands typed on Serial
+  uni_in_flight_report(); // outcome of each message whose send callback happened; may change state
+#if UNI_TRACE
+  uni_trace_state();
+#endif // UNI_TRACE
+  uni_dir_update();       // receivers that announced themselves
+  uni_announce_req_send(); // if wanted
   if (0 != g_button_press.pressed) { handle_button_press(); }
   else switch (g_uni_state) {
     case UNI_STATE_WAIT_CMD:    // last cmd all done, wait for next cmd
       uni_do_esp_now_callback_status(); // if there is callback status, show it
       if (0 == uni_get_command(msec_now)) {
-        sprintf(g_msg,"No scanned command found, waiting...\n  %s", g_msg_last_esp_now_result_status);
-        uni_lv_last_status_text_style(g_msg);
+        uni_status_show_waiting(); // only made again if something changed
       }
       break;
     case UNI_STATE_CMD_SEEN:   // command in queue, waiting for GO or CLEAR
       break;
     case UNI_STATE_SENDING_CMD: // command being sent (very short state)
+#if UNI_TRACE
+      usec_send_start = esp_timer_get_time();
+#endif // UNI_TRACE
       send_status = uni_esp_now_cmd_send();
+#if UNI_TRACE
+      uni_trace_complete(&g_trace_loop, UNI_TRACE_ID_SEND, usec_send_start, (uint16_t) send_status);
+#endif // UNI_TRACE
+      if (UNI_ERR_DEST_BUSY == send_status) break; // previous message to this receiver still in flight; try again
       if (send_status == ESP_OK) {
-        sprintf(g_msg_last_opr_comm_status, "\nESP-NOW send success CMD #%d ", g_last_scanned_cmd_count);
-        sprintf(g_msg_last_esp_now_result_status, "ESP-NOW send success CMD #%d %s", g_last_scanned_cmd_count, g_cmd_queue[UNI_CMD_QNUM_NOW].scanned_cmd);
-        uni_lv_last_status_text_style(g_msg_last_esp_now_result_status);
-        g_uni_state = UNI_STATE_WAIT_CB;
-        DBG_SERIALPRINTLN("Change state to UNI_STATE_WAIT_CB");
+        uni_status_note(UNI_STATUS_SEND_OK, g_last_scanned_cmd_count, 0, 0);
+        uni_status_show_result();
+        if (UNI_PIPELINE_SENDS && (0 != g_change_send_no_view)) {
+          g_uni_state = UNI_STATE_WAIT_CMD;  // scan next cmd; uni_in_flight_report() shows this one's outcome
+          DBG_SERIALPRINTLN("Change state to UNI_STATE_WAIT_CMD");
+        } else {
+          g_uni_state = UNI_STATE_WAIT_CB;
+          DBG_SERIALPRINTLN("Change state to UNI_STATE_WAIT_CB");
+        }
       }
       else {
-        sprintf(g_msg_last_opr_comm_status, "\nESP-NOW send ERROR CMD #%d ", g_last_scanned_cmd_count);
-        sprintf(g_msg_last_esp_now_result_status, "ESP-NOW ERROR: sending CMD #%d: %s\n  %s", g_last_scanned_cmd_count, g_cmd_queue[UNI_CMD_QNUM_NOW].scanned_cmd, uni_esp_now_decode_error(send_status));
-        uni_lv_last_status_text_style(g_msg_last_esp_now_result_status); // yellow if "FAIL"
+        uni_status_note(UNI_STATUS_SEND_ERR, g_last_scanned_cmd_count, send_status, 0);
+        uni_status_show_result(); // yellow if "FAIL"
         if (0 != g_change_send_no_view)
           g_uni_state = UNI_STATE_WAIT_CMD;  // show error status and scan next cmd
         else
@@ -1302,6 +3106,7 @@ void loop() {
       }
       break;
     case UNI_STATE_WAIT_CB:     // waiting for send callback
+      uni_do_esp_now_callback_status(); // if there is callback status for an earlier command, show it
       break;
     case UNI_STATE_SHOW_STAT:   // show error status and allow abort
       uni_do_esp_now_callback_status(); // if there is callback status, show it
@@ -1310,13 +3115,40 @@ void loop() {
       // FIXME TODO should never get here
       break;
   }
+#if UNI_TRACE
+  uni_trace_state();
+#endif // UNI_TRACE
   uni_display_state();
 
-  lv_task_handler();  // let the GUI do its work
+  // how long we can sleep: until the next job, but not long while a message is in progress
+  uint32_t msec_sleep = UNI_LOOP_SLEEP_MAX_MSEC;
+  if ((0 != uni_in_flight_num()) || (0 != g_announce_req_pending) ||
+      (UNI_STATE_SENDING_CMD == g_uni_state) || (UNI_STATE_WAIT_CB == g_uni_state)) {
+    msec_sleep = CYDsampleDelayMsec;
+  }
+  msec_sleep = uni_timer_run(msec_now, msec_sleep); // time beacons
 
 #if (1-USE_LV_TICK_SET_CB) // if not using lv_tick_set_cb()
-  // not using lv_tick_set_cb(); do with manual estimate
-  lv_tick_inc(CYDsampleDelayMsec); // tell LVGL how much time has passed
+  // not using lv_tick_set_cb(); tell LVGL how much time has really passed
+  static uint32_t msec_prev_tick = 0; // millis() of the last lv_tick_inc()
+  uint32_t msec_tick = millis();
+  lv_tick_inc(msec_tick - msec_prev_tick);
+  msec_prev_tick = msec_tick;
 #endif // (USE_LV_TICK_SET_CB) end if not using lv_tick_set_cb(); otherwise lv_tick_set_cb() done in setup() after lv_init()
-  delay(CYDsampleDelayMsec);
+
+#if UNI_PERF || UNI_TRACE
+  int64_t usec_lvgl_start = esp_timer_get_time();
+#endif // UNI_PERF || UNI_TRACE
+  uni_stall_enter(&g_stall_lvgl);
+  uint32_t msec_gui = lv_task_handler();  // let the GUI do its work; returns when it wants to run again
+  uni_stall_leave();
+#if UNI_TRACE
+  uni_trace_complete(&g_trace_loop, UNI_TRACE_ID_LVGL, usec_lvgl_start, 0);
+#endif // UNI_TRACE
+  if (msec_gui < msec_sleep) msec_sleep = msec_gui;
+#if UNI_PERF
+  uni_perf_hist_add(&g_perf_lvgl, uni_perf_usec(usec_lvgl_start, esp_timer_get_time()));
+  uni_perf_loop_end(usec_loop_start);
+#endif // UNI_PERF
+  if (0 != msec_sleep) delay(msec_sleep);
 } // end loop()
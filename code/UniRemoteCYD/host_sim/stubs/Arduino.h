@@ -0,0 +1,79 @@
+/* Author: https://github.com/Mark-MDO47  Mar. 8, 2025
+ *  https://github.com/Mark-MDO47/UniRemote
+ *
+ * host_sim stand-in for the part of the ESP32 Arduino core that UniRemoteCYD uses.
+ *    Time is simulated: millis(), micros() and esp_timer_get_time() read g_sim_usec and delay()
+ *    moves it forward (see uni_sim.h). Serial prints to stdout only if g_sim_verbose is set.
+ */
+#ifndef UNI_SIM_ARDUINO_H
+#define UNI_SIM_ARDUINO_H 1
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+
+typedef uint8_t byte;
+typedef int esp_err_t;
+#define ESP_OK   0
+#define ESP_FAIL -1
+
+#define HIGH   1
+#define LOW    0
+#define INPUT  0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define HEX 16
+#define DEC 10
+#define IRAM_ATTR
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long p_msec);
+void yield();
+
+inline void pinMode(int p_pin, int p_mode) { }
+inline void digitalWrite(int p_pin, int p_val) { }
+inline int digitalRead(int p_pin) { return(HIGH); }
+
+inline bool isHexadecimalDigit(int p_c) { return(0 != isxdigit((unsigned char) p_c)); }
+inline bool isAlphaNumeric(int p_c) { return(0 != isalnum((unsigned char) p_c)); }
+inline bool isDigit(int p_c) { return(0 != isdigit((unsigned char) p_c)); }
+template<class A, class B> inline auto max(A p_a, B p_b) { return((p_a > p_b) ? p_a : p_b); }
+template<class A, class B> inline auto min(A p_a, B p_b) { return((p_a < p_b) ? p_a : p_b); }
+
+extern int g_sim_verbose; // non-zero: Serial output goes to stdout
+extern const char * g_sim_serial_in; // what is typed on Serial; read up to its zero termination
+
+class HardwareSerial {
+  public:
+    void begin(unsigned long p_baud) { }
+    operator bool() { return(true); }
+    int available() { return((int) strlen(g_sim_serial_in)); }
+    int read() { return(('\0' != *g_sim_serial_in) ? (unsigned char) *g_sim_serial_in++ : -1); }
+    void flush() { fflush(stdout); }
+    size_t write(const uint8_t * p_buf, size_t p_len) { if (g_sim_verbose) fwrite(p_buf, 1, p_len, stdout); return(p_len); }
+    template<class... A> int printf(const char * p_fmt, A... p_args) { return(g_sim_verbose ? ::printf(p_fmt, p_args...) : 0); }
+    void print(const char * p_str) { if (g_sim_verbose) fputs(p_str, stdout); }
+    void print(char p_c) { if (g_sim_verbose) fputc(p_c, stdout); }
+    void print(long long p_val, int p_base = DEC) { if (g_sim_verbose) ::printf((HEX == p_base) ? "%llX" : "%lld", p_val); }
+    void print(int p_val, int p_base = DEC) { print((long long) p_val, p_base); }
+    void print(unsigned int p_val, int p_base = DEC) { print((long long) p_val, p_base); }
+    void print(long p_val, int p_base = DEC) { print((long long) p_val, p_base); }
+    void print(unsigned long p_val, int p_base = DEC) { print((long long) p_val, p_base); }
+    void print(unsigned char p_val, int p_base = DEC) { print((long long) p_val, p_base); }
+    void print(unsigned long long p_val, int p_base = DEC) { print((long long) p_val, p_base); }
+    void print(double p_val) { if (g_sim_verbose) ::printf("%.2f", p_val); }
+    template<class T> void println(T p_val) { print(p_val); println(); }
+    template<class T> void println(T p_val, int p_base) { print(p_val, p_base); println(); }
+    void println() { if (g_sim_verbose) fputc('\n', stdout); }
+};
+extern HardwareSerial Serial;
+
+#include "esp_timer.h"
+
+#endif // UNI_SIM_ARDUINO_H
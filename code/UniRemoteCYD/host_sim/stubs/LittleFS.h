@@ -0,0 +1,46 @@
+/* host_sim stand-in for LittleFS.h; a few small files in memory, gone when the simulation ends
+ *
+ * Each write() costs g_sim_fs_write_usec of simulated time and is counted in g_sim_fs (see uni_sim.h),
+ *    so the benchmark shows what the journal costs loop().
+ */
+#ifndef UNI_SIM_LITTLEFS_H
+#define UNI_SIM_LITTLEFS_H 1
+
+#include "Arduino.h"
+
+#define UNI_SIM_FS_FILE_NUM 8          // most files
+#define UNI_SIM_FS_FILE_MAX 32768      // biggest file in bytes
+#define UNI_SIM_FS_NAME_MAX 32
+
+class File {
+  public:
+    File() { }
+    File(int16_t p_idx, uint8_t p_append) : m_idx(p_idx), m_append(p_append) { }
+    operator bool() const { return(m_idx >= 0); }
+    size_t write(const uint8_t * p_buf, size_t p_len);
+    size_t read(uint8_t * p_buf, size_t p_len);
+    bool seek(uint32_t p_pos);
+    size_t size() const;
+    void flush() { }
+    void close() { m_idx = -1; }
+  private:
+    int16_t m_idx = -1;      // file in fs::LittleFSFS m_files[]; -1 if not open
+    uint8_t m_append = 0;    // non-zero: every write goes at the end
+    uint32_t m_pos = 0;
+};
+
+namespace fs {
+class LittleFSFS {
+  public:
+    bool begin(bool p_format_if_fail = false) { return(true); }
+    File open(const char * p_path, const char * p_mode = "r");
+    bool exists(const char * p_path) { return(find(p_path) >= 0); }
+    bool remove(const char * p_path);
+    void end() { }
+    int16_t find(const char * p_path);
+    struct { char name[UNI_SIM_FS_NAME_MAX]; uint8_t used; uint32_t size; uint8_t data[UNI_SIM_FS_FILE_MAX]; } m_files[UNI_SIM_FS_FILE_NUM];
+};
+} // namespace fs
+extern fs::LittleFSFS LittleFS;
+
+#endif // UNI_SIM_LITTLEFS_H
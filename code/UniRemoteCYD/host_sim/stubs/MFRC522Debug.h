@@ -0,0 +1,10 @@
+/* host_sim stand-in for MFRC522Debug.h */
+#ifndef UNI_SIM_MFRC522_DEBUG_H
+#define UNI_SIM_MFRC522_DEBUG_H 1
+#include "MFRC522v2.h"
+namespace MFRC522Debug {
+  inline void PrintUID(HardwareSerial & p_serial, const MFRC522::Uid & p_uid) {
+    for (byte idx = 0; idx < p_uid.size; idx++) p_serial.printf(" %02X", p_uid.uidByte[idx]);
+  }
+}
+#endif // UNI_SIM_MFRC522_DEBUG_H
@@ -0,0 +1,8 @@
+/* host_sim stand-in for MFRC522DriverPinSimple.h */
+#ifndef UNI_SIM_MFRC522_DRIVER_PIN_SIMPLE_H
+#define UNI_SIM_MFRC522_DRIVER_PIN_SIMPLE_H 1
+class MFRC522DriverPinSimple {
+  public:
+    MFRC522DriverPinSimple(int p_pin) { }
+};
+#endif // UNI_SIM_MFRC522_DRIVER_PIN_SIMPLE_H
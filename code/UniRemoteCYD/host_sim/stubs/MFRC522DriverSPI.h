@@ -0,0 +1,10 @@
+/* host_sim stand-in for MFRC522DriverSPI.h */
+#ifndef UNI_SIM_MFRC522_DRIVER_SPI_H
+#define UNI_SIM_MFRC522_DRIVER_SPI_H 1
+#include "MFRC522v2.h"
+#include "MFRC522DriverPinSimple.h"
+class MFRC522DriverSPI : public MFRC522Driver {
+  public:
+    MFRC522DriverSPI(MFRC522DriverPinSimple & p_pin) { }
+};
+#endif // UNI_SIM_MFRC522_DRIVER_SPI_H
@@ -0,0 +1,69 @@
+/* Author: https://github.com/Mark-MDO47  Mar. 9, 2025
+ *  https://github.com/Mark-MDO47/UniRemote
+ *
+ * host_sim stand-in for MFRC522v2.h: an MFRC522 with one MIFARE Classic 1K card in front of it
+ *
+ * The card is 64 blocks in RAM with the keys in each sector trailer. It answers the way a real card
+ *    does: REQA only while idle, authenticate one sector at a time with key A or B, read and write
+ *    only in the sector authenticated, and after HaltA silence until it is taken away and put back.
+ *
+ * Each call costs simulated time and SPI traffic from g_sim_picc_cost[] (see uni_sim_mfrc522.cpp for
+ *    where the numbers come from) and is counted in g_sim_picc_stats. Faults can be injected into the
+ *    next authenticate, read or write, or the card taken away in the middle (see uni_sim.h).
+ */
+#ifndef UNI_SIM_MFRC522V2_H
+#define UNI_SIM_MFRC522V2_H 1
+
+#include "Arduino.h"
+
+#define UNI_SIM_CARD_BLOCKS 64      // MIFARE Classic 1K: 16 sectors of 4 blocks
+#define UNI_SIM_CARD_BLOCK_BYTES 16
+
+class MFRC522Constants {
+  public:
+  enum PICC_Command : uint8_t { PICC_CMD_REQA = 0x26, PICC_CMD_WUPA = 0x52, PICC_CMD_HLTA = 0x50,
+                                PICC_CMD_MF_AUTH_KEY_A = 0x60, PICC_CMD_MF_AUTH_KEY_B = 0x61,
+                                PICC_CMD_MF_READ = 0x30, PICC_CMD_MF_WRITE = 0xA0 };
+  enum StatusCode : uint8_t { STATUS_OK, STATUS_ERROR, STATUS_COLLISION, STATUS_TIMEOUT, STATUS_NO_ROOM,
+                              STATUS_INTERNAL_ERROR, STATUS_INVALID, STATUS_CRC_WRONG, STATUS_MIFARE_NACK = 0xff };
+  enum PICC_Type : uint8_t { PICC_TYPE_UNKNOWN, PICC_TYPE_ISO_14443_4, PICC_TYPE_ISO_18092, PICC_TYPE_MIFARE_MINI,
+                             PICC_TYPE_MIFARE_1K, PICC_TYPE_MIFARE_4K, PICC_TYPE_MIFARE_UL };
+};
+
+// what a card in front of the reader is doing (ISO 14443-3 states)
+#define UNI_SIM_CARD_ABSENT 0   // not in the field
+#define UNI_SIM_CARD_IDLE   1   // answers REQA
+#define UNI_SIM_CARD_READY  2   // answered REQA; waiting for select
+#define UNI_SIM_CARD_ACTIVE 3   // selected; auth, read, write
+#define UNI_SIM_CARD_HALT   4   // after HLTA or an error; silent until it leaves the field
+
+typedef struct {
+  uint8_t state;      // UNI_SIM_CARD_*
+  uint8_t uid[4];
+  uint8_t sak;        // 0x08 for MIFARE Classic 1K
+  int8_t auth_sector; // sector authenticated, or -1
+  uint8_t blocks[UNI_SIM_CARD_BLOCKS][UNI_SIM_CARD_BLOCK_BYTES];
+} uni_sim_card_t;
+extern uni_sim_card_t g_sim_card;
+
+class MFRC522Driver { };
+
+class MFRC522 {
+  public:
+    struct Uid { byte size; byte uidByte[10]; byte sak; } uid;
+    struct MIFARE_Key { byte keyByte[6]; };
+    MFRC522(MFRC522Driver & p_driver) { }
+    bool PCD_Init();
+    bool PICC_IsNewCardPresent();
+    bool PICC_ReadCardSerial();
+    MFRC522Constants::PICC_Type PICC_GetType(byte p_sak);
+    MFRC522Constants::StatusCode PCD_Authenticate(MFRC522Constants::PICC_Command p_cmd, byte p_block, MIFARE_Key * p_key, Uid * p_uid);
+    MFRC522Constants::StatusCode MIFARE_Read(byte p_block, byte * p_buf, byte * p_size);
+    MFRC522Constants::StatusCode MIFARE_Write(byte p_block, byte * p_buf, byte p_size);
+    MFRC522Constants::StatusCode PICC_HaltA();
+    void PCD_StopCrypto1();
+  private:
+    uint8_t m_crypto1_on = 0;   // Status2Reg MFCrypto1On
+};
+
+#endif // UNI_SIM_MFRC522V2_H
@@ -0,0 +1,27 @@
+/* host_sim stand-in for Preferences.h (NVS); kept in memory, gone when the simulation ends */
+#ifndef UNI_SIM_PREFERENCES_H
+#define UNI_SIM_PREFERENCES_H 1
+
+#include "Arduino.h"
+
+#define UNI_SIM_NVS_NUM 64        // most keys
+#define UNI_SIM_NVS_VAL_MAX 128   // longest value in bytes
+
+class Preferences {
+  public:
+    bool begin(const char * p_name, bool p_read_only = false) { return(true); }
+    void end() { }
+    size_t getBytes(const char * p_key, void * p_buf, size_t p_len);
+    size_t putBytes(const char * p_key, const void * p_buf, size_t p_len);
+    uint8_t getUChar(const char * p_key, uint8_t p_default = 0) { uint8_t val = p_default; getBytes(p_key, &val, sizeof(val)); return(val); }
+    size_t putUChar(const char * p_key, uint8_t p_val) { return(putBytes(p_key, &p_val, sizeof(p_val))); }
+    uint32_t getUInt(const char * p_key, uint32_t p_default = 0) { uint32_t val = p_default; getBytes(p_key, &val, sizeof(val)); return(val); }
+    size_t putUInt(const char * p_key, uint32_t p_val) { return(putBytes(p_key, &p_val, sizeof(p_val))); }
+    bool remove(const char * p_key);
+  private:
+    struct { char key[16]; uint8_t val[UNI_SIM_NVS_VAL_MAX]; size_t len; } m_entries[UNI_SIM_NVS_NUM];
+    uint16_t m_num = 0;
+    int16_t find(const char * p_key);
+};
+
+#endif // UNI_SIM_PREFERENCES_H
@@ -0,0 +1,5 @@
+/* host_sim stand-in for SPI.h; the MFRC522 stand-in does not use it */
+#ifndef UNI_SIM_SPI_H
+#define UNI_SIM_SPI_H 1
+#include "Arduino.h"
+#endif // UNI_SIM_SPI_H
@@ -0,0 +1,18 @@
+/* host_sim stand-in for TFT_eSPI.h; nothing is drawn */
+#ifndef UNI_SIM_TFT_ESPI_H
+#define UNI_SIM_TFT_ESPI_H 1
+#include "Arduino.h"
+class TFT_eSPI {
+  public:
+    TFT_eSPI(int16_t p_width = 240, int16_t p_height = 320) { }
+    void begin() { }
+    bool initDMA(bool p_cs = false) { return(true); }
+    void setSwapBytes(bool p_swap) { }
+    void setRotation(uint8_t p_rotation) { }
+    void startWrite() { }
+    void endWrite() { }
+    void dmaWait() { }
+    bool dmaBusy() { return(false); }
+    void pushImageDMA(int32_t p_x, int32_t p_y, int32_t p_w, int32_t p_h, uint16_t * p_data, uint16_t * p_buf = nullptr) { }
+};
+#endif // UNI_SIM_TFT_ESPI_H
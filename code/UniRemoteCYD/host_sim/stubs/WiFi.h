@@ -0,0 +1,11 @@
+/* host_sim stand-in for WiFi.h */
+#ifndef UNI_SIM_WIFI_H
+#define UNI_SIM_WIFI_H 1
+#include "Arduino.h"
+#define WIFI_STA 1
+class WiFiClass {
+  public:
+    bool mode(int p_mode) { return(true); }
+};
+extern WiFiClass WiFi;
+#endif // UNI_SIM_WIFI_H
@@ -0,0 +1,13 @@
+/* host_sim stand-in for Wire.h; no I2C devices answer */
+#ifndef UNI_SIM_WIRE_H
+#define UNI_SIM_WIRE_H 1
+#include "Arduino.h"
+class TwoWire {
+  public:
+    bool begin(int p_sda = -1, int p_scl = -1) { return(true); }
+    uint8_t requestFrom(uint8_t p_addr, size_t p_len) { return(0); }
+    int available() { return(0); }
+    int read() { return(-1); }
+};
+extern TwoWire Wire;
+#endif // UNI_SIM_WIRE_H
@@ -0,0 +1,13 @@
+/* host_sim stand-in for XPT2046_Bitbang.h; never touched. Touches go straight to the buttons (see uni_sim.h) */
+#ifndef UNI_SIM_XPT2046_BITBANG_H
+#define UNI_SIM_XPT2046_BITBANG_H 1
+#include "Arduino.h"
+struct TouchPoint { int x, y, zRaw, xRaw, yRaw; };
+class XPT2046_Bitbang {
+  public:
+    XPT2046_Bitbang(int p_mosi, int p_miso, int p_clk, int p_cs) { }
+    void begin() { }
+    void setRotation(int p_rotation) { }
+    TouchPoint getTouch() { TouchPoint point = { 0, 0, 0, 0, 0 }; return(point); }
+};
+#endif // UNI_SIM_XPT2046_BITBANG_H
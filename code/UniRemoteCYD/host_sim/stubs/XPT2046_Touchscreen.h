@@ -0,0 +1,8 @@
+/* host_sim stand-in for XPT2046_Touchscreen.h */
+#ifndef UNI_SIM_XPT2046_TOUCHSCREEN_H
+#define UNI_SIM_XPT2046_TOUCHSCREEN_H 1
+class XPT2046_Touchscreen {
+  public:
+    XPT2046_Touchscreen(int p_cs, int p_irq = 255) { }
+};
+#endif // UNI_SIM_XPT2046_TOUCHSCREEN_H
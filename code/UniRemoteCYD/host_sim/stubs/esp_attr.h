@@ -0,0 +1,5 @@
+/* host_sim stand-in for esp_attr.h */
+#ifndef UNI_SIM_ESP_ATTR_H
+#define UNI_SIM_ESP_ATTR_H 1
+#define RTC_NOINIT_ATTR
+#endif // UNI_SIM_ESP_ATTR_H
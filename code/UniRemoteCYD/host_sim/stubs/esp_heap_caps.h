@@ -0,0 +1,10 @@
+/* host_sim stand-in for esp_heap_caps.h */
+#ifndef UNI_SIM_ESP_HEAP_CAPS_H
+#define UNI_SIM_ESP_HEAP_CAPS_H 1
+#include <stdlib.h>
+#include <stdint.h>
+#define MALLOC_CAP_DMA      0x008
+#define MALLOC_CAP_INTERNAL 0x800
+inline void * heap_caps_malloc(size_t p_size, uint32_t p_caps) { return(malloc(p_size)); }
+inline void heap_caps_free(void * p_ptr) { free(p_ptr); }
+#endif // UNI_SIM_ESP_HEAP_CAPS_H
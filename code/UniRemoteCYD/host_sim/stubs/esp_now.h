@@ -0,0 +1,52 @@
+/* host_sim stand-in for esp_now.h
+ *    esp_now_send() hands the frame to the simulated radio in uni_sim_stubs.cpp; the send callback
+ *    comes later from delay() or between loop() calls, as it would from the WiFi task
+ */
+#ifndef UNI_SIM_ESP_NOW_H
+#define UNI_SIM_ESP_NOW_H 1
+
+#include "Arduino.h"
+
+#define ESP_ERR_ESPNOW_BASE      0x3000
+#define ESP_ERR_ESPNOW_NOT_INIT  (ESP_ERR_ESPNOW_BASE + 1)
+#define ESP_ERR_ESPNOW_ARG       (ESP_ERR_ESPNOW_BASE + 2)
+#define ESP_ERR_ESPNOW_NO_MEM    (ESP_ERR_ESPNOW_BASE + 3)
+#define ESP_ERR_ESPNOW_FULL      (ESP_ERR_ESPNOW_BASE + 4)
+#define ESP_ERR_ESPNOW_NOT_FOUND (ESP_ERR_ESPNOW_BASE + 5)
+#define ESP_ERR_ESPNOW_INTERNAL  (ESP_ERR_ESPNOW_BASE + 6)
+#define ESP_ERR_ESPNOW_EXIST     (ESP_ERR_ESPNOW_BASE + 7)
+#define ESP_ERR_ESPNOW_IF        (ESP_ERR_ESPNOW_BASE + 8)
+#define ESP_ERR_ESPNOW_CHAN      (ESP_ERR_ESPNOW_BASE + 9)
+
+#define ESP_NOW_ETH_ALEN 6
+#define ESP_NOW_MAX_DATA_LEN 250
+#define ESP_NOW_MAX_TOTAL_PEER_NUM 20
+#define ESP_NOW_MAX_ENCRYPT_PEER_NUM 6
+#define ESP_NOW_KEY_LEN 16
+
+typedef enum { ESP_NOW_SEND_SUCCESS = 0, ESP_NOW_SEND_FAIL } esp_now_send_status_t;
+typedef enum { WIFI_IF_STA = 0, WIFI_IF_AP } wifi_interface_t;
+typedef struct { int8_t rssi; uint8_t channel; } wifi_pkt_rx_ctrl_t;
+typedef struct { uint8_t * src_addr; uint8_t * des_addr; wifi_pkt_rx_ctrl_t * rx_ctrl; } esp_now_recv_info_t;
+typedef struct {
+  uint8_t peer_addr[ESP_NOW_ETH_ALEN];
+  uint8_t lmk[ESP_NOW_KEY_LEN];
+  uint8_t channel;
+  wifi_interface_t ifidx;
+  bool encrypt;
+  void * priv;
+} esp_now_peer_info_t;
+typedef void (*esp_now_recv_cb_t)(const esp_now_recv_info_t * p_info, const uint8_t * p_data, int p_len);
+typedef void (*esp_now_send_cb_t)(const uint8_t * p_mac_addr, esp_now_send_status_t p_status);
+
+esp_err_t esp_now_init();
+esp_err_t esp_now_deinit();
+esp_err_t esp_now_register_recv_cb(esp_now_recv_cb_t p_cb);
+esp_err_t esp_now_register_send_cb(esp_now_send_cb_t p_cb);
+esp_err_t esp_now_add_peer(const esp_now_peer_info_t * p_peer);
+esp_err_t esp_now_mod_peer(const esp_now_peer_info_t * p_peer);
+esp_err_t esp_now_del_peer(const uint8_t * p_mac_addr);
+bool esp_now_is_peer_exist(const uint8_t * p_mac_addr);
+esp_err_t esp_now_send(const uint8_t * p_mac_addr, const uint8_t * p_data, size_t p_len);
+
+#endif // UNI_SIM_ESP_NOW_H
@@ -0,0 +1,6 @@
+/* host_sim stand-in for esp_system.h; every start is a power on */
+#ifndef UNI_SIM_ESP_SYSTEM_H
+#define UNI_SIM_ESP_SYSTEM_H 1
+typedef enum { ESP_RST_UNKNOWN, ESP_RST_POWERON, ESP_RST_EXT, ESP_RST_SW, ESP_RST_PANIC, ESP_RST_INT_WDT, ESP_RST_TASK_WDT } esp_reset_reason_t;
+inline esp_reset_reason_t esp_reset_reason() { return(ESP_RST_POWERON); }
+#endif // UNI_SIM_ESP_SYSTEM_H
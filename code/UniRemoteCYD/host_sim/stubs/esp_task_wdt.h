@@ -0,0 +1,10 @@
+/* host_sim stand-in for esp_task_wdt.h; there is no watchdog */
+#ifndef UNI_SIM_ESP_TASK_WDT_H
+#define UNI_SIM_ESP_TASK_WDT_H 1
+#include "Arduino.h"
+typedef struct { uint32_t timeout_ms; uint32_t idle_core_mask; bool trigger_panic; } esp_task_wdt_config_t;
+inline esp_err_t esp_task_wdt_reconfigure(const esp_task_wdt_config_t * p_config) { return(ESP_OK); }
+inline esp_err_t esp_task_wdt_init(const esp_task_wdt_config_t * p_config) { return(ESP_OK); }
+inline esp_err_t esp_task_wdt_reset() { return(ESP_OK); }
+inline void enableLoopWDT() { }
+#endif // UNI_SIM_ESP_TASK_WDT_H
@@ -0,0 +1,23 @@
+/* host_sim stand-in for esp_timer.h; the clock is simulated (see uni_sim.h)
+ *    periodic timers are accepted and never run
+ */
+#ifndef UNI_SIM_ESP_TIMER_H
+#define UNI_SIM_ESP_TIMER_H 1
+
+#include <stdint.h>
+
+int64_t esp_timer_get_time();
+
+typedef struct uni_sim_esp_timer * esp_timer_handle_t;
+typedef enum { ESP_TIMER_TASK } esp_timer_dispatch_t;
+typedef struct {
+  void (*callback)(void *);
+  void * arg;
+  esp_timer_dispatch_t dispatch_method;
+  const char * name;
+  bool skip_unhandled_events;
+} esp_timer_create_args_t;
+inline int esp_timer_create(const esp_timer_create_args_t * p_args, esp_timer_handle_t * p_handle) { *p_handle = (esp_timer_handle_t) 1; return(0); }
+inline int esp_timer_start_periodic(esp_timer_handle_t p_handle, uint64_t p_usec) { return(0); }
+
+#endif // UNI_SIM_ESP_TIMER_H
@@ -0,0 +1,26 @@
+/* host_sim stand-in for esp_wifi.h; the channel is the simulated radio's (see uni_sim.h) */
+#ifndef UNI_SIM_ESP_WIFI_H
+#define UNI_SIM_ESP_WIFI_H 1
+
+#include "esp_now.h"
+
+#ifndef ESP_IDF_VERSION
+#define ESP_IDF_VERSION_VAL(p_major, p_minor, p_patch) (((p_major) << 16) | ((p_minor) << 8) | (p_patch))
+#define ESP_IDF_VERSION ESP_IDF_VERSION_VAL(5, 4, 0)
+#endif // ESP_IDF_VERSION
+
+typedef enum {
+  WIFI_PHY_RATE_1M_L = 0x00, WIFI_PHY_RATE_2M_L = 0x01, WIFI_PHY_RATE_5M_L = 0x02, WIFI_PHY_RATE_11M_L = 0x03,
+  WIFI_PHY_RATE_24M = 0x09, WIFI_PHY_RATE_12M = 0x0B
+} wifi_phy_rate_t;
+typedef enum { WIFI_PHY_MODE_LR, WIFI_PHY_MODE_11B, WIFI_PHY_MODE_11G } wifi_phy_mode_t;
+typedef struct { wifi_phy_mode_t phymode; wifi_phy_rate_t rate; bool ersu; bool dcm; } esp_now_rate_config_t;
+typedef enum { WIFI_SECOND_CHAN_NONE = 0, WIFI_SECOND_CHAN_ABOVE, WIFI_SECOND_CHAN_BELOW } wifi_second_chan_t;
+
+esp_err_t esp_now_set_peer_rate_config(const uint8_t * p_mac_addr, esp_now_rate_config_t * p_config);
+esp_err_t esp_wifi_config_espnow_rate(wifi_interface_t p_ifx, wifi_phy_rate_t p_rate);
+esp_err_t esp_wifi_set_channel(uint8_t p_primary, wifi_second_chan_t p_second);
+esp_err_t esp_wifi_get_channel(uint8_t * p_primary, wifi_second_chan_t * p_second);
+esp_err_t esp_wifi_get_mac(wifi_interface_t p_ifx, uint8_t * p_mac_addr);
+
+#endif // UNI_SIM_ESP_WIFI_H
@@ -0,0 +1,118 @@
+/* host_sim stand-in for the part of LVGL 9.2 that UniRemoteCYD uses
+ *    Objects are real (from a pool) so each button keeps its event callback and user data; the driver
+ *    presses a button with uni_sim_lv_send_event(). Nothing is drawn; lv_task_handler() does nothing
+ *    but ask to be run again in LV_DEF_REFR_PERIOD.
+ */
+#ifndef UNI_SIM_LVGL_H
+#define UNI_SIM_LVGL_H 1
+
+#include "Arduino.h"
+
+#define LV_COLOR_DEPTH 16
+#define LV_DEF_REFR_PERIOD 33 // msec; lv_task_handler() always wants to run again this soon
+
+typedef int lv_event_code_t;
+typedef int lv_align_t;
+typedef int lv_palette_t;
+typedef int lv_display_rotation_t;
+
+enum { LV_EVENT_ALL, LV_EVENT_PRESSED, LV_EVENT_LONG_PRESSED, LV_EVENT_CLICKED, LV_EVENT_RELEASED,
+       LV_EVENT_RESOLUTION_CHANGED, LV_EVENT_REFR_START, LV_EVENT_REFR_READY, LV_EVENT_FLUSH_START, LV_EVENT_FLUSH_FINISH };
+enum { LV_ALIGN_DEFAULT, LV_ALIGN_TOP_LEFT, LV_ALIGN_TOP_MID, LV_ALIGN_TOP_RIGHT, LV_ALIGN_BOTTOM_LEFT, LV_ALIGN_BOTTOM_MID,
+       LV_ALIGN_BOTTOM_RIGHT, LV_ALIGN_LEFT_MID, LV_ALIGN_RIGHT_MID, LV_ALIGN_CENTER, LV_ALIGN_OUT_TOP_LEFT, LV_ALIGN_OUT_BOTTOM_LEFT };
+enum { LV_DISPLAY_ROTATION_0, LV_DISPLAY_ROTATION_90, LV_DISPLAY_ROTATION_180, LV_DISPLAY_ROTATION_270 };
+enum { LV_INDEV_STATE_RELEASED, LV_INDEV_STATE_PRESSED };
+enum { LV_INDEV_TYPE_NONE, LV_INDEV_TYPE_POINTER };
+enum { LV_PALETTE_RED, LV_PALETTE_GREEN, LV_PALETTE_BLUE, LV_PALETTE_LIGHT_BLUE, LV_PALETTE_YELLOW, LV_PALETTE_GREY };
+enum { LV_DISPLAY_RENDER_MODE_PARTIAL, LV_DISPLAY_RENDER_MODE_DIRECT, LV_DISPLAY_RENDER_MODE_FULL };
+enum { LV_COLOR_FORMAT_RGB565 };
+enum { LV_OBJ_FLAG_HIDDEN, LV_OBJ_FLAG_CLICKABLE };
+enum { LV_LABEL_LONG_WRAP };
+
+#define LV_LOG_USER(...) do { } while (0)
+
+struct lv_event_t;
+typedef void (*lv_event_cb_t)(lv_event_t * p_event);
+
+struct lv_obj_t {
+  lv_event_cb_t event_cb;
+  lv_event_code_t event_filter;
+  void * user_data;
+};
+struct lv_event_t {
+  lv_event_code_t code;
+  lv_obj_t * target;
+  void * user_data;
+};
+struct lv_style_t { int unused; };
+struct lv_color_t { uint8_t blue, green, red; };
+struct lv_point_t { int32_t x, y; };
+struct lv_area_t { int32_t x1, y1, x2, y2; };
+struct lv_indev_data_t { lv_point_t point; int state; };
+struct lv_indev_t { void (*read_cb)(lv_indev_t *, lv_indev_data_t *); };
+struct lv_display_t { void (*flush_cb)(lv_display_t *, const lv_area_t *, uint8_t *); void * driver_data; lv_display_rotation_t rotation; };
+
+lv_obj_t * uni_sim_lv_obj_new(); // from the pool in uni_sim_stubs.cpp
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_sim_lv_send_event() - call an object's event callback the way LVGL would
+//       returns: nothing
+//
+inline void uni_sim_lv_send_event(lv_obj_t * p_obj, lv_event_code_t p_code) {
+  if ((nullptr == p_obj) || (nullptr == p_obj->event_cb)) return;
+  if ((LV_EVENT_ALL != p_obj->event_filter) && (p_code != p_obj->event_filter)) return;
+  lv_event_t event = { p_code, p_obj, p_obj->user_data };
+  p_obj->event_cb(&event);
+} // end uni_sim_lv_send_event()
+
+// objects
+inline lv_obj_t * lv_screen_active() { static lv_obj_t screen = { nullptr, 0, nullptr }; return(&screen); }
+inline lv_obj_t * lv_obj_create(lv_obj_t * p_parent) { return(uni_sim_lv_obj_new()); }
+inline lv_obj_t * lv_button_create(lv_obj_t * p_parent) { return(uni_sim_lv_obj_new()); }
+inline lv_obj_t * lv_label_create(lv_obj_t * p_parent) { return(uni_sim_lv_obj_new()); }
+inline void lv_obj_add_event_cb(lv_obj_t * p_obj, lv_event_cb_t p_cb, lv_event_code_t p_filter, void * p_user_data) {
+  p_obj->event_cb = p_cb; p_obj->event_filter = p_filter; p_obj->user_data = p_user_data;
+}
+inline lv_event_code_t lv_event_get_code(lv_event_t * p_event) { return(p_event->code); }
+inline void * lv_event_get_target(lv_event_t * p_event) { return(p_event->target); }
+inline void * lv_event_get_current_target(lv_event_t * p_event) { return(p_event->target); }
+inline void * lv_event_get_user_data(lv_event_t * p_event) { return(p_event->user_data); }
+
+// everything else is accepted and does nothing
+#define UNI_SIM_LV_NOP(p_name) template<class... A> inline void p_name(A...) { }
+UNI_SIM_LV_NOP(lv_init) UNI_SIM_LV_NOP(lv_tick_inc) UNI_SIM_LV_NOP(lv_tick_set_cb)
+UNI_SIM_LV_NOP(lv_obj_set_size) UNI_SIM_LV_NOP(lv_obj_set_width) UNI_SIM_LV_NOP(lv_obj_set_height) UNI_SIM_LV_NOP(lv_obj_set_pos)
+UNI_SIM_LV_NOP(lv_obj_align) UNI_SIM_LV_NOP(lv_obj_align_to) UNI_SIM_LV_NOP(lv_obj_center) UNI_SIM_LV_NOP(lv_obj_clean)
+UNI_SIM_LV_NOP(lv_obj_add_style) UNI_SIM_LV_NOP(lv_obj_remove_style) UNI_SIM_LV_NOP(lv_obj_add_flag) UNI_SIM_LV_NOP(lv_obj_remove_flag)
+UNI_SIM_LV_NOP(lv_obj_invalidate) UNI_SIM_LV_NOP(lv_obj_delete) UNI_SIM_LV_NOP(lv_obj_set_style_text_font) UNI_SIM_LV_NOP(lv_obj_set_style_bg_color)
+UNI_SIM_LV_NOP(lv_label_set_text) UNI_SIM_LV_NOP(lv_label_set_long_mode) UNI_SIM_LV_NOP(lv_screen_load)
+UNI_SIM_LV_NOP(lv_style_init) UNI_SIM_LV_NOP(lv_style_set_bg_color) UNI_SIM_LV_NOP(lv_style_set_text_color)
+UNI_SIM_LV_NOP(lv_style_set_width) UNI_SIM_LV_NOP(lv_style_set_height)
+UNI_SIM_LV_NOP(lv_display_set_rotation) UNI_SIM_LV_NOP(lv_display_set_buffers) UNI_SIM_LV_NOP(lv_display_add_event_cb)
+UNI_SIM_LV_NOP(lv_display_flush_ready) UNI_SIM_LV_NOP(lv_draw_sw_rgb565_swap)
+UNI_SIM_LV_NOP(lv_indev_set_type)
+
+// colors
+template<class... A> inline lv_color_t lv_palette_main(A...) { lv_color_t color = { 0, 0, 0 }; return(color); }
+template<class... A> inline lv_color_t lv_palette_lighten(A...) { return(lv_palette_main()); }
+template<class... A> inline lv_color_t lv_palette_darken(A...) { return(lv_palette_main()); }
+
+// display and input device
+inline lv_display_t * uni_sim_lv_display() { static lv_display_t display = { nullptr, nullptr, LV_DISPLAY_ROTATION_0 }; return(&display); }
+inline lv_display_t * lv_display_create(int32_t p_hor, int32_t p_ver) { return(uni_sim_lv_display()); }
+inline lv_display_t * lv_tft_espi_create(uint32_t p_hor, uint32_t p_ver, void * p_buf, uint32_t p_buf_size) { return(uni_sim_lv_display()); }
+inline lv_display_t * lv_display_get_default() { return(uni_sim_lv_display()); }
+inline void lv_display_set_flush_cb(lv_display_t * p_disp, void (*p_cb)(lv_display_t *, const lv_area_t *, uint8_t *)) { p_disp->flush_cb = p_cb; }
+inline void lv_display_set_driver_data(lv_display_t * p_disp, void * p_data) { p_disp->driver_data = p_data; }
+inline void * lv_display_get_driver_data(lv_display_t * p_disp) { return(p_disp->driver_data); }
+inline lv_display_rotation_t lv_display_get_rotation(lv_display_t * p_disp) { return(p_disp->rotation); }
+inline int32_t lv_display_get_horizontal_resolution(lv_display_t * p_disp) { return(320); }
+inline int32_t lv_display_get_vertical_resolution(lv_display_t * p_disp) { return(240); }
+inline int32_t lv_area_get_width(const lv_area_t * p_area) { return(p_area->x2 - p_area->x1 + 1); }
+inline int32_t lv_area_get_height(const lv_area_t * p_area) { return(p_area->y2 - p_area->y1 + 1); }
+inline lv_indev_t * lv_indev_create() { static lv_indev_t indev = { nullptr }; return(&indev); }
+inline void lv_indev_set_read_cb(lv_indev_t * p_indev, void (*p_cb)(lv_indev_t *, lv_indev_data_t *)) { p_indev->read_cb = p_cb; }
+inline uint32_t lv_task_handler() { return(LV_DEF_REFR_PERIOD); }
+inline uint32_t lv_timer_handler() { return(lv_task_handler()); }
+
+#endif // UNI_SIM_LVGL_H
@@ -0,0 +1,108 @@
+/* Author: https://github.com/Mark-MDO47  Mar. 8, 2025
+ *  https://github.com/Mark-MDO47/UniRemote
+ *
+ * uni_sim.h - what the host_sim driver (uni_sim.cpp) uses to run the simulated world around the sketch
+ *
+ * Time: g_sim_usec is the clock. Nothing moves it but delay() and uni_sim_advance_usec(), so the
+ *    sketch takes no simulated time to run its code, only to sleep. Send callbacks come when the
+ *    clock passes their time, from inside delay() the same as from the WiFi task on the CYD.
+ *
+ * Radio: one message takes g_sim_air_usec from esp_now_send() to its send callback. Broadcasts always
+ *    succeed. A unicast succeeds if a receiver with that MAC is on the channel we are on, unless
+ *    uni_sim_radio_next() says otherwise for the next one.
+ *
+ * RFID: one MIFARE Classic 1K card (see MFRC522v2.h). Each MFRC522 call takes simulated time: the wait
+ *    for the card plus the SPI bytes at g_sim_picc_spi_hz. A card that does not answer costs the
+ *    whole g_sim_picc_timeout_usec. While waiting the library polls an IRQ register; each poll is
+ *    counted as one more SPI transfer.
+ *
+ * Flash: LittleFS files live in memory (see LittleFS.h); each write takes g_sim_fs_write_usec.
+ */
+#ifndef UNI_SIM_H
+#define UNI_SIM_H 1
+
+#include "Arduino.h"
+#include "esp_now.h"
+#include "MFRC522v2.h"
+
+#define UNI_SIM_RCVR_NUM 8       // most simulated receivers
+#define UNI_SIM_PENDING_NUM 16   // most send callbacks waiting to happen
+
+#define UNI_SIM_NEXT_AIR  0      // uni_sim_radio_next(): outcome from the receivers and channel
+#define UNI_SIM_NEXT_OK   1      // next unicast succeeds whatever the receivers
+#define UNI_SIM_NEXT_FAIL 2      // next unicast fails whatever the receivers
+
+extern int64_t g_sim_usec;         // the simulated clock
+extern uint32_t g_sim_air_usec;    // esp_now_send() to send callback
+extern uint8_t g_sim_channel;      // WiFi channel our radio is on
+
+typedef struct {
+  uint32_t cmd_num;      // command frames sent (frame[0] is not zero)
+  uint32_t cmd_ok_num;   // command frames whose callback said success
+  uint32_t probe_num;    // channel probes sent
+  uint32_t ctrl_num;     // other frames with no command: beacons, requests to announce
+  uint32_t cb_num;       // send callbacks made
+} uni_sim_radio_stats_t;
+extern uni_sim_radio_stats_t g_sim_radio;
+
+void uni_sim_advance_usec(int64_t p_usec);                     // move the clock, making the send callbacks that come due
+int16_t uni_sim_rcvr_add(const uint8_t * p_mac_addr, uint8_t p_channel); // returns zero if OK
+void uni_sim_radio_next(uint8_t p_next);                       // UNI_SIM_NEXT_*; for the next unicast only
+
+// RFID reader: each MFRC522 call is one of these
+#define UNI_SIM_PICC_OP_INIT        0  // PCD_Init()
+#define UNI_SIM_PICC_OP_REQA        1  // PICC_IsNewCardPresent()
+#define UNI_SIM_PICC_OP_SELECT      2  // PICC_ReadCardSerial()
+#define UNI_SIM_PICC_OP_AUTH        3  // PCD_Authenticate()
+#define UNI_SIM_PICC_OP_READ        4  // MIFARE_Read()
+#define UNI_SIM_PICC_OP_WRITE       5  // MIFARE_Write()
+#define UNI_SIM_PICC_OP_HALT        6  // PICC_HaltA()
+#define UNI_SIM_PICC_OP_STOP_CRYPTO 7  // PCD_StopCrypto1()
+#define UNI_SIM_PICC_OP_NUM         8
+extern const char * g_sim_picc_op_names[UNI_SIM_PICC_OP_NUM];
+
+typedef struct {
+  uint32_t usec_card;    // waiting for the card to answer: frames on the air and the card's own time
+  uint16_t spi_xfers;    // register reads and writes, not counting polls while waiting
+  uint16_t spi_bytes;    // bytes in those transfers, address bytes included
+} uni_sim_picc_cost_t;
+extern uni_sim_picc_cost_t g_sim_picc_cost[UNI_SIM_PICC_OP_NUM];
+extern uint32_t g_sim_picc_timeout_usec; // no answer from the card: the MFRC522 timer PCD_Init() sets
+extern uint32_t g_sim_picc_poll_usec;    // one poll of ComIrqReg or DivIrqReg while waiting
+extern uint32_t g_sim_picc_spi_hz;       // SPI clock
+
+typedef struct {
+  uint32_t calls[UNI_SIM_PICC_OP_NUM];
+  uint32_t fails[UNI_SIM_PICC_OP_NUM];   // returned anything but success
+  uint32_t spi_xfers;
+  uint32_t spi_bytes;
+  int64_t usec;                          // simulated time in MFRC522 calls
+} uni_sim_picc_stats_t;
+extern uni_sim_picc_stats_t g_sim_picc_stats;
+
+#define UNI_SIM_PICC_FAULT_AUTH   0  // authenticate fails as with a wrong key: no answer, card halts
+#define UNI_SIM_PICC_FAULT_READ   1  // read answer has a bad CRC
+#define UNI_SIM_PICC_FAULT_WRITE  2  // write not ACKed
+#define UNI_SIM_PICC_FAULT_REMOVE 3  // card leaves the field just before an authenticate, read or write
+#define UNI_SIM_PICC_FAULT_NUM    4
+void uni_sim_picc_fault(uint8_t p_kind, int16_t p_block);      // once, at block p_block; -1 for whatever block is next
+void uni_sim_picc_fault_rate(uint8_t p_kind, uint16_t p_per_mille, uint32_t p_seed); // on each operation at random
+void uni_sim_picc_faults_clear();
+void uni_sim_picc_stats_clear();
+
+void uni_sim_card_put(const char * p_text);                    // lay a card with p_text on it on the reader
+void uni_sim_card_put_blank();                                 // lay a new card (zero data, factory keys) on the reader
+void uni_sim_card_remove();                                    // take the card away
+uint16_t uni_sim_card_text(char * p_text, uint16_t p_text_max); // the data blocks as one string; returns length
+
+// LittleFS
+typedef struct {
+  uint32_t writes;       // File::write() calls
+  uint32_t bytes;        // bytes in them
+  uint32_t writes_air;   // writes while a message was waiting for its send callback
+  int64_t usec;          // simulated time in them
+} uni_sim_fs_stats_t;
+extern uni_sim_fs_stats_t g_sim_fs;
+extern uint32_t g_sim_fs_write_usec; // one write to flash: program the page and update the metadata
+
+#endif // UNI_SIM_H
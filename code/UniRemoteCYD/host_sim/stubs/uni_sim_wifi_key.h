@@ -0,0 +1,4 @@
+/* host_sim stand-in for code/wifi_key.h; the simulation never connects to a router */
+#define WIFI_SSID "host_sim"
+#define WIFI_PWD "host_sim"
+#define WIFI_OTA_ESP_NOW_PWD "host_sim"
@@ -0,0 +1,321 @@
+/* Author: https://github.com/Mark-MDO47  Mar. 8, 2025
+ *  https://github.com/Mark-MDO47/UniRemote
+ */
+
+/*
+   Copyright 2025 Mark Olson
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * uni_sim.cpp - run the UniRemoteCYD sketch on the host: scripted scenarios and a throughput benchmark
+ *
+ *    uni_sim [-v] script.txt      # run a scenario; exit status 1 if any "expect" failed
+ *    uni_sim [-v] -               # scenario from stdin
+ *    uni_sim [-v] --bench N [--view] # N commands: card, (GO,) callback; report commands/sec and each state change
+ *
+ * The sketch is the real UniRemoteCYD.ino made into C++ by uni_sim_sketch.py; everything it calls
+ *    outside itself is a stand-in in stubs/ (see stubs/uni_sim.h for the simulated world).
+ *    See README.md in this directory for the script commands.
+ */
+
+#include "build/UniRemoteCYD_sim.cpp"  // the sketch; run uni_sim_sketch.py first
+#include "uni_sim.h"
+
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+#define UNI_SIM_LINE_MAX 300         // longest script line
+#define UNI_SIM_RUN_MAX_MSEC 60000   // longest any one wait for a state in --bench
+
+static const char * g_sim_state_names[UNI_STATE_NUM] = { "WAIT_CMD", "CMD_SEEN", "SENDING_CMD", "WAIT_CB", "SHOW_STAT" };
+static const char * g_sim_button_names[ACTION_BUTTON_NUM] = { "LEFT", "MID", "RIGHT" };
+
+// each change of g_uni_state seen across one loop()
+typedef struct {
+  uint32_t num;
+  std::vector<double> wall_usec;  // wall time of the loop() that made the change
+  double sim_usec_sum;            // simulated time spent in the "from" state
+} uni_sim_transition_t;
+static uni_sim_transition_t g_sim_transitions[UNI_STATE_NUM][UNI_STATE_NUM];
+static int64_t g_sim_usec_state_start = 0; // when g_uni_state last changed
+static uint64_t g_sim_loop_num = 0;
+static double g_sim_loop_wall_usec = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_sim_wall_usec() - host wall clock in usec
+//       returns: usec
+//
+static double uni_sim_wall_usec() {
+  return(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now().time_since_epoch()).count());
+} // end uni_sim_wall_usec()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_sim_loop() - one loop() of the sketch, noting the time and any change of state
+//       returns: nothing
+//
+static void uni_sim_loop() {
+  uint8_t state_from = g_uni_state;
+  double wall_start = uni_sim_wall_usec();
+  loop();
+  double wall_usec = uni_sim_wall_usec() - wall_start;
+  g_sim_loop_num += 1;
+  g_sim_loop_wall_usec += wall_usec;
+  if ((state_from != g_uni_state) && (state_from < UNI_STATE_NUM) && (g_uni_state < UNI_STATE_NUM)) {
+    uni_sim_transition_t * tr_ptr = &g_sim_transitions[state_from][g_uni_state];
+    tr_ptr->num += 1;
+    tr_ptr->wall_usec.push_back(wall_usec);
+    tr_ptr->sim_usec_sum += (double) (g_sim_usec - g_sim_usec_state_start);
+    g_sim_usec_state_start = g_sim_usec;
+  }
+} // end uni_sim_loop()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_sim_run_msec() - run loop() until p_msec of simulated time has passed
+//       returns: nothing
+//
+static void uni_sim_run_msec(uint32_t p_msec) {
+  int64_t usec_end = g_sim_usec + (int64_t) p_msec * 1000;
+  while (g_sim_usec < usec_end) uni_sim_loop();
+} // end uni_sim_run_msec()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_sim_touch() - press a button the way LVGL would report it
+//       returns: nothing
+//
+static void uni_sim_touch(uint8_t p_btn_idx, uint8_t p_long) {
+  lv_obj_t * button = g_action_buttons[p_btn_idx].button;
+  uni_sim_lv_send_event(button, LV_EVENT_PRESSED);
+  if (0 != p_long) uni_sim_lv_send_event(button, LV_EVENT_LONG_PRESSED);
+  uni_sim_lv_send_event(button, LV_EVENT_RELEASED);
+  uni_sim_lv_send_event(button, LV_EVENT_CLICKED);
+} // end uni_sim_touch()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_sim_name_idx() - index of p_name in p_names[]
+//       returns: index, or -1 if not there
+//
+static int16_t uni_sim_name_idx(const char * p_name, const char ** p_names, int16_t p_num) {
+  for (int16_t idx = 0; idx < p_num; idx++) {
+    if (0 == strcmp(p_name, p_names[idx])) return(idx);
+  }
+  return(-1);
+} // end uni_sim_name_idx()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_sim_mac_parse() - "XX:XX:XX:XX:XX:XX" to six bytes
+//       returns: zero if OK
+//
+static int16_t uni_sim_mac_parse(const char * p_text, uint8_t * p_mac_addr) {
+  unsigned int vals[ESP_NOW_ETH_ALEN];
+  if (ESP_NOW_ETH_ALEN != sscanf(p_text, "%x:%x:%x:%x:%x:%x", &vals[0], &vals[1], &vals[2], &vals[3], &vals[4], &vals[5])) return(-1);
+  for (int16_t idx = 0; idx < ESP_NOW_ETH_ALEN; idx++) p_mac_addr[idx] = (uint8_t) vals[idx];
+  return(0);
+} // end uni_sim_mac_parse()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_sim_print() - where the simulation is
+//       returns: nothing
+//
+static void uni_sim_print() {
+  printf("SIM msec %lu state %s channel %d sent cmd %u ok %u probe %u ctrl %u cb %u loops %llu\n",
+    millis(), g_sim_state_names[g_uni_state], g_sim_channel, g_sim_radio.cmd_num, g_sim_radio.cmd_ok_num,
+    g_sim_radio.probe_num, g_sim_radio.ctrl_num, g_sim_radio.cb_num, (unsigned long long) g_sim_loop_num);
+  printf("SIM status %s\n", uni_status_text(UNI_STATUS_RESULT));
+} // end uni_sim_print()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_sim_script_line() - do one line of a script
+//       returns: zero if OK; non-zero if an expect failed or the line is wrong
+//
+static int16_t uni_sim_script_line(char * p_line, int p_line_num) {
+  char rest[UNI_SIM_LINE_MAX+1]; // the line after the command word, as written; for card and serial
+  char * rest_ptr = p_line + strspn(p_line, " \t");
+  rest_ptr += strcspn(rest_ptr, " \t\r\n");
+  rest_ptr += strspn(rest_ptr, " \t");
+  snprintf(rest, sizeof(rest), "%.*s", (int) strcspn(rest_ptr, "\r\n"), rest_ptr);
+
+  char * cmd = strtok(p_line, " \t\r\n");
+  char * arg1;
+  char * arg2;
+  if ((nullptr == cmd) || ('#' == cmd[0])) return(0);
+  arg1 = strtok(nullptr, " \t\r\n");
+  arg2 = strtok(nullptr, " \t\r\n");
+
+  if ((0 == strcmp(cmd, "receiver")) && (nullptr != arg1)) {
+    uint8_t mac_addr[ESP_NOW_ETH_ALEN];
+    char * arg3 = strtok(nullptr, " \t\r\n");
+    uint8_t channel = ((nullptr != arg2) && (0 == strcmp(arg2, "channel")) && (nullptr != arg3)) ? (uint8_t) atoi(arg3) : g_sim_channel;
+    if ((0 == uni_sim_mac_parse(arg1, mac_addr)) && (0 == uni_sim_rcvr_add(mac_addr, channel))) return(0);
+  } else if ((0 == strcmp(cmd, "card")) && (nullptr != arg1)) {
+    uni_sim_card_put(rest);
+    return(0);
+  } else if ((0 == strcmp(cmd, "touch")) && (nullptr != arg1)) {
+    int16_t btn_idx = uni_sim_name_idx(arg1, g_sim_button_names, ACTION_BUTTON_NUM);
+    if (btn_idx >= 0) {
+      uni_sim_touch((uint8_t) btn_idx, ((nullptr != arg2) && (0 == strcmp(arg2, "long"))) ? 1 : 0);
+      return(0);
+    }
+  } else if ((0 == strcmp(cmd, "cb")) && (nullptr != arg1)) {
+    if (0 == strcmp(arg1, "ok"))   { uni_sim_radio_next(UNI_SIM_NEXT_OK);   return(0); }
+    if (0 == strcmp(arg1, "fail")) { uni_sim_radio_next(UNI_SIM_NEXT_FAIL); return(0); }
+  } else if ((0 == strcmp(cmd, "air")) && (nullptr != arg1)) {
+    g_sim_air_usec = (uint32_t) atol(arg1);
+    return(0);
+  } else if ((0 == strcmp(cmd, "run")) && (nullptr != arg1)) {
+    uni_sim_run_msec((uint32_t) atol(arg1));
+    return(0);
+  } else if ((0 == strcmp(cmd, "serial")) && (nullptr != arg1)) {
+    static char serial_line[UNI_SIM_LINE_MAX+2];
+    snprintf(serial_line, sizeof(serial_line), "%s\n", rest);
+    g_sim_serial_in = serial_line;
+    uni_sim_loop(); // loop() reads it
+    return(0);
+  } else if (0 == strcmp(cmd, "print")) {
+    uni_sim_print();
+    return(0);
+  } else if ((0 == strcmp(cmd, "expect")) && (nullptr != arg1) && (nullptr != arg2)) {
+    if (0 == strcmp(arg1, "state")) {
+      int16_t state = uni_sim_name_idx(arg2, g_sim_state_names, UNI_STATE_NUM);
+      if (state == g_uni_state) return(0);
+      printf("FAIL line %d: expect state %s, is %s\n", p_line_num, arg2, g_sim_state_names[g_uni_state]);
+      return(1);
+    }
+    if ((0 == strcmp(arg1, "sent")) || (0 == strcmp(arg1, "ok")) || (0 == strcmp(arg1, "probes"))) {
+      uint32_t num = (0 == strcmp(arg1, "sent")) ? g_sim_radio.cmd_num : ((0 == strcmp(arg1, "ok")) ? g_sim_radio.cmd_ok_num : g_sim_radio.probe_num);
+      if (num == (uint32_t) atol(arg2)) return(0);
+      printf("FAIL line %d: expect %s %s, is %u\n", p_line_num, arg1, arg2, num);
+      return(1);
+    }
+  }
+  printf("FAIL line %d: do not understand \"%s %s %s\"\n", p_line_num, cmd, (nullptr != arg1) ? arg1 : "", (nullptr != arg2) ? arg2 : "");
+  return(1);
+} // end uni_sim_script_line()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_sim_script() - do every line of a script
+//       returns: number of failures
+//
+static int uni_sim_script(FILE * p_file) {
+  char line[UNI_SIM_LINE_MAX+1];
+  int line_num = 0;
+  int fail_num = 0;
+  while (nullptr != fgets(line, sizeof(line), p_file)) {
+    line_num += 1;
+    fail_num += uni_sim_script_line(line, line_num);
+  }
+  printf("SIM %d lines, %d failed\n", line_num, fail_num);
+  return(fail_num);
+} // end uni_sim_script()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_sim_percentile() - p_pct percentile of p_vals (sorts them)
+//       returns: value
+//
+static double uni_sim_percentile(std::vector<double> & p_vals, double p_pct) {
+  if (p_vals.empty()) return(0);
+  std::sort(p_vals.begin(), p_vals.end());
+  size_t idx = (size_t) ((p_pct / 100.0) * (double) (p_vals.size() - 1) + 0.5);
+  return(p_vals[idx]);
+} // end uni_sim_percentile()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_sim_bench() - p_num commands end to end: card on reader, GO if viewing first, send callback
+//       returns: zero if every command got through
+//
+// the card hold-off in uni_read_picc() and UNI_ESP_NOW_MSEC_PER_MSG_MIN set the simulated rate;
+//    the wall rate is how fast the host runs the sketch's own code
+//
+static int uni_sim_bench(uint32_t p_num, uint8_t p_view) {
+  static const uint8_t mac_addr[ESP_NOW_ETH_ALEN] = { 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC };
+  uni_sim_rcvr_add(mac_addr, g_sim_channel);
+  g_change_send_no_view = (0 != p_view) ? 0 : 1;
+
+  uint64_t loop_num_start = g_sim_loop_num;
+  double loop_wall_start = g_sim_loop_wall_usec;
+  int64_t sim_usec_start = g_sim_usec;
+  double wall_start = uni_sim_wall_usec();
+  uni_sim_fs_stats_t fs_start = g_sim_fs;
+  uint32_t done_num = 0;
+  for (uint32_t cmd_idx = 0; cmd_idx < p_num; cmd_idx++) {
+    uint32_t cmd_num = g_sim_radio.cmd_num;
+    int64_t usec_end = g_sim_usec + (int64_t) UNI_SIM_RUN_MAX_MSEC * 1000;
+    uni_sim_card_put("12:34:56:78:9A:BC|LED:ON");
+    // done when it was sent, its callback reported and we are waiting for the next one
+    while (((cmd_num == g_sim_radio.cmd_num) || (0 != uni_in_flight_num()) || (UNI_STATE_WAIT_CMD != g_uni_state)) &&
+           (g_sim_usec < usec_end)) {
+      if ((UNI_STATE_CMD_SEEN == g_uni_state) && (0 == g_button_press.pressed)) uni_sim_touch(ACTION_BUTTON_LEFT, 0);
+      uni_sim_loop();
+    }
+    if (g_sim_usec >= usec_end) break;
+    done_num += 1;
+  }
+  double wall_usec = uni_sim_wall_usec() - wall_start;
+  double sim_sec = (double) (g_sim_usec - sim_usec_start) / 1e6;
+  uint64_t loop_num = g_sim_loop_num - loop_num_start;
+
+  printf("BENCH commands %u of %u (%s), sent %u ok %u\n", done_num, p_num, (0 != p_view) ? "view, then GO" : "send at once",
+    g_sim_radio.cmd_num, g_sim_radio.cmd_ok_num);
+  printf("BENCH wall %.1f commands/sec, %.1f loops/command, %.2f usec/loop (sketch only %.2f)\n",
+    (wall_usec > 0) ? done_num * 1e6 / wall_usec : 0, done_num ? (double) loop_num / done_num : 0,
+    loop_num ? wall_usec / loop_num : 0, loop_num ? (g_sim_loop_wall_usec - loop_wall_start) / loop_num : 0);
+  printf("BENCH simulated %.3f commands/sec over %.1f sec\n", (sim_sec > 0) ? done_num / sim_sec : 0, sim_sec);
+  uint32_t fs_writes = g_sim_fs.writes - fs_start.writes;
+  printf("BENCH flash %u writes, %.3f writes/command, %.1f bytes/command, %.3f sim msec/command, %u with a message in the air\n",
+    fs_writes, done_num ? (double) fs_writes / done_num : 0, done_num ? (double) (g_sim_fs.bytes - fs_start.bytes) / done_num : 0,
+    done_num ? (double) (g_sim_fs.usec - fs_start.usec) / 1000 / done_num : 0, g_sim_fs.writes_air - fs_start.writes_air);
+  printf("BENCH %-24s %8s %10s %10s %10s %12s\n", "transition", "count", "avg_usec", "p50_usec", "p99_usec", "sim_msec_avg");
+  for (uint8_t from = 0; from < UNI_STATE_NUM; from++) {
+    for (uint8_t to = 0; to < UNI_STATE_NUM; to++) {
+      uni_sim_transition_t * tr_ptr = &g_sim_transitions[from][to];
+      if (0 == tr_ptr->num) continue;
+      double sum = 0;
+      for (double val : tr_ptr->wall_usec) sum += val;
+      char name[32];
+      snprintf(name, sizeof(name), "%s->%s", g_sim_state_names[from], g_sim_state_names[to]);
+      printf("BENCH %-24s %8u %10.2f %10.2f %10.2f %12.2f\n", name, tr_ptr->num, sum / tr_ptr->num,
+        uni_sim_percentile(tr_ptr->wall_usec, 50), uni_sim_percentile(tr_ptr->wall_usec, 99), tr_ptr->sim_usec_sum / tr_ptr->num / 1000);
+    }
+  }
+  return((done_num == p_num) ? 0 : 1);
+} // end uni_sim_bench()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// main
+//
+int main(int argc, char ** argv) {
+  int arg_idx = 1;
+  if ((arg_idx < argc) && (0 == strcmp(argv[arg_idx], "-v"))) { g_sim_verbose = 1; arg_idx += 1; }
+  if (arg_idx >= argc) {
+    fprintf(stderr, "usage: %s [-v] script.txt | - | --bench N [--view]\n", argv[0]);
+    return(2);
+  }
+
+  setup();
+  g_sim_usec_state_start = g_sim_usec;
+  if (0 == strcmp(argv[arg_idx], "--bench")) {
+    uint32_t num = ((arg_idx+1) < argc) ? (uint32_t) atol(argv[arg_idx+1]) : 1000;
+    uint8_t view = (((arg_idx+2) < argc) && (0 == strcmp(argv[arg_idx+2], "--view"))) ? 1 : 0;
+    return(uni_sim_bench(num, view));
+  }
+  FILE * script = (0 == strcmp(argv[arg_idx], "-")) ? stdin : fopen(argv[arg_idx], "r");
+  if (nullptr == script) {
+    fprintf(stderr, "cannot open %s\n", argv[arg_idx]);
+    return(2);
+  }
+  int fail_num = uni_sim_script(script);
+  if (stdin != script) fclose(script);
+  return((0 == fail_num) ? 0 : 1);
+} // end main()
@@ -0,0 +1,344 @@
+/* Author: https://github.com/Mark-MDO47  Mar. 9, 2025
+ *  https://github.com/Mark-MDO47/UniRemote
+ */
+
+/*
+   Copyright 2025 Mark Olson
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * uni_sim_cmd_parse.cpp - fuzz UniRemoteCmdParse.h against the parsing UniRemoteCYD used to do, and time both
+ *
+ *    uni_sim_cmd_parse --fuzz N [SEED]   # N random commands; exit status 1 if the two ever disagree
+ *    uni_sim_cmd_parse --bench N         # N times each over typical commands; nsec per call for each
+ *
+ * The "old" functions are the ones UniRemoteCYD.ino had before UniRemoteCmdParse.h, as they were except:
+ *    - the alias lookup in the receiver directory is left out; only the parse is compared.
+ *    - old_str_trim() does not look before the start of a piece that is all tabs and spaces (it did).
+ *    - old_str_display_cmd() still appends with sprintf() onto its own destination. That overlap is
+ *      undefined behavior; glibc happens to get it right, which is all the comparison needs.
+ *
+ * The fuzzer makes commands out of the characters that matter to the format (hex digits, ':', '|',
+ *    ';', '@', tabs and spaces, bytes over 0x7F) and also damages good commands one char at a time.
+ *    uni_cmd_display() is also run into buffers too small for the result: it must stop at the end and
+ *    give the start of what it would have given.
+ */
+
+#include <Arduino.h>
+#include <esp_now.h>
+#include "../../UniRemoteRcvrTemplate/UniRemoteCmdParse.h"
+
+#include <chrono>
+
+#define UNI_SIM_ALIAS_LEN 2      // UNI_FRAME_ANNOUNCE_ALIAS_LEN
+#define UNI_SIM_MSG_SIZE 1025    // g_msg in UniRemoteCYD.ino
+
+#pragma GCC diagnostic ignored "-Wrestrict"   // old_str_display_cmd(), on purpose
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// the old parsing, from UniRemoteCYD.ino
+//
+static uint16_t g_cmd_decode_addr_len;
+static uint32_t g_cmd_exec_lead_msec;
+
+char* old_str_trim(char* p_str) {
+  char* my_str = p_str;
+  while ((' ' == my_str[0]) || ('\t' == my_str[0])) {
+    my_str += 1;
+  }
+  size_t my_len = strlen(my_str);
+  while ((my_len > 0) && ((' ' == my_str[my_len - 1]) || ('\t' == my_str[my_len - 1]))) {
+    my_len -= 1;
+    my_str[my_len] = 0;
+  }
+  return(my_str);
+} // end old_str_trim()
+
+void old_str_display_cmd(char* p_msg_str, char* p_cmd, const char* p_insert_words) {
+  char delimiters[] = ";";
+  char* token;
+  const char* my_insert_word = p_insert_words;
+  static char tmp_msg[ESP_NOW_MAX_DATA_LEN + 1];
+
+  if('\0' == p_cmd[0]) return;
+  strncpy(tmp_msg, p_cmd, ESP_NOW_MAX_DATA_LEN);
+
+  token = strtok(tmp_msg, delimiters);
+  if (token == NULL) { sprintf(p_msg_str, "%s\n\n%sERROR no command found", p_msg_str, p_insert_words);  return; }
+  while (token != NULL) {
+    sprintf(p_msg_str, "%s\n%s%s", p_msg_str, my_insert_word, old_str_trim(token));
+    my_insert_word = "";
+    token = strtok(NULL, delimiters);
+  } // end while
+  return;
+}   // end old_str_display_cmd()
+
+// the alias test that was at the top of uni_cmd_decode_get_mac_addr(); returns alias_len or 0
+uint16_t old_cmd_decode_alias(char * p_cmd, char * p_alias) {
+  uint16_t alias_len = 0;
+  while ((alias_len < UNI_SIM_ALIAS_LEN) && isAlphaNumeric(p_cmd[alias_len])) alias_len += 1;
+  if ((alias_len > 0) && ('|' == p_cmd[alias_len]) && ('\0' != p_cmd[alias_len+1])) {
+    memcpy(p_alias, p_cmd, alias_len);
+    p_alias[alias_len] = '\0';
+    return(alias_len);
+  }
+  return(0);
+} // end old_cmd_decode_alias()
+
+static uint8_t cmd_decode_mac_addr[ESP_NOW_ETH_ALEN];
+uint8_t * old_cmd_decode_get_mac_addr(char * p_cmd) {
+  uint8_t * ret_addr = cmd_decode_mac_addr;
+  uint8_t tmp;
+
+  g_cmd_decode_addr_len = 3*ESP_NOW_ETH_ALEN;
+  // make sure MAC address is of the correct form and decode piece by piece
+  if ((3*ESP_NOW_ETH_ALEN+1) > strlen(p_cmd)) {
+    ret_addr = ((uint8_t *) 0);
+  } else { // at least one character after MAC address
+    for (int i = 0; i < 3*ESP_NOW_ETH_ALEN; i += 3) {
+      if (!isHexadecimalDigit(p_cmd[i]) || !isHexadecimalDigit(p_cmd[i+1])) {
+        ret_addr = ((uint8_t *) 0);
+        break;
+      }
+      tmp = 0;
+      if ( ((3*(ESP_NOW_ETH_ALEN-1) != i) && (':' != p_cmd[i+2])) ||
+           ((3*(ESP_NOW_ETH_ALEN-1) == i) && ('|' != p_cmd[i+2])) ) {
+        ret_addr = ((uint8_t *) 0);
+        break;
+      }
+      // these two hex digits are good
+      for (int j = 0; j < 2; j += 1) {
+        tmp <<= 4;
+        if      (p_cmd[i+j] <= '9') tmp |= p_cmd[i+j] - '0';
+        else if (p_cmd[i+j] <= 'F') tmp |= p_cmd[i+j] - 'A' + 10;
+        else                          tmp |= p_cmd[i+j] - 'a' + 10;
+      }
+      ret_addr[i/3] = tmp;
+    } // end check MAC address
+  }
+  return(ret_addr);
+} // old_cmd_decode_get_mac_addr
+
+uint16_t old_cmd_decode_exec_lead(char * p_cmd) {
+  uint16_t idx = g_cmd_decode_addr_len;
+  uint32_t msec = 0;
+
+  g_cmd_exec_lead_msec = 0;
+  if ('@' != p_cmd[idx]) return(g_cmd_decode_addr_len); // no lead time
+  for (idx += 1; isDigit(p_cmd[idx]); idx += 1) {
+    msec = msec*10 + (p_cmd[idx] - '0');
+  }
+  if (('|' != p_cmd[idx]) || (0 == msec)) return(g_cmd_decode_addr_len); // not a lead time; send it all as the command
+  g_cmd_exec_lead_msec = msec;
+  return(idx+1);
+} // end old_cmd_decode_exec_lead()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// fuzzing
+//
+static uint32_t g_fuzz_seed = 1;
+
+static uint32_t uni_fuzz_rand(uint32_t p_num) {
+  g_fuzz_seed = g_fuzz_seed * 1103515245UL + 12345UL;
+  return(((g_fuzz_seed >> 8) & 0xFFFFFF) % p_num);
+} // end uni_fuzz_rand()
+
+static const char * g_fuzz_good[] = {
+  "74:4d:bd:11:22:33|LED:ON",
+  "FF:FF:FF:FF:FF:FF|@500|LED:ON",
+  "ec:DA:3b:5c:8f:00|  LED:ON ;\tMP3:PLAY 3;;VOL:20  ",
+  "K2|LED:OFF",
+  "7|@1500|OTA:WEB",
+  "ab:cd:ef:01:23:45|;",
+};
+#define UNI_FUZZ_GOOD_NUM (sizeof(g_fuzz_good)/sizeof(g_fuzz_good[0]))
+static const char g_fuzz_chars[] = "0123456789abcdefABCDEFxyzKZ:|;@ \t";
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_fuzz_make() - a random command into p_cmd
+//
+static void uni_fuzz_make(char * p_cmd) {
+  uint16_t len;
+  if (0 == uni_fuzz_rand(2)) {
+    // damage a good one
+    strcpy(p_cmd, g_fuzz_good[uni_fuzz_rand(UNI_FUZZ_GOOD_NUM)]);
+    len = strlen(p_cmd);
+    for (uint32_t num = 1 + uni_fuzz_rand(3); num > 0; num--) {
+      uint16_t idx = uni_fuzz_rand(len + 1);
+      switch (uni_fuzz_rand(4)) {
+        case 0:  p_cmd[idx] = g_fuzz_chars[uni_fuzz_rand(sizeof(g_fuzz_chars)-1)]; break;
+        case 1:  p_cmd[idx] = (char) (0x80 + uni_fuzz_rand(0x80)); break;
+        case 2:  p_cmd[idx] = '\0'; break; // cut short
+        default: p_cmd[idx] = ';'; break;
+      }
+      if (idx == len) p_cmd[idx+1] = '\0';
+      len = strlen(p_cmd);
+    }
+  } else {
+    // made up; sometimes longer than ESP-NOW allows
+    len = uni_fuzz_rand((0 == uni_fuzz_rand(8)) ? 400 : 40);
+    for (uint16_t idx = 0; idx < len; idx++) {
+      p_cmd[idx] = (0 == uni_fuzz_rand(16)) ? (char) (0x80 + uni_fuzz_rand(0x80)) : g_fuzz_chars[uni_fuzz_rand(sizeof(g_fuzz_chars)-1)];
+    }
+    p_cmd[len] = '\0';
+  }
+} // end uni_fuzz_make()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_fuzz_one() - old and new on p_cmd
+//       returns: zero if they agree
+//
+static int uni_fuzz_one(char * p_cmd) {
+  static char old_msg[UNI_SIM_MSG_SIZE * 2];
+  static char new_msg[UNI_SIM_MSG_SIZE * 2];
+  static char cut_msg[UNI_SIM_MSG_SIZE];
+  char old_alias[UNI_SIM_ALIAS_LEN+1];
+  char new_alias[UNI_SIM_ALIAS_LEN+1];
+  uint8_t new_mac[ESP_NOW_ETH_ALEN];
+  const char * wrong = nullptr;
+
+  // alias, else MAC address; then the lead time
+  uint16_t old_alias_len = old_cmd_decode_alias(p_cmd, old_alias);
+  uint16_t new_alias_len = uni_cmd_parse_alias(p_cmd, new_alias, UNI_SIM_ALIAS_LEN);
+  if ((old_alias_len != new_alias_len) || ((0 != old_alias_len) && (0 != strcmp(old_alias, new_alias)))) wrong = "alias";
+  uint8_t * old_mac = old_cmd_decode_get_mac_addr(p_cmd);
+  int16_t new_idx = uni_cmd_parse_mac(p_cmd, new_mac);
+  if ((nullptr == old_mac) != (UNI_CMD_PARSE_NONE == new_idx)) wrong = "mac";
+  else if ((nullptr != old_mac) && ((UNI_CMD_PARSE_MAC_LEN != new_idx) || (0 != memcmp(old_mac, new_mac, ESP_NOW_ETH_ALEN)))) wrong = "mac bytes";
+  if ((0 != old_alias_len) || (nullptr != old_mac)) {
+    g_cmd_decode_addr_len = (0 != old_alias_len) ? (old_alias_len+1) : UNI_CMD_PARSE_MAC_LEN;
+    uint32_t new_msec;
+    uint16_t new_lead = uni_cmd_parse_exec_lead(p_cmd, g_cmd_decode_addr_len, &new_msec);
+    uint16_t old_lead = old_cmd_decode_exec_lead(p_cmd);
+    if ((old_lead != new_lead) || (g_cmd_exec_lead_msec != new_msec)) wrong = "lead";
+  }
+
+  // the screen display, after some text already there
+  const char * before = (0 == uni_fuzz_rand(2)) ? "Send or Clear Command" : "";
+  const char * insert = (0 == uni_fuzz_rand(4)) ? "" : "This CMD: ";
+  strcpy(old_msg, before);
+  strcpy(new_msg, before);
+  old_str_display_cmd(old_msg, p_cmd, insert);
+  uint16_t new_len = uni_cmd_display(new_msg, UNI_SIM_MSG_SIZE, p_cmd, insert);
+  if ((0 != strcmp(old_msg, new_msg)) || (strlen(new_msg) != new_len)) wrong = "display";
+  // too small for it: must stop at the end with the start of the same text
+  uint16_t cut_size = 1 + uni_fuzz_rand(strlen(new_msg) + 1);
+  memset(cut_msg, 0x5A, sizeof(cut_msg));
+  strncpy(cut_msg, before, cut_size);
+  cut_msg[cut_size-1] = '\0';
+  uint16_t cut_len = uni_cmd_display(cut_msg, cut_size, p_cmd, insert);
+  if ((cut_len >= cut_size) || (0 != strncmp(cut_msg, new_msg, cut_len)) || ('\0' != cut_msg[cut_len]) ||
+      ((cut_size < sizeof(cut_msg)) && (0x5A != (uint8_t) cut_msg[cut_size]))) wrong = "display cut short";
+
+  if (nullptr != wrong) {
+    printf("FUZZ %s differs for |", wrong);
+    for (uint16_t idx = 0; '\0' != p_cmd[idx]; idx++) {
+      if ((p_cmd[idx] < ' ') || ((uint8_t) p_cmd[idx] > 0x7E)) printf("\\x%02x", (uint8_t) p_cmd[idx]);
+      else putchar(p_cmd[idx]);
+    }
+    printf("|\n");
+    return(1);
+  }
+  return(0);
+} // end uni_fuzz_one()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_fuzz() - p_num random commands
+//       returns: number that differed
+//
+static uint32_t uni_fuzz(uint32_t p_num, uint32_t p_seed) {
+  static char cmd[512];
+  uint32_t fail_num = 0;
+  g_fuzz_seed = p_seed;
+  for (uint32_t num = 0; num < p_num; num++) {
+    uni_fuzz_make(cmd);
+    fail_num += uni_fuzz_one(cmd);
+    if (fail_num > 20) break;
+  }
+  printf("FUZZ %u commands, seed %u, %u differ\n", p_num, p_seed, fail_num);
+  return(fail_num);
+} // end uni_fuzz()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// benchmark
+//
+static volatile uint32_t g_bench_sink; // so the compiler keeps the calls
+
+static char g_bench_cmds[][ESP_NOW_MAX_DATA_LEN] = {
+  "74:4d:bd:11:22:33|LED:ON",
+  "FF:FF:FF:FF:FF:FF|@500|LED:ON",
+  "ec:da:3b:5c:8f:00|LED:ON;MP3:PLAY 3;VOL:20;PATTERN:RAINBOW;DELAY:100;MP3:PLAY 4;VOL:25;LED:OFF",
+};
+#define UNI_BENCH_CMD_NUM (sizeof(g_bench_cmds)/sizeof(g_bench_cmds[0]))
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_bench_nsec() - nsec for one of p_num repeats of p_fn
+//
+template<class F> static double uni_bench_nsec(uint32_t p_num, F p_fn) {
+  auto wall_start = std::chrono::steady_clock::now();
+  for (uint32_t num = 0; num < p_num; num++) p_fn();
+  auto wall_end = std::chrono::steady_clock::now();
+  return(std::chrono::duration<double, std::nano>(wall_end - wall_start).count() / p_num);
+} // end uni_bench_nsec()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_bench() - old and new, each command p_num times
+//
+static void uni_bench(uint32_t p_num) {
+  static char msg[UNI_SIM_MSG_SIZE];
+  uint8_t mac[ESP_NOW_ETH_ALEN];
+  printf("BENCH %-10s %6s %12s %12s %8s\n", "function", "chars", "old_nsec", "new_nsec", "speedup");
+  for (uint16_t idx = 0; idx < UNI_BENCH_CMD_NUM; idx++) {
+    char * cmd = g_bench_cmds[idx];
+    double old_nsec = uni_bench_nsec(p_num, [&]() {
+      uint8_t * addr = old_cmd_decode_get_mac_addr(cmd);
+      g_bench_sink += (nullptr != addr) ? addr[5] : 0;
+      g_bench_sink += old_cmd_decode_exec_lead(cmd);
+    });
+    double new_nsec = uni_bench_nsec(p_num, [&]() {
+      uint32_t msec;
+      int16_t rest = uni_cmd_parse_mac(cmd, mac);
+      g_bench_sink += (UNI_CMD_PARSE_NONE != rest) ? mac[5] : 0;
+      g_bench_sink += uni_cmd_parse_exec_lead(cmd, UNI_CMD_PARSE_MAC_LEN, &msec);
+    });
+    printf("BENCH %-10s %6d %12.1f %12.1f %7.2fx\n", "mac+lead", (int) strlen(cmd), old_nsec, new_nsec, old_nsec / new_nsec);
+    old_nsec = uni_bench_nsec(p_num, [&]() {
+      strcpy(msg, "Send or Clear Command");
+      old_str_display_cmd(msg, cmd, "This CMD: ");
+      g_bench_sink += msg[30];
+    });
+    new_nsec = uni_bench_nsec(p_num, [&]() {
+      strcpy(msg, "Send or Clear Command");
+      g_bench_sink += uni_cmd_display(msg, sizeof(msg), cmd, "This CMD: ");
+    });
+    printf("BENCH %-10s %6d %12.1f %12.1f %7.2fx\n", "display", (int) strlen(cmd), old_nsec, new_nsec, old_nsec / new_nsec);
+  }
+} // end uni_bench()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// main
+//
+int main(int argc, char ** argv) {
+  if ((argc >= 3) && (argc <= 4) && (0 == strcmp(argv[1], "--fuzz"))) {
+    uint32_t seed = (4 == argc) ? (uint32_t) atol(argv[3]) : 1;
+    return((0 == uni_fuzz((uint32_t) atol(argv[2]), seed)) ? 0 : 1);
+  }
+  if ((3 == argc) && (0 == strcmp(argv[1], "--bench"))) {
+    uni_bench((uint32_t) atol(argv[2]));
+    return(0);
+  }
+  fprintf(stderr, "usage: %s --fuzz N [SEED]\n       %s --bench N\n", argv[0], argv[0]);
+  return(2);
+} // end main()
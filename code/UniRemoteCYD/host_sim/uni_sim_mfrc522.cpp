@@ -0,0 +1,305 @@
+/* Author: https://github.com/Mark-MDO47  Mar. 9, 2025
+ *  https://github.com/Mark-MDO47/UniRemote
+ */
+
+/*
+   Copyright 2025 Mark Olson
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * uni_sim_mfrc522.cpp - the MFRC522 and its MIFARE Classic 1K card for host_sim
+ *
+ * What each call costs (g_sim_picc_cost[]) was counted from the register accesses MFRC522v2 makes:
+ *    - a transceive (PCD_CommunicateWithPICC) is 7 register writes to start it plus 4 reads after;
+ *      the FIFO is one transfer however many bytes go through it
+ *    - a CRC_A (PCD_CalculateCRC) is 7 transfers plus 2 to read the result
+ *    - REQA, anticollision and select, authenticate, read, write and HLTA are made of those
+ * The times the card takes are typical of 106 kbit/s ISO 14443A with a MIFARE Classic EV1; the write
+ *    includes its EEPROM time. PCD_Init() sets the MFRC522 timer to 25 msec, so a card that does not
+ *    answer costs 25 msec, and so does every HLTA: success there is no answer.
+ * These are estimates to compare one way of reading the card with another, not to predict the CYD
+ *    to the microsecond. Change them from the driver if a logic analyzer says otherwise.
+ */
+
+#include "Arduino.h"
+#include "MFRC522v2.h"
+#include "uni_sim.h"
+
+const char * g_sim_picc_op_names[UNI_SIM_PICC_OP_NUM] = { "init", "reqa", "select", "auth", "read", "write", "halt", "stop_crypto" };
+
+uni_sim_picc_cost_t g_sim_picc_cost[UNI_SIM_PICC_OP_NUM] = {
+  { 50000, 12,  24 },  // init        - soft reset, then the library waits 50 msec; timer, ASK, antenna on
+  {   150, 16,  35 },  // reqa        - TxMode, RxMode, ModWidth; clear CollReg; 7-bit REQA, 2-byte ATQA
+  {   900, 42, 110 },  // select      - anticollision, then SELECT with CRC_A; CRC_A check of SAK
+  {  1200,  9,  34 },  // auth        - MFAuthent with 12 bytes: command, block, key, UID
+  {  1900, 29,  92 },  // read        - CRC_A; READ; 18 bytes back; CRC_A check of them
+  {  5800, 40, 110 },  // write       - CRC_A; WRITE, 4-bit ACK; CRC_A; 16 bytes, 4-bit ACK; EEPROM
+  { 25000, 20,  50 },  // halt        - CRC_A; HLTA and wait for no answer
+  {     0,  2,   4 },  // stop_crypto - read-modify-write of Status2Reg
+};
+uint32_t g_sim_picc_timeout_usec = 25000;
+uint32_t g_sim_picc_poll_usec = 20;
+uint32_t g_sim_picc_spi_hz = 4000000;
+uni_sim_picc_stats_t g_sim_picc_stats;
+uni_sim_card_t g_sim_card;
+
+#define UNI_SIM_PICC_FAULT_ONCE_NUM 8 // most faults waiting for their block
+
+static struct { uint8_t kind; int16_t block; } g_sim_picc_faults[UNI_SIM_PICC_FAULT_ONCE_NUM];
+static uint16_t g_sim_picc_fault_num = 0;
+static uint16_t g_sim_picc_fault_per_mille[UNI_SIM_PICC_FAULT_NUM];
+static uint32_t g_sim_picc_rand = 1;
+static uint8_t g_sim_card_uid_next = 1; // each card put on the reader gets a new UID
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_sim_picc_spend() - charge one MFRC522 call its time and SPI traffic
+//       returns: nothing
+//
+// p_answered zero: the card did not answer and the call waited for the timer
+//
+static void uni_sim_picc_spend(uint8_t p_op, uint8_t p_answered) {
+  const uni_sim_picc_cost_t * cost_ptr = &g_sim_picc_cost[p_op];
+  uint32_t usec_wait = (0 != p_answered) ? cost_ptr->usec_card : g_sim_picc_timeout_usec;
+  uint32_t polls = (UNI_SIM_PICC_OP_STOP_CRYPTO == p_op) ? 0 : 1 + usec_wait / g_sim_picc_poll_usec;
+  uint32_t spi_bytes = cost_ptr->spi_bytes + 2*polls;
+  int64_t usec = usec_wait + (int64_t) (cost_ptr->spi_bytes * 8) * 1000000 / g_sim_picc_spi_hz; // polls are during the wait
+
+  g_sim_picc_stats.calls[p_op] += 1;
+  g_sim_picc_stats.spi_xfers += cost_ptr->spi_xfers + polls;
+  g_sim_picc_stats.spi_bytes += spi_bytes;
+  g_sim_picc_stats.usec += usec;
+  uni_sim_advance_usec(usec);
+} // end uni_sim_picc_spend()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_sim_picc_fault_now() - see if a fault of kind p_kind happens now, on block p_block
+//       returns: non-zero if it does; a one-time fault is used up
+//
+static uint8_t uni_sim_picc_fault_now(uint8_t p_kind, uint8_t p_block) {
+  for (uint16_t idx = 0; idx < g_sim_picc_fault_num; idx++) {
+    if ((p_kind == g_sim_picc_faults[idx].kind) && ((g_sim_picc_faults[idx].block < 0) || (p_block == g_sim_picc_faults[idx].block))) {
+      g_sim_picc_fault_num -= 1;
+      g_sim_picc_faults[idx] = g_sim_picc_faults[g_sim_picc_fault_num];
+      return(1);
+    }
+  }
+  if (0 == g_sim_picc_fault_per_mille[p_kind]) return(0);
+  g_sim_picc_rand = g_sim_picc_rand * 1103515245 + 12345;
+  return((((g_sim_picc_rand >> 16) % 1000) < g_sim_picc_fault_per_mille[p_kind]) ? 1 : 0);
+} // end uni_sim_picc_fault_now()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_sim_picc_block_op() - what every authenticate, read and write does first
+//       returns: non-zero if the card is there and selected to answer
+//
+// a "remove" fault takes the card away here
+//
+static uint8_t uni_sim_picc_block_op(uint8_t p_block) {
+  if ((UNI_SIM_CARD_ABSENT != g_sim_card.state) && uni_sim_picc_fault_now(UNI_SIM_PICC_FAULT_REMOVE, p_block)) uni_sim_card_remove();
+  return((UNI_SIM_CARD_ACTIVE == g_sim_card.state) ? 1 : 0);
+} // end uni_sim_picc_block_op()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_sim_crc_a() - ISO 14443A CRC_A
+//       returns: CRC, low byte first on the air
+//
+static uint16_t uni_sim_crc_a(const uint8_t * p_data, uint16_t p_len) {
+  uint16_t crc = 0x6363;
+  for (uint16_t idx = 0; idx < p_len; idx++) {
+    uint8_t val = p_data[idx] ^ (uint8_t) (crc & 0xFF);
+    val ^= (uint8_t) (val << 4);
+    crc = (crc >> 8) ^ ((uint16_t) val << 8) ^ ((uint16_t) val << 3) ^ ((uint16_t) val >> 4);
+  }
+  return(crc);
+} // end uni_sim_crc_a()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// the MFRC522 calls
+//
+bool MFRC522::PCD_Init() {
+  uni_sim_picc_spend(UNI_SIM_PICC_OP_INIT, 1);
+  m_crypto1_on = 0;
+  return(true);
+} // end MFRC522::PCD_Init()
+
+bool MFRC522::PICC_IsNewCardPresent() {
+  uint8_t answered = (UNI_SIM_CARD_IDLE == g_sim_card.state) ? 1 : 0;
+  uni_sim_picc_spend(UNI_SIM_PICC_OP_REQA, answered);
+  if (0 == answered) { g_sim_picc_stats.fails[UNI_SIM_PICC_OP_REQA] += 1; return(false); }
+  g_sim_card.state = UNI_SIM_CARD_READY;
+  return(true);
+} // end MFRC522::PICC_IsNewCardPresent()
+
+bool MFRC522::PICC_ReadCardSerial() {
+  uint8_t answered = (UNI_SIM_CARD_READY == g_sim_card.state) ? 1 : 0;
+  uni_sim_picc_spend(UNI_SIM_PICC_OP_SELECT, answered);
+  if (0 == answered) { g_sim_picc_stats.fails[UNI_SIM_PICC_OP_SELECT] += 1; return(false); }
+  g_sim_card.state = UNI_SIM_CARD_ACTIVE;
+  g_sim_card.auth_sector = -1;
+  uid.size = sizeof(g_sim_card.uid);
+  memcpy(uid.uidByte, g_sim_card.uid, sizeof(g_sim_card.uid));
+  uid.sak = g_sim_card.sak;
+  return(true);
+} // end MFRC522::PICC_ReadCardSerial()
+
+MFRC522Constants::PICC_Type MFRC522::PICC_GetType(byte p_sak) {
+  return((0x08 == (p_sak & 0x7F)) ? MFRC522Constants::PICC_TYPE_MIFARE_1K : MFRC522Constants::PICC_TYPE_UNKNOWN);
+} // end MFRC522::PICC_GetType()
+
+MFRC522Constants::StatusCode MFRC522::PCD_Authenticate(MFRC522Constants::PICC_Command p_cmd, byte p_block, MIFARE_Key * p_key, Uid * p_uid) {
+  uint8_t answered = uni_sim_picc_block_op(p_block);
+  const uint8_t * trailer = g_sim_card.blocks[(p_block < UNI_SIM_CARD_BLOCKS) ? ((p_block & ~3) + 3) : 3];
+  const uint8_t * key = (MFRC522Constants::PICC_CMD_MF_AUTH_KEY_B == p_cmd) ? &trailer[10] : &trailer[0];
+  if ((0 != answered) && ((p_block >= UNI_SIM_CARD_BLOCKS) || (0 != memcmp(key, p_key->keyByte, 6)) ||
+                          (0 != memcmp(p_uid->uidByte, g_sim_card.uid, sizeof(g_sim_card.uid))) ||
+                          uni_sim_picc_fault_now(UNI_SIM_PICC_FAULT_AUTH, p_block))) {
+    answered = 0;
+    g_sim_card.state = UNI_SIM_CARD_IDLE; // a card that fails authentication goes back to idle and stays silent
+  }
+  uni_sim_picc_spend(UNI_SIM_PICC_OP_AUTH, answered);
+  if (0 == answered) { g_sim_picc_stats.fails[UNI_SIM_PICC_OP_AUTH] += 1; return(MFRC522Constants::STATUS_TIMEOUT); }
+  g_sim_card.auth_sector = (int8_t) (p_block / 4);
+  m_crypto1_on = 1;
+  return(MFRC522Constants::STATUS_OK);
+} // end MFRC522::PCD_Authenticate()
+
+MFRC522Constants::StatusCode MFRC522::MIFARE_Read(byte p_block, byte * p_buf, byte * p_size) {
+  if ((nullptr == p_buf) || (*p_size < 18)) { g_sim_picc_stats.fails[UNI_SIM_PICC_OP_READ] += 1; return(MFRC522Constants::STATUS_NO_ROOM); }
+  uint8_t answered = uni_sim_picc_block_op(p_block);
+  uni_sim_picc_spend(UNI_SIM_PICC_OP_READ, answered);
+  if (0 == answered) { g_sim_picc_stats.fails[UNI_SIM_PICC_OP_READ] += 1; return(MFRC522Constants::STATUS_TIMEOUT); }
+  if ((p_block >= UNI_SIM_CARD_BLOCKS) || ((p_block / 4) != g_sim_card.auth_sector)) {
+    g_sim_picc_stats.fails[UNI_SIM_PICC_OP_READ] += 1;
+    g_sim_card.state = UNI_SIM_CARD_IDLE; // NAK, then idle
+    return(MFRC522Constants::STATUS_MIFARE_NACK);
+  }
+  memcpy(p_buf, g_sim_card.blocks[p_block], UNI_SIM_CARD_BLOCK_BYTES);
+  if (3 == (p_block % 4)) memset(p_buf, 0, 6); // key A never reads back
+  uint16_t crc = uni_sim_crc_a(p_buf, UNI_SIM_CARD_BLOCK_BYTES);
+  p_buf[16] = (byte) (crc & 0xFF);
+  p_buf[17] = (byte) (crc >> 8);
+  *p_size = 18;
+  if (uni_sim_picc_fault_now(UNI_SIM_PICC_FAULT_READ, p_block)) {
+    p_buf[17] ^= 0x5A;
+    g_sim_picc_stats.fails[UNI_SIM_PICC_OP_READ] += 1;
+    return(MFRC522Constants::STATUS_CRC_WRONG);
+  }
+  return(MFRC522Constants::STATUS_OK);
+} // end MFRC522::MIFARE_Read()
+
+MFRC522Constants::StatusCode MFRC522::MIFARE_Write(byte p_block, byte * p_buf, byte p_size) {
+  if ((nullptr == p_buf) || (p_size < 16)) { g_sim_picc_stats.fails[UNI_SIM_PICC_OP_WRITE] += 1; return(MFRC522Constants::STATUS_INVALID); }
+  uint8_t answered = uni_sim_picc_block_op(p_block);
+  uni_sim_picc_spend(UNI_SIM_PICC_OP_WRITE, answered);
+  if (0 == answered) { g_sim_picc_stats.fails[UNI_SIM_PICC_OP_WRITE] += 1; return(MFRC522Constants::STATUS_TIMEOUT); }
+  if ((0 == p_block) || (p_block >= UNI_SIM_CARD_BLOCKS) || ((p_block / 4) != g_sim_card.auth_sector) ||
+      uni_sim_picc_fault_now(UNI_SIM_PICC_FAULT_WRITE, p_block)) {
+    g_sim_picc_stats.fails[UNI_SIM_PICC_OP_WRITE] += 1;
+    g_sim_card.state = UNI_SIM_CARD_IDLE; // NAK, then idle
+    return(MFRC522Constants::STATUS_MIFARE_NACK);
+  }
+  memcpy(g_sim_card.blocks[p_block], p_buf, UNI_SIM_CARD_BLOCK_BYTES);
+  return(MFRC522Constants::STATUS_OK);
+} // end MFRC522::MIFARE_Write()
+
+MFRC522Constants::StatusCode MFRC522::PICC_HaltA() {
+  uni_sim_picc_spend(UNI_SIM_PICC_OP_HALT, 1);
+  if (UNI_SIM_CARD_ACTIVE == g_sim_card.state) g_sim_card.state = UNI_SIM_CARD_HALT;
+  return(MFRC522Constants::STATUS_OK); // no answer is success
+} // end MFRC522::PICC_HaltA()
+
+void MFRC522::PCD_StopCrypto1() {
+  uni_sim_picc_spend(UNI_SIM_PICC_OP_STOP_CRYPTO, 1);
+  m_crypto1_on = 0;
+} // end MFRC522::PCD_StopCrypto1()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// faults and statistics
+//
+void uni_sim_picc_fault(uint8_t p_kind, int16_t p_block) {
+  if ((p_kind >= UNI_SIM_PICC_FAULT_NUM) || (g_sim_picc_fault_num >= UNI_SIM_PICC_FAULT_ONCE_NUM)) return;
+  g_sim_picc_faults[g_sim_picc_fault_num].kind = p_kind;
+  g_sim_picc_faults[g_sim_picc_fault_num].block = p_block;
+  g_sim_picc_fault_num += 1;
+} // end uni_sim_picc_fault()
+
+void uni_sim_picc_fault_rate(uint8_t p_kind, uint16_t p_per_mille, uint32_t p_seed) {
+  if (p_kind >= UNI_SIM_PICC_FAULT_NUM) return;
+  g_sim_picc_fault_per_mille[p_kind] = p_per_mille;
+  g_sim_picc_rand = p_seed;
+} // end uni_sim_picc_fault_rate()
+
+void uni_sim_picc_faults_clear() {
+  g_sim_picc_fault_num = 0;
+  memset(g_sim_picc_fault_per_mille, 0, sizeof(g_sim_picc_fault_per_mille));
+} // end uni_sim_picc_faults_clear()
+
+void uni_sim_picc_stats_clear() {
+  memset(&g_sim_picc_stats, 0, sizeof(g_sim_picc_stats));
+} // end uni_sim_picc_stats_clear()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// the card
+//
+void uni_sim_card_put_blank() {
+  static const uint8_t trailer[UNI_SIM_CARD_BLOCK_BYTES] = { // factory keys; access bits FF 07 80
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x07, 0x80, 0x69, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+  memset(&g_sim_card, 0, sizeof(g_sim_card));
+  g_sim_card.uid[0] = 0x5E; g_sim_card.uid[1] = 0x1D; g_sim_card.uid[2] = 0xCA; g_sim_card.uid[3] = g_sim_card_uid_next++;
+  g_sim_card.sak = 0x08;
+  memcpy(g_sim_card.blocks[0], g_sim_card.uid, sizeof(g_sim_card.uid));
+  g_sim_card.blocks[0][4] = g_sim_card.uid[0] ^ g_sim_card.uid[1] ^ g_sim_card.uid[2] ^ g_sim_card.uid[3]; // BCC
+  g_sim_card.blocks[0][5] = g_sim_card.sak;
+  for (uint16_t block = 3; block < UNI_SIM_CARD_BLOCKS; block += 4) memcpy(g_sim_card.blocks[block], trailer, sizeof(trailer));
+  g_sim_card.auth_sector = -1;
+  g_sim_card.state = UNI_SIM_CARD_IDLE;
+} // end uni_sim_card_put_blank()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_sim_card_put() - lay a card on the reader with p_text in the blocks uni_read_picc() reads
+//       returns: nothing
+//
+// block 0 is the maker's block (the UID); every 4th block is a sector trailer with the keys
+//
+void uni_sim_card_put(const char * p_text) {
+  const char * text_ptr = p_text;
+  size_t text_len = strlen(p_text) + 1; // with the zero termination
+  uni_sim_card_put_blank();
+  for (uint16_t block = 1; (block < UNI_SIM_CARD_BLOCKS) && (text_len > 0); block++) {
+    if (3 == (block % 4)) continue;
+    size_t num = (text_len > UNI_SIM_CARD_BLOCK_BYTES) ? UNI_SIM_CARD_BLOCK_BYTES : text_len;
+    memcpy(g_sim_card.blocks[block], text_ptr, num);
+    text_ptr += num;
+    text_len -= num;
+  }
+} // end uni_sim_card_put()
+
+void uni_sim_card_remove() {
+  g_sim_card.state = UNI_SIM_CARD_ABSENT;
+  g_sim_card.auth_sector = -1;
+} // end uni_sim_card_remove()
+
+uint16_t uni_sim_card_text(char * p_text, uint16_t p_text_max) {
+  uint16_t len = 0;
+  for (uint16_t block = 1; block < UNI_SIM_CARD_BLOCKS; block++) {
+    if (3 == (block % 4)) continue;
+    for (uint16_t idx = 0; idx < UNI_SIM_CARD_BLOCK_BYTES; idx++) {
+      if (('\0' == g_sim_card.blocks[block][idx]) || ((len+1) >= p_text_max)) { p_text[len] = '\0'; return(len); }
+      p_text[len++] = (char) g_sim_card.blocks[block][idx];
+    }
+  }
+  p_text[len] = '\0';
+  return(len);
+} // end uni_sim_card_text()
@@ -0,0 +1,250 @@
+/* Author: https://github.com/Mark-MDO47  Mar. 9, 2025
+ *  https://github.com/Mark-MDO47/UniRemote
+ */
+
+/*
+   Copyright 2025 Mark Olson
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * uni_sim_picc.cpp - uni_read_picc() and uni_write_picc() on the host against the MFRC522 stand-in
+ *
+ *    uni_sim_picc --check                    # faults and round trips; exit status 1 if any went wrong
+ *    uni_sim_picc --bench N [options]        # N taps; SPI transfers, bytes and simulated time per tap
+ *        --write            write the card each tap instead of reading it
+ *        --text TEXT        what is on the card (default a typical command)
+ *        --fault KIND BLOCK one fault each tap: auth, read, write or remove at BLOCK (-1 the next block)
+ *        --rate KIND N      each operation has fault KIND N times in 1000, at random
+ *
+ * Uni_RW_PICC/uni_read_picc.h and uni_write_picc.h are used as they are, the way WriteRFID.ino uses
+ *    them: a global mfrc522 and key, and the PICC_EV1_1K_* layout.
+ */
+
+#include <Arduino.h>
+#include <esp_now.h>   // for ESP_NOW_MAX_DATA_LEN
+#include <MFRC522v2.h>
+#include <MFRC522DriverSPI.h>
+#include <MFRC522DriverPinSimple.h>
+#include <MFRC522Debug.h>
+#include "uni_sim.h"
+
+MFRC522DriverPinSimple ss_pin(5);
+MFRC522DriverSPI driver{ss_pin};
+MFRC522 mfrc522{driver};
+MFRC522::MIFARE_Key key;
+
+#define PICC_EV1_1K_NUM_SECTORS         16 // 16 sectors each with 4 blocks of 16 bytes
+#define PICC_EV1_1K_SECTOR_NUM_BLOCKS   4  // each sector has 4 blocks of 16 bytes
+#define PICC_EV1_1K_BLOCK_NUM_BYTES     16 // each block has 16 bytes
+#define PICC_EV1_1K_BLOCK_SECTOR_AVOID  3  // avoid blockAddress 0 and block 3 within each sector
+#define PICC_EV1_1K_START_BLOCKADDR     1  // do not use blockAddress 0
+#define PICC_EV1_1K_END_BLOCKADDR ((PICC_EV1_1K_SECTOR_NUM_BLOCKS) * PICC_EV1_1K_NUM_SECTORS - 1)
+
+#define DEBUG_PRINT_PICC_INFO 0
+#define DEBUG_PRINT_PICC_DATA_FINAL 0
+#define DEBUG_PRINT_PICC_DATA_EACH 0
+
+#include "../../Uni_RW_PICC/uni_write_picc.h"
+#include "../../Uni_RW_PICC/uni_read_picc.h"
+
+#define UNI_SIM_PICC_HOLD_OFF_MSEC 2100 // both functions wait 2 sec after a tap before looking again
+#define UNI_SIM_PICC_TEXT_DEFAULT "12:34:56:78:9A:BC|LED:ON"
+
+static const char * g_sim_fault_names[UNI_SIM_PICC_FAULT_NUM] = { "auth", "read", "write", "remove" };
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_sim_picc_tap() - one tap: card on the reader, one uni_read_picc() or uni_write_picc(), card away
+//       returns: what uni_read_picc() or uni_write_picc() returned
+//
+// p_text - put on the card first for a read; written for a write
+// p_read - filled with what was read; may be NULL for a write
+//
+static uint8_t uni_sim_picc_tap(uint8_t p_write, char * p_text, char * p_read) {
+  uint8_t ret_val;
+  uni_sim_advance_usec((int64_t) UNI_SIM_PICC_HOLD_OFF_MSEC * 1000);
+  if (0 != p_write) {
+    uni_sim_card_put_blank();
+    ret_val = uni_write_picc(p_text);
+  } else {
+    uni_sim_card_put(p_text);
+    ret_val = uni_read_picc(p_read);
+  }
+  uni_sim_card_remove();
+  return(ret_val);
+} // end uni_sim_picc_tap()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_sim_picc_stats_print() - per tap statistics since uni_sim_picc_stats_clear()
+//       returns: nothing
+//
+static void uni_sim_picc_stats_print(uint32_t p_taps) {
+  if (0 == p_taps) return;
+  printf("PICC %-12s %10s %10s\n", "operation", "calls/tap", "fails/tap");
+  for (uint8_t op = 0; op < UNI_SIM_PICC_OP_NUM; op++) {
+    if (0 == g_sim_picc_stats.calls[op]) continue;
+    printf("PICC %-12s %10.2f %10.2f\n", g_sim_picc_op_names[op],
+      (double) g_sim_picc_stats.calls[op] / p_taps, (double) g_sim_picc_stats.fails[op] / p_taps);
+  }
+  printf("PICC per tap: %.1f SPI transfers, %.1f SPI bytes, %.2f msec simulated\n",
+    (double) g_sim_picc_stats.spi_xfers / p_taps, (double) g_sim_picc_stats.spi_bytes / p_taps,
+    (double) g_sim_picc_stats.usec / p_taps / 1000);
+} // end uni_sim_picc_stats_print()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_sim_picc_expect() - one --check case
+//       returns: zero if it came out as expected
+//
+static int uni_sim_picc_expect(const char * p_name, uint8_t p_write, const char * p_text, uint8_t p_expect_ok) {
+  static char text[ESP_NOW_MAX_DATA_LEN];
+  static char read[ESP_NOW_MAX_DATA_LEN];
+  static char card[ESP_NOW_MAX_DATA_LEN];
+  strncpy(text, p_text, sizeof(text)-1);
+  read[0] = '\0';
+  uint8_t ret_val = uni_sim_picc_tap(p_write, text, read);
+  uni_sim_picc_faults_clear();
+  uint8_t ok = (0 == ret_val) ? 1 : 0;
+  if (0 != p_write) uni_sim_card_text(card, sizeof(card));
+  // a read that says it worked must have the whole text; one that failed must give nothing
+  uint8_t good = (ok == p_expect_ok) &&
+                 ((0 != p_write) ? ((0 == ok) || (0 == strcmp(card, p_text))) : ((0 == ok) ? ('\0' == read[0]) : (0 == strcmp(read, p_text))));
+  printf("CHECK %-32s %s (returned %d)\n", p_name, good ? "ok" : "FAIL", ret_val);
+  return(good ? 0 : 1);
+} // end uni_sim_picc_expect()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_sim_picc_check() - faults and round trips
+//       returns: number of cases that went wrong
+//
+static int uni_sim_picc_check() {
+  static char long_text[ESP_NOW_MAX_DATA_LEN];
+  int fail_num = 0;
+  memset(long_text, 'x', sizeof(long_text)-1);
+  long_text[sizeof(long_text)-1] = '\0';
+
+  fail_num += uni_sim_picc_expect("read", 0, UNI_SIM_PICC_TEXT_DEFAULT, 1);
+  fail_num += uni_sim_picc_expect("read longest command", 0, long_text, 1);
+  fail_num += uni_sim_picc_expect("read empty card", 0, "", 1);
+  uni_sim_picc_fault(UNI_SIM_PICC_FAULT_AUTH, 1);
+  fail_num += uni_sim_picc_expect("read, auth fails first block", 0, UNI_SIM_PICC_TEXT_DEFAULT, 0);
+  uni_sim_picc_fault(UNI_SIM_PICC_FAULT_AUTH, 62);
+  fail_num += uni_sim_picc_expect("read, auth fails last block", 0, UNI_SIM_PICC_TEXT_DEFAULT, 0);
+  uni_sim_picc_fault(UNI_SIM_PICC_FAULT_READ, 5);
+  fail_num += uni_sim_picc_expect("read, bad CRC", 0, UNI_SIM_PICC_TEXT_DEFAULT, 0);
+  uni_sim_picc_fault(UNI_SIM_PICC_FAULT_REMOVE, 9);
+  fail_num += uni_sim_picc_expect("read, card taken away", 0, UNI_SIM_PICC_TEXT_DEFAULT, 0);
+  fail_num += uni_sim_picc_expect("read again after faults", 0, UNI_SIM_PICC_TEXT_DEFAULT, 1);
+
+  fail_num += uni_sim_picc_expect("write", 1, UNI_SIM_PICC_TEXT_DEFAULT, 1);
+  fail_num += uni_sim_picc_expect("write longest command", 1, long_text, 1);
+  uni_sim_picc_fault(UNI_SIM_PICC_FAULT_WRITE, 13);
+  fail_num += uni_sim_picc_expect("write, not ACKed", 1, UNI_SIM_PICC_TEXT_DEFAULT, 0);
+  uni_sim_picc_fault(UNI_SIM_PICC_FAULT_REMOVE, 2);
+  fail_num += uni_sim_picc_expect("write, card taken away", 1, UNI_SIM_PICC_TEXT_DEFAULT, 0);
+
+  // what uni_write_picc() wrote, uni_read_picc() reads
+  static char text[ESP_NOW_MAX_DATA_LEN] = "AB|OTA:WEB";
+  static char read[ESP_NOW_MAX_DATA_LEN];
+  uni_sim_advance_usec((int64_t) UNI_SIM_PICC_HOLD_OFF_MSEC * 1000);
+  uni_sim_card_put_blank();
+  uint8_t ret_write = uni_write_picc(text);
+  g_sim_card.state = UNI_SIM_CARD_IDLE; // take it away and put it back
+  uni_sim_advance_usec((int64_t) UNI_SIM_PICC_HOLD_OFF_MSEC * 1000);
+  uint8_t ret_read = uni_read_picc(read);
+  uint8_t good = (0 == ret_write) && (0 == ret_read) && (0 == strcmp(read, text));
+  printf("CHECK %-32s %s\n", "write then read", good ? "ok" : "FAIL");
+  fail_num += good ? 0 : 1;
+
+  printf("CHECK %d failed\n", fail_num);
+  return(fail_num);
+} // end uni_sim_picc_check()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_sim_picc_bench() - p_num taps
+//       returns: zero
+//
+static int uni_sim_picc_bench(uint32_t p_num, uint8_t p_write, const char * p_text, int16_t p_fault_kind, int16_t p_fault_block) {
+  static char text[ESP_NOW_MAX_DATA_LEN];
+  static char read[ESP_NOW_MAX_DATA_LEN];
+  uint32_t ok_num = 0;
+  uint32_t wrong_num = 0;
+  strncpy(text, p_text, sizeof(text)-1);
+
+  uni_sim_picc_stats_clear();
+  for (uint32_t tap = 0; tap < p_num; tap++) {
+    if (p_fault_kind >= 0) uni_sim_picc_fault((uint8_t) p_fault_kind, p_fault_block);
+    read[0] = '\0';
+    if (0 == uni_sim_picc_tap(p_write, text, read)) {
+      ok_num += 1;
+      if ((0 == p_write) && (0 != strcmp(read, text))) wrong_num += 1; // must never happen
+    }
+  }
+  printf("PICC %s %u taps, %u ok, %u read wrong, text %d chars\n", p_write ? "write" : "read", p_num, ok_num, wrong_num, (int) strlen(text));
+  uni_sim_picc_stats_print(p_num);
+  return((0 == wrong_num) ? 0 : 1);
+} // end uni_sim_picc_bench()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_sim_fault_kind() - fault name to UNI_SIM_PICC_FAULT_*
+//       returns: kind, or -1 if not a fault name
+//
+static int16_t uni_sim_fault_kind(const char * p_name) {
+  for (int16_t kind = 0; kind < UNI_SIM_PICC_FAULT_NUM; kind++) {
+    if (0 == strcmp(p_name, g_sim_fault_names[kind])) return(kind);
+  }
+  return(-1);
+} // end uni_sim_fault_kind()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// main
+//
+int main(int argc, char ** argv) {
+  uint32_t num = 0;
+  uint8_t write = 0;
+  const char * text = UNI_SIM_PICC_TEXT_DEFAULT;
+  int16_t fault_kind = -1;
+  int16_t fault_block = -1;
+
+  mfrc522.PCD_Init();
+  for (byte i = 0; i < 6; i++) key.keyByte[i] = 0xFF; // factory key, as the sketches use
+  uni_sim_picc_stats_clear();
+
+  if ((2 == argc) && (0 == strcmp(argv[1], "--check"))) return((0 == uni_sim_picc_check()) ? 0 : 1);
+  for (int arg_idx = 1; arg_idx < argc; arg_idx++) {
+    if ((0 == strcmp(argv[arg_idx], "-v"))) {
+      g_sim_verbose = 1;
+    } else if ((0 == strcmp(argv[arg_idx], "--bench")) && ((arg_idx+1) < argc)) {
+      num = (uint32_t) atol(argv[++arg_idx]);
+    } else if (0 == strcmp(argv[arg_idx], "--write")) {
+      write = 1;
+    } else if ((0 == strcmp(argv[arg_idx], "--text")) && ((arg_idx+1) < argc)) {
+      text = argv[++arg_idx];
+    } else if ((0 == strcmp(argv[arg_idx], "--fault")) && ((arg_idx+2) < argc) && (uni_sim_fault_kind(argv[arg_idx+1]) >= 0)) {
+      fault_kind = uni_sim_fault_kind(argv[arg_idx+1]);
+      fault_block = (int16_t) atoi(argv[arg_idx+2]);
+      arg_idx += 2;
+    } else if ((0 == strcmp(argv[arg_idx], "--rate")) && ((arg_idx+2) < argc) && (uni_sim_fault_kind(argv[arg_idx+1]) >= 0)) {
+      uni_sim_picc_fault_rate((uint8_t) uni_sim_fault_kind(argv[arg_idx+1]), (uint16_t) atoi(argv[arg_idx+2]), 12345);
+      arg_idx += 2;
+    } else {
+      num = 0;
+      break;
+    }
+  }
+  if (0 == num) {
+    fprintf(stderr, "usage: %s --check\n       %s --bench N [--write] [--text TEXT] [--fault auth|read|write|remove BLOCK] [--rate auth|read|write|remove PER_MILLE]\n", argv[0], argv[0]);
+    return(2);
+  }
+  return(uni_sim_picc_bench(num, write, text, fault_kind, fault_block));
+} // end main()
@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+# Author: https://github.com/Mark-MDO47  Mar. 8, 2025
+#  https://github.com/Mark-MDO47/UniRemote
+#
+#   Copyright 2025 Mark Olson
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+# uni_sim_sketch.py - turn UniRemoteCYD.ino into C++ for host_sim, the way the Arduino IDE would
+#
+#    python3 uni_sim_sketch.py                      # ../UniRemoteCYD.ino -> build/UniRemoteCYD_sim.cpp
+#    python3 uni_sim_sketch.py in.ino out.cpp
+#
+# Like the Arduino IDE it puts #include <Arduino.h> first and a prototype for each function before
+#    the first function, so the sketch can call a function above where it is written.
+#    It also moves the "../" includes to where build/ is and uses stubs/uni_sim_wifi_key.h
+#    for the WiFi secrets.
+#
+
+import os
+import re
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+# a function definition that starts at the left margin: [static] [unsigned] type [*] name(args) {
+FN_DEF = re.compile(r'^((?:static\s+)?(?:const\s+)?(?:unsigned\s+)?[A-Za-z_][\w:]*\s*\**\s+\**[A-Za-z_]\w*\s*\([^;{)]*\))\s*\{')
+NOT_FN = ("if", "else", "while", "for", "return", "switch")
+
+
+###################################################################################################
+# sketch_to_cpp() - the sketch text as a C++ translation unit
+#    returns: string
+#
+def sketch_to_cpp(p_text, p_ino_name):
+    lines = p_text.split("\n")
+    protos = []
+    first = None
+    for idx, line in enumerate(lines):
+        match = FN_DEF.match(line)
+        if match and not line.startswith(NOT_FN):
+            protos.append(match.group(1) + ";")
+            if first is None:
+                first = idx
+    if first is None:
+        first = len(lines)
+
+    out = ["#include <Arduino.h>", "#line 1 \"%s\"" % p_ino_name]
+    for line in lines[:first]:
+        out.append(fix_include(line))
+    out += protos
+    out.append("#line %d \"%s\"" % (first + 1, p_ino_name))
+    for line in lines[first:]:
+        out.append(fix_include(line))
+    return "\n".join(out) + "\n"
+    # end sketch_to_cpp()
+
+
+###################################################################################################
+# fix_include() - a "../" include as seen from build/
+#    returns: string
+#
+def fix_include(p_line):
+    if re.match(r'\s*#include\s+"\.\./wifi_key\.h"', p_line):
+        return p_line.replace('"../wifi_key.h"', '"uni_sim_wifi_key.h"')
+    return re.sub(r'^(\s*#include\s+")\.\./', r'\1../../../', p_line)
+    # end fix_include()
+
+
+###################################################################################################
+# main
+#
+if __name__ == "__main__":
+    if len(sys.argv) not in (1, 3):
+        sys.stderr.write("usage: %s [in.ino out.cpp]\n" % sys.argv[0])
+        sys.exit(2)
+    if 3 == len(sys.argv):
+        ino_path, cpp_path = sys.argv[1], sys.argv[2]
+    else:
+        ino_path = os.path.join(HERE, "..", "UniRemoteCYD.ino")
+        cpp_path = os.path.join(HERE, "build", "UniRemoteCYD_sim.cpp")
+    with open(ino_path, "r") as f_in:
+        text = f_in.read()
+    os.makedirs(os.path.dirname(os.path.abspath(cpp_path)), exist_ok=True)
+    with open(cpp_path, "w") as f_out:
+        f_out.write(sketch_to_cpp(text, os.path.abspath(ino_path)))
+    # end main
@@ -0,0 +1,314 @@
+/* Author: https://github.com/Mark-MDO47  Mar. 8, 2025
+ *  https://github.com/Mark-MDO47/UniRemote
+ */
+
+/*
+   Copyright 2025 Mark Olson
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * uni_sim_stubs.cpp - the simulated world for host_sim: clock, radio, NVS and LVGL objects
+ *    the RFID card is in uni_sim_mfrc522.cpp
+ *
+ * The stand-in headers in stubs/ declare these; stubs/uni_sim.h describes the model.
+ */
+
+#include "Arduino.h"
+#include "WiFi.h"
+#include "Wire.h"
+#include "esp_now.h"
+#include "esp_wifi.h"
+#include "Preferences.h"
+#include "LittleFS.h"
+#include "lvgl.h"
+#include "uni_sim.h"
+
+int g_sim_verbose = 0;
+const char * g_sim_serial_in = "";
+HardwareSerial Serial;
+TwoWire Wire;
+WiFiClass WiFi;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// clock
+//
+int64_t g_sim_usec = 0;
+
+int64_t esp_timer_get_time() { return(g_sim_usec); }
+unsigned long millis() { return((unsigned long) (g_sim_usec / 1000)); }
+unsigned long micros() { return((unsigned long) g_sim_usec); }
+void delay(unsigned long p_msec) { uni_sim_advance_usec((int64_t) p_msec * 1000); }
+void yield() { }
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// radio
+//
+#define UNI_SIM_PEER_NUM ESP_NOW_MAX_TOTAL_PEER_NUM
+
+uint32_t g_sim_air_usec = 1500;
+uint8_t g_sim_channel = 1;
+uni_sim_radio_stats_t g_sim_radio;
+
+static uint8_t g_sim_esp_now_init = 0;
+static esp_now_send_cb_t g_sim_send_cb = nullptr;
+static esp_now_recv_cb_t g_sim_recv_cb = nullptr;
+static uint8_t g_sim_next = UNI_SIM_NEXT_AIR;
+
+static struct { uint8_t mac_addr[ESP_NOW_ETH_ALEN]; uint8_t channel; } g_sim_rcvrs[UNI_SIM_RCVR_NUM];
+static uint16_t g_sim_rcvr_num = 0;
+static uint8_t g_sim_peers[UNI_SIM_PEER_NUM][ESP_NOW_ETH_ALEN];
+static uint16_t g_sim_peer_num = 0;
+
+typedef struct {
+  int64_t usec_cb;                    // when the send callback comes
+  uint8_t mac_addr[ESP_NOW_ETH_ALEN];
+  esp_now_send_status_t status;
+  uint8_t is_cmd;
+} uni_sim_pending_t;
+static uni_sim_pending_t g_sim_pending[UNI_SIM_PENDING_NUM]; // in order of usec_cb
+static uint16_t g_sim_pending_num = 0;
+
+static const uint8_t g_sim_broadcast[ESP_NOW_ETH_ALEN] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_sim_advance_usec() - move the clock forward p_usec, making the send callbacks that come due
+//       returns: nothing
+//
+void uni_sim_advance_usec(int64_t p_usec) {
+  int64_t usec_end = g_sim_usec + p_usec;
+  while ((g_sim_pending_num > 0) && (g_sim_pending[0].usec_cb <= usec_end)) {
+    uni_sim_pending_t pending = g_sim_pending[0];
+    g_sim_pending_num -= 1;
+    memmove(&g_sim_pending[0], &g_sim_pending[1], g_sim_pending_num * sizeof(g_sim_pending[0]));
+    if (pending.usec_cb > g_sim_usec) g_sim_usec = pending.usec_cb;
+    g_sim_radio.cb_num += 1;
+    if ((0 != pending.is_cmd) && (ESP_NOW_SEND_SUCCESS == pending.status)) g_sim_radio.cmd_ok_num += 1;
+    if (nullptr != g_sim_send_cb) g_sim_send_cb(pending.mac_addr, pending.status);
+  }
+  g_sim_usec = usec_end;
+} // end uni_sim_advance_usec()
+
+int16_t uni_sim_rcvr_add(const uint8_t * p_mac_addr, uint8_t p_channel) {
+  for (uint16_t idx = 0; idx < g_sim_rcvr_num; idx++) {
+    if (0 == memcmp(g_sim_rcvrs[idx].mac_addr, p_mac_addr, ESP_NOW_ETH_ALEN)) { g_sim_rcvrs[idx].channel = p_channel; return(0); }
+  }
+  if (g_sim_rcvr_num >= UNI_SIM_RCVR_NUM) return(-1);
+  memcpy(g_sim_rcvrs[g_sim_rcvr_num].mac_addr, p_mac_addr, ESP_NOW_ETH_ALEN);
+  g_sim_rcvrs[g_sim_rcvr_num].channel = p_channel;
+  g_sim_rcvr_num += 1;
+  return(0);
+} // end uni_sim_rcvr_add()
+
+void uni_sim_radio_next(uint8_t p_next) { g_sim_next = p_next; }
+
+static int16_t uni_sim_peer_find(const uint8_t * p_mac_addr) {
+  for (uint16_t idx = 0; idx < g_sim_peer_num; idx++) {
+    if (0 == memcmp(g_sim_peers[idx], p_mac_addr, ESP_NOW_ETH_ALEN)) return(idx);
+  }
+  return(-1);
+} // end uni_sim_peer_find()
+
+esp_err_t esp_now_init() { g_sim_esp_now_init = 1; return(ESP_OK); }
+esp_err_t esp_now_deinit() { g_sim_esp_now_init = 0; g_sim_peer_num = 0; return(ESP_OK); }
+esp_err_t esp_now_register_recv_cb(esp_now_recv_cb_t p_cb) { g_sim_recv_cb = p_cb; return(ESP_OK); }
+esp_err_t esp_now_register_send_cb(esp_now_send_cb_t p_cb) { g_sim_send_cb = p_cb; return(ESP_OK); }
+bool esp_now_is_peer_exist(const uint8_t * p_mac_addr) { return(uni_sim_peer_find(p_mac_addr) >= 0); }
+esp_err_t esp_now_mod_peer(const esp_now_peer_info_t * p_peer) { return((uni_sim_peer_find(p_peer->peer_addr) >= 0) ? ESP_OK : ESP_ERR_ESPNOW_NOT_FOUND); }
+
+esp_err_t esp_now_add_peer(const esp_now_peer_info_t * p_peer) {
+  if (0 == g_sim_esp_now_init) return(ESP_ERR_ESPNOW_NOT_INIT);
+  if (uni_sim_peer_find(p_peer->peer_addr) >= 0) return(ESP_ERR_ESPNOW_EXIST);
+  if (g_sim_peer_num >= UNI_SIM_PEER_NUM) return(ESP_ERR_ESPNOW_FULL);
+  memcpy(g_sim_peers[g_sim_peer_num++], p_peer->peer_addr, ESP_NOW_ETH_ALEN);
+  return(ESP_OK);
+} // end esp_now_add_peer()
+
+esp_err_t esp_now_del_peer(const uint8_t * p_mac_addr) {
+  int16_t idx = uni_sim_peer_find(p_mac_addr);
+  if (idx < 0) return(ESP_ERR_ESPNOW_NOT_FOUND);
+  g_sim_peer_num -= 1;
+  memmove(g_sim_peers[idx], g_sim_peers[idx+1], (g_sim_peer_num - idx) * ESP_NOW_ETH_ALEN);
+  return(ESP_OK);
+} // end esp_now_del_peer()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// esp_now_send() - the frame goes on the air; its send callback comes g_sim_air_usec later
+//       returns: ESP_OK or ESP_ERR_ESPNOW_*
+//
+esp_err_t esp_now_send(const uint8_t * p_mac_addr, const uint8_t * p_data, size_t p_len) {
+  if (0 == g_sim_esp_now_init) return(ESP_ERR_ESPNOW_NOT_INIT);
+  if ((nullptr == p_mac_addr) || (nullptr == p_data) || (0 == p_len) || (p_len > ESP_NOW_MAX_DATA_LEN)) return(ESP_ERR_ESPNOW_ARG);
+  if (uni_sim_peer_find(p_mac_addr) < 0) return(ESP_ERR_ESPNOW_NOT_FOUND);
+  if (g_sim_pending_num >= UNI_SIM_PENDING_NUM) return(ESP_ERR_ESPNOW_NO_MEM);
+
+  uni_sim_pending_t * pending_ptr = &g_sim_pending[g_sim_pending_num++];
+  pending_ptr->usec_cb = g_sim_usec + g_sim_air_usec;
+  memcpy(pending_ptr->mac_addr, p_mac_addr, ESP_NOW_ETH_ALEN);
+  pending_ptr->is_cmd = ('\0' != p_data[0]) ? 1 : 0;
+  if (0 != pending_ptr->is_cmd) g_sim_radio.cmd_num += 1;
+  else if ((p_len >= 3) && ('P' == p_data[2])) g_sim_radio.probe_num += 1;
+  else g_sim_radio.ctrl_num += 1;
+
+  pending_ptr->status = ESP_NOW_SEND_FAIL;
+  if (0 == memcmp(p_mac_addr, g_sim_broadcast, ESP_NOW_ETH_ALEN)) {
+    pending_ptr->status = ESP_NOW_SEND_SUCCESS; // no ACK for broadcast
+  } else if (UNI_SIM_NEXT_AIR != g_sim_next) {
+    pending_ptr->status = (UNI_SIM_NEXT_OK == g_sim_next) ? ESP_NOW_SEND_SUCCESS : ESP_NOW_SEND_FAIL;
+    g_sim_next = UNI_SIM_NEXT_AIR;
+  } else {
+    for (uint16_t idx = 0; idx < g_sim_rcvr_num; idx++) {
+      if ((0 == memcmp(g_sim_rcvrs[idx].mac_addr, p_mac_addr, ESP_NOW_ETH_ALEN)) && (g_sim_channel == g_sim_rcvrs[idx].channel)) {
+        pending_ptr->status = ESP_NOW_SEND_SUCCESS;
+      }
+    }
+  }
+  return(ESP_OK);
+} // end esp_now_send()
+
+esp_err_t esp_now_set_peer_rate_config(const uint8_t * p_mac_addr, esp_now_rate_config_t * p_config) { return(ESP_OK); }
+esp_err_t esp_wifi_config_espnow_rate(wifi_interface_t p_ifx, wifi_phy_rate_t p_rate) { return(ESP_OK); }
+esp_err_t esp_wifi_set_channel(uint8_t p_primary, wifi_second_chan_t p_second) { g_sim_channel = p_primary; return(ESP_OK); }
+esp_err_t esp_wifi_get_channel(uint8_t * p_primary, wifi_second_chan_t * p_second) {
+  *p_primary = g_sim_channel; *p_second = WIFI_SECOND_CHAN_NONE;
+  return(ESP_OK);
+} // end esp_wifi_get_channel()
+esp_err_t esp_wifi_get_mac(wifi_interface_t p_ifx, uint8_t * p_mac_addr) {
+  static const uint8_t mac_addr[ESP_NOW_ETH_ALEN] = { 0x02, 0x53, 0x49, 0x4D, 0x00, 0x01 };
+  memcpy(p_mac_addr, mac_addr, ESP_NOW_ETH_ALEN);
+  return(ESP_OK);
+} // end esp_wifi_get_mac()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// NVS
+//
+int16_t Preferences::find(const char * p_key) {
+  for (uint16_t idx = 0; idx < m_num; idx++) {
+    if (0 == strncmp(m_entries[idx].key, p_key, sizeof(m_entries[idx].key))) return(idx);
+  }
+  return(-1);
+} // end Preferences::find()
+
+size_t Preferences::getBytes(const char * p_key, void * p_buf, size_t p_len) {
+  int16_t idx = find(p_key);
+  if ((idx < 0) || (m_entries[idx].len > p_len)) return(0);
+  memcpy(p_buf, m_entries[idx].val, m_entries[idx].len);
+  return(m_entries[idx].len);
+} // end Preferences::getBytes()
+
+size_t Preferences::putBytes(const char * p_key, const void * p_buf, size_t p_len) {
+  int16_t idx = find(p_key);
+  if (p_len > UNI_SIM_NVS_VAL_MAX) return(0);
+  if (idx < 0) {
+    if (m_num >= UNI_SIM_NVS_NUM) return(0);
+    idx = m_num++;
+    strncpy(m_entries[idx].key, p_key, sizeof(m_entries[idx].key)-1);
+    m_entries[idx].key[sizeof(m_entries[idx].key)-1] = '\0';
+  }
+  memcpy(m_entries[idx].val, p_buf, p_len);
+  m_entries[idx].len = p_len;
+  return(p_len);
+} // end Preferences::putBytes()
+
+bool Preferences::remove(const char * p_key) {
+  int16_t idx = find(p_key);
+  if (idx < 0) return(false);
+  m_num -= 1;
+  m_entries[idx] = m_entries[m_num];
+  return(true);
+} // end Preferences::remove()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LittleFS
+//
+fs::LittleFSFS LittleFS;
+uni_sim_fs_stats_t g_sim_fs;
+uint32_t g_sim_fs_write_usec = 2000; // a 256 byte page plus the metadata commit; ESP32 flash is around 1 to 3 msec
+
+int16_t fs::LittleFSFS::find(const char * p_path) {
+  for (int16_t idx = 0; idx < UNI_SIM_FS_FILE_NUM; idx++) {
+    if ((0 != m_files[idx].used) && (0 == strncmp(m_files[idx].name, p_path, UNI_SIM_FS_NAME_MAX))) return(idx);
+  }
+  return(-1);
+} // end fs::LittleFSFS::find()
+
+File fs::LittleFSFS::open(const char * p_path, const char * p_mode) {
+  int16_t idx = find(p_path);
+  if ('r' == p_mode[0]) return((idx < 0) ? File() : File(idx, 0));
+  if (idx < 0) {
+    for (idx = 0; (idx < UNI_SIM_FS_FILE_NUM) && (0 != m_files[idx].used); idx++) { }
+    if (idx >= UNI_SIM_FS_FILE_NUM) return(File());
+    m_files[idx].used = 1;
+    m_files[idx].size = 0;
+    strncpy(m_files[idx].name, p_path, UNI_SIM_FS_NAME_MAX-1);
+    m_files[idx].name[UNI_SIM_FS_NAME_MAX-1] = '\0';
+  }
+  if ('w' == p_mode[0]) m_files[idx].size = 0;
+  return(File(idx, ('a' == p_mode[0]) ? 1 : 0));
+} // end fs::LittleFSFS::open()
+
+bool fs::LittleFSFS::remove(const char * p_path) {
+  int16_t idx = find(p_path);
+  if (idx < 0) return(false);
+  m_files[idx].used = 0;
+  return(true);
+} // end fs::LittleFSFS::remove()
+
+size_t File::write(const uint8_t * p_buf, size_t p_len) {
+  if (m_idx < 0) return(0);
+  uint32_t & size = LittleFS.m_files[m_idx].size;
+  if (0 != m_append) m_pos = size;
+  if ((m_pos + p_len) > UNI_SIM_FS_FILE_MAX) p_len = UNI_SIM_FS_FILE_MAX - m_pos;
+  memcpy(&LittleFS.m_files[m_idx].data[m_pos], p_buf, p_len);
+  m_pos += p_len;
+  if (m_pos > size) size = m_pos;
+  g_sim_fs.writes += 1;
+  g_sim_fs.bytes += p_len;
+  if (0 != g_sim_pending_num) g_sim_fs.writes_air += 1;
+  g_sim_fs.usec += g_sim_fs_write_usec;
+  uni_sim_advance_usec(g_sim_fs_write_usec);
+  return(p_len);
+} // end File::write()
+
+size_t File::read(uint8_t * p_buf, size_t p_len) {
+  if (m_idx < 0) return(0);
+  uint32_t size = LittleFS.m_files[m_idx].size;
+  if (m_pos >= size) return(0);
+  if ((m_pos + p_len) > size) p_len = size - m_pos;
+  memcpy(p_buf, &LittleFS.m_files[m_idx].data[m_pos], p_len);
+  m_pos += p_len;
+  return(p_len);
+} // end File::read()
+
+bool File::seek(uint32_t p_pos) {
+  if ((m_idx < 0) || (p_pos > LittleFS.m_files[m_idx].size)) return(false);
+  m_pos = p_pos;
+  return(true);
+} // end File::seek()
+
+size_t File::size() const {
+  return((m_idx < 0) ? 0 : LittleFS.m_files[m_idx].size);
+} // end File::size()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LVGL objects
+//
+#define UNI_SIM_LV_OBJ_NUM 64
+
+lv_obj_t * uni_sim_lv_obj_new() {
+  static lv_obj_t objs[UNI_SIM_LV_OBJ_NUM];
+  static uint16_t obj_num = 0;
+  if (obj_num >= UNI_SIM_LV_OBJ_NUM) { fprintf(stderr, "host_sim: more than %d LVGL objects\n", UNI_SIM_LV_OBJ_NUM); exit(1); }
+  return(&objs[obj_num++]);
+} // end uni_sim_lv_obj_new()
@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+# Author: https://github.com/Mark-MDO47  Mar. 7, 2025
+#  https://github.com/Mark-MDO47/UniRemote
+#
+#   Copyright 2025 Mark Olson
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+# uni_trace_json.py - turn the "trace" Serial dump from UniRemoteCYD into Chrome trace_event JSON
+#
+#    python uni_trace_json.py serial_log.txt > trace.json
+#    python uni_trace_json.py < serial_log.txt > trace.json
+#
+# Then open trace.json in https://ui.perfetto.dev or chrome://tracing
+#
+# The log can have anything else in it; only lines starting with TRACE are used, and only the
+#    last dump (TRACE now ... TRACE end) if there are several. The format is at the top of
+#    code/UniRemoteRcvrTemplate/UniRemoteTrace.h
+#
+# Each ring is a row (thread) in the viewer. An event with arg names is a state: it becomes a span
+#    from one to the next on a row of its own, named by its arg name.
+#
+
+import sys
+import json
+
+USEC_WRAP = 1 << 32  # the dump has the low 32 bits of esp_timer_get_time()
+
+
+###################################################################################################
+# read_dump() - the last complete dump in the lines
+#    returns: dict with now, names, arg_names, rings; None if no complete dump
+#
+def read_dump(p_lines):
+    dump = None
+    latest = None
+    ring = None
+    for line in p_lines:
+        words = line.strip().split(" ", 6)
+        if (len(words) < 2) or ("TRACE" != words[0]):
+            continue
+        kind = words[1]
+        if "now" == kind:
+            dump = {"now": int(words[2]), "names": {}, "arg_names": {}, "rings": []}
+            ring = None
+        elif dump is None:
+            continue
+        elif "name" == kind:
+            dump["names"][int(words[2])] = words[3]
+        elif "arg" == kind:
+            dump["arg_names"][(int(words[2]), int(words[3]))] = " ".join(words[4:])
+        elif "ring" == kind:
+            ring = {"track": words[2], "events": []}
+            dump["rings"].append(ring)
+        elif ("ev" == kind) and (ring is not None):
+            usec, dur, ev_id, ph, arg = words[2:7]
+            ring["events"].append((int(usec), int(dur), int(ev_id), ph, int(arg)))
+        elif "end" == kind:
+            latest = dump
+            dump = None
+    return latest
+    # end read_dump()
+
+
+###################################################################################################
+# to_trace_events() - Chrome trace_event list from a dump
+#    returns: list of dict
+#
+# timestamps are made 64 bit by going back from "now"; events more than 71 minutes old come out wrong
+#
+def to_trace_events(p_dump):
+    now = p_dump["now"]
+    names = p_dump["names"]
+    arg_names = p_dump["arg_names"]
+    state_ids = set(ev_id for (ev_id, arg) in arg_names)
+    out = []
+    tid = 0
+    states = {}  # ev_id -> list of (usec, arg)
+
+    def usec_of(p_usec32):
+        return now - ((now - p_usec32) % USEC_WRAP)
+
+    out.append({"name": "process_name", "ph": "M", "pid": 1, "tid": 0, "args": {"name": "UniRemoteCYD"}})
+    for ring in p_dump["rings"]:
+        tid += 1
+        out.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": tid, "args": {"name": ring["track"]}})
+        for (usec32, dur, ev_id, ph, arg) in ring["events"]:
+            usec = usec_of(usec32)
+            name = names.get(ev_id, "id%d" % ev_id)
+            if ev_id in state_ids:
+                states.setdefault(ev_id, []).append((usec, arg))
+            elif "X" == ph:
+                out.append({"name": name, "ph": "X", "ts": usec, "dur": dur, "pid": 1, "tid": tid, "args": {"arg": arg}})
+            else:
+                out.append({"name": name, "ph": "i", "s": "t", "ts": usec, "pid": 1, "tid": tid, "args": {"arg": arg}})
+
+    # each state lasts until the next one; the last one until the dump
+    for ev_id in sorted(states):
+        tid += 1
+        name = names.get(ev_id, "id%d" % ev_id)
+        out.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": tid, "args": {"name": name}})
+        changes = sorted(states[ev_id])
+        for idx, (usec, arg) in enumerate(changes):
+            usec_next = changes[idx + 1][0] if (idx + 1) < len(changes) else max(now, usec)
+            out.append({"name": arg_names.get((ev_id, arg), "%s %d" % (name, arg)), "ph": "X", "ts": usec,
+                        "dur": usec_next - usec, "pid": 1, "tid": tid, "args": {"arg": arg}})
+    return out
+    # end to_trace_events()
+
+
+###################################################################################################
+# main
+#
+if __name__ == "__main__":
+    if len(sys.argv) > 2:
+        sys.stderr.write("usage: %s [serial_log.txt] > trace.json\n" % sys.argv[0])
+        sys.exit(2)
+    if 2 == len(sys.argv):
+        with open(sys.argv[1], "r", errors="replace") as f_in:
+            the_dump = read_dump(f_in)
+    else:
+        the_dump = read_dump(sys.stdin)
+    if the_dump is None:
+        sys.stderr.write("no complete TRACE dump (TRACE now ... TRACE end) found\n")
+        sys.exit(1)
+    json.dump({"traceEvents": to_trace_events(the_dump), "displayTimeUnit": "ms"}, sys.stdout, indent=1)
+    sys.stdout.write("\n")
@@ -0,0 +1,197 @@
+/* Author: https://github.com/Mark-MDO47  Mar. 9, 2025
+ *  https://github.com/Mark-MDO47/UniRemote
+ */
+
+/*
+   Copyright 2025 Mark Olson
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * UniRemoteCmdParse - take apart the text of a command card in one pass
+ *
+ * Used by UniRemoteCYD as "../UniRemoteRcvrTemplate/UniRemoteCmdParse.h"; a receiver that wants to
+ *    look at the commands the same way can copy it along with UniRemoteRcvr.*
+ *
+ * The command format:
+ *
+ *    74:4d:bd:11:22:33|@500|LED:ON;MP3:PLAY 3
+ *    |<- MAC address ->|lead| command; command
+ *
+ *    - the MAC address is six pairs of hex digits with ':' between and '|' after. Or instead a
+ *      1 or 2 letter/digit alias that a receiver announced, then '|'. There must be something after.
+ *    - "@500|" is an optional "execute at" lead time in millisec.
+ *    - the rest goes to the receiver as it is. For the screen it is split at each ';' and the
+ *      tabs and spaces around each piece are left off.
+ *
+ * Each character is looked up once in g_uni_cmd_char[]: one byte says whether it is a hex digit,
+ *    a decimal digit, a letter or digit, a tab or space, and for a hex digit its value. No strlen()
+ *    first; a parse stops at the first character that does not fit, and the zero at the end of the
+ *    string never fits, so nothing past the end is read.
+ *
+ * Everything here is static in the header and none of it keeps any state.
+ */
+
+#ifndef UNI_REMOTE_CMD_PARSE_H
+#define UNI_REMOTE_CMD_PARSE_H 1
+
+#include <Arduino.h>  // for uint8_t and friends
+#include <esp_now.h>  // for ESP_NOW_ETH_ALEN and ESP_NOW_MAX_DATA_LEN
+
+#define UNI_CMD_PARSE_MAX_LEN ESP_NOW_MAX_DATA_LEN // most command chars looked at by uni_cmd_display()
+#define UNI_CMD_PARSE_MAC_LEN (3*ESP_NOW_ETH_ALEN) // "74:4d:bd:11:22:33|"
+#define UNI_CMD_PARSE_SEP ';'                      // between commands shown on separate lines
+#define UNI_CMD_PARSE_NONE -1                      // uni_cmd_parse_mac(): not a MAC address
+
+// g_uni_cmd_char[] bits; the low 4 bits are the value of a hex digit
+#define UNI_CMD_CHAR_HEXVAL 0x0F
+#define UNI_CMD_CHAR_HEX    0x10 // 0-9 a-f A-F
+#define UNI_CMD_CHAR_DIGIT  0x20 // 0-9
+#define UNI_CMD_CHAR_ALNUM  0x40 // 0-9 a-z A-Z
+#define UNI_CMD_CHAR_BLANK  0x80 // tab or space
+
+static const uint8_t g_uni_cmd_char[256] = {
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x80,0x00,0x00,0x00,0x00,0x00,0x00, // 0x00
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00, // 0x10
+  0x80,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00, // 0x20
+  0x70,0x71,0x72,0x73,0x74,0x75,0x76,0x77,0x78,0x79,0x00,0x00,0x00,0x00,0x00,0x00, // 0x30
+  0x00,0x5a,0x5b,0x5c,0x5d,0x5e,0x5f,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x40, // 0x40
+  0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x00,0x00,0x00,0x00,0x00, // 0x50
+  0x00,0x5a,0x5b,0x5c,0x5d,0x5e,0x5f,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x40, // 0x60
+  0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x00,0x00,0x00,0x00,0x00, // 0x70
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00, // 0x80
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00, // 0x90
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00, // 0xa0
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00, // 0xb0
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00, // 0xc0
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00, // 0xd0
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00, // 0xe0
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00, // 0xf0
+};
+
+#define UNI_CMD_CHAR(c) (g_uni_cmd_char[(uint8_t) (c)])
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_cmd_parse_mac() - MAC address at the start of p_cmd into p_mac
+//       returns: index in p_cmd after the '|'; UNI_CMD_PARSE_NONE if not "xx:xx:xx:xx:xx:xx|" and more
+//
+// p_mac is written as the pairs are decoded; don't use it if this returns UNI_CMD_PARSE_NONE
+//
+static int16_t uni_cmd_parse_mac(const char * p_cmd, uint8_t * p_mac) {
+  for (uint8_t idx = 0; idx < UNI_CMD_PARSE_MAC_LEN; idx += 3) {
+    uint8_t hi = UNI_CMD_CHAR(p_cmd[idx]);
+    if (0 == (UNI_CMD_CHAR_HEX & hi)) return(UNI_CMD_PARSE_NONE);
+    uint8_t lo = UNI_CMD_CHAR(p_cmd[idx+1]);
+    if (0 == (UNI_CMD_CHAR_HEX & lo)) return(UNI_CMD_PARSE_NONE);
+    if (p_cmd[idx+2] != (((UNI_CMD_PARSE_MAC_LEN-3) == idx) ? '|' : ':')) return(UNI_CMD_PARSE_NONE);
+    p_mac[idx/3] = (uint8_t) (((hi & UNI_CMD_CHAR_HEXVAL) << 4) | (lo & UNI_CMD_CHAR_HEXVAL));
+  }
+  if ('\0' == p_cmd[UNI_CMD_PARSE_MAC_LEN]) return(UNI_CMD_PARSE_NONE); // nothing after the MAC address
+  return(UNI_CMD_PARSE_MAC_LEN);
+} // end uni_cmd_parse_mac()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_cmd_parse_alias() - alias at the start of p_cmd into p_alias (zero terminated)
+//       returns: length of the alias; zero if p_cmd does not start with 1 to p_alias_max letters/digits, '|' and more
+//
+static uint16_t uni_cmd_parse_alias(const char * p_cmd, char * p_alias, uint16_t p_alias_max) {
+  uint16_t len = 0;
+  while ((len < p_alias_max) && (0 != (UNI_CMD_CHAR_ALNUM & UNI_CMD_CHAR(p_cmd[len])))) {
+    p_alias[len] = p_cmd[len];
+    len += 1;
+  }
+  p_alias[len] = '\0';
+  if ((0 == len) || ('|' != p_cmd[len]) || ('\0' == p_cmd[len+1])) return(0);
+  return(len);
+} // end uni_cmd_parse_alias()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_cmd_parse_exec_lead() - "@msec|" at p_cmd[p_idx]
+//       returns: index in p_cmd after the '|'; p_idx if there is no lead time there
+//
+// *p_msec is the lead time; zero if there is none
+//
+static uint16_t uni_cmd_parse_exec_lead(const char * p_cmd, uint16_t p_idx, uint32_t * p_msec) {
+  uint16_t idx = p_idx + 1;
+  uint32_t msec = 0;
+  uint8_t cls;
+
+  *p_msec = 0;
+  if ('@' != p_cmd[p_idx]) return(p_idx);
+  while (0 != (UNI_CMD_CHAR_DIGIT & (cls = UNI_CMD_CHAR(p_cmd[idx])))) {
+    msec = msec*10 + (cls & UNI_CMD_CHAR_HEXVAL);
+    idx += 1;
+  }
+  if (('|' != p_cmd[idx]) || (0 == msec)) return(p_idx); // not a lead time; it is all the command
+  *p_msec = msec;
+  return(idx+1);
+} // end uni_cmd_parse_exec_lead()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_cmd_append() - append p_len chars of p_src to p_dst[p_dst_len], keeping within p_dst_size
+//       returns: new length of p_dst (zero terminated)
+//
+static uint16_t uni_cmd_append(char * p_dst, uint16_t p_dst_size, uint16_t p_dst_len, const char * p_src, uint16_t p_len) {
+  if ((p_dst_len + p_len) >= p_dst_size) p_len = p_dst_size - 1 - p_dst_len;
+  memcpy(&p_dst[p_dst_len], p_src, p_len);
+  p_dst_len += p_len;
+  p_dst[p_dst_len] = '\0';
+  return(p_dst_len);
+} // end uni_cmd_append()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_cmd_display() - append the commands in p_cmd to p_msg for the screen, one per line
+//       returns: new length of p_msg
+//
+// p_msg          - text already there; the display is added after it. p_msg_size is the whole buffer.
+// p_cmd          - command text; only the first UNI_CMD_PARSE_MAX_LEN chars are used
+// p_insert_words - goes in front of the first command; for example "This CMD: "
+//
+// each piece between ';' goes on its own line without the tabs and spaces around it; empty pieces
+//    are left out. Nothing is added if p_cmd is empty; an error line if it is only ';'.
+// p_msg is only looked at once (for its length) and each char of p_cmd once; the result is cut
+//    short to fit p_msg_size rather than overflow.
+//
+static uint16_t uni_cmd_display(char * p_msg, uint16_t p_msg_size, const char * p_cmd, const char * p_insert_words) {
+  uint16_t msg_len = strlen(p_msg);
+  uint16_t insert_len = strlen(p_insert_words);
+  uint16_t idx = 0;
+  uint8_t found = 0;
+
+  if ((0 == p_msg_size) || (msg_len >= p_msg_size)) return(msg_len);
+  if ('\0' == p_cmd[0]) return(msg_len);
+  while ((idx < UNI_CMD_PARSE_MAX_LEN) && ('\0' != p_cmd[idx])) {
+    if (UNI_CMD_PARSE_SEP == p_cmd[idx]) { idx += 1; continue; }
+    // a piece: skip the blanks in front, then find its end and the last char that is not a blank
+    while ((idx < UNI_CMD_PARSE_MAX_LEN) && (0 != (UNI_CMD_CHAR_BLANK & UNI_CMD_CHAR(p_cmd[idx])))) idx += 1;
+    uint16_t text = idx;
+    uint16_t text_end = idx;
+    while ((idx < UNI_CMD_PARSE_MAX_LEN) && ('\0' != p_cmd[idx]) && (UNI_CMD_PARSE_SEP != p_cmd[idx])) {
+      if (0 == (UNI_CMD_CHAR_BLANK & UNI_CMD_CHAR(p_cmd[idx]))) text_end = idx + 1;
+      idx += 1;
+    }
+    msg_len = uni_cmd_append(p_msg, p_msg_size, msg_len, "\n", 1);
+    if (0 == found) msg_len = uni_cmd_append(p_msg, p_msg_size, msg_len, p_insert_words, insert_len);
+    msg_len = uni_cmd_append(p_msg, p_msg_size, msg_len, &p_cmd[text], text_end - text);
+    found = 1;
+  }
+  if (0 == found) {
+    msg_len = uni_cmd_append(p_msg, p_msg_size, msg_len, "\n\n", 2);
+    msg_len = uni_cmd_append(p_msg, p_msg_size, msg_len, p_insert_words, insert_len);
+    msg_len = uni_cmd_append(p_msg, p_msg_size, msg_len, "ERROR no command found", 22);
+  }
+  return(msg_len);
+} // end uni_cmd_display()
+
+#endif // UNI_REMOTE_CMD_PARSE_H
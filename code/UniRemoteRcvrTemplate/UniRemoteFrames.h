@@ -0,0 +1,380 @@
+/* Author: https://github.com/Mark-MDO47  Feb. 28, 2025
+ *  https://github.com/Mark-MDO47/UniRemote
+ */
+
+/*
+   Copyright 2025 Mark Olson
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * UniRemoteFrames - what UniRemoteCYD puts in an ESP-NOW message besides the command
+ *
+ * Used by both ends: UniRemoteCYD includes it as "../UniRemoteRcvrTemplate/UniRemoteFrames.h"
+ *    and UniRemoteRcvr.cpp includes it from the sketch directory (copy it along with UniRemoteRcvr.*).
+ *
+ * A command message is always the zero-terminated ASCII command first.
+ *    Anything after the zero termination is optional extra information; a receiver that does not
+ *    know about it only sees the command (strlen() stops at the zero).
+ *
+ * The extra information is a list of trailers. Each trailer starts the same way:
+ *    "magic" 'U' then a letter saying which trailer, version, length of the trailer.
+ *    A newer trailer may be longer; readers use the fields they know about and skip the rest.
+ *    Readers skip trailers they do not know about by using the length.
+ *
+ * The timing trailer - if there is room after the command, UniRemoteCYD appends this:
+ *
+ *    |<-- command -->|0|U|T|ver|len| seq | usec_sent | usec_scan | usec_parse | usec_queue | usec_air_min |
+ *
+ * The execute-at trailer - if the command asks for it, UniRemoteCYD appends this after the timing trailer:
+ *
+ *    |U|X|ver|len| usec_exec_at |
+ *
+ * The time beacon - UniRemoteCYD broadcasts this every so often; it is an empty command with a trailer.
+ *    UniRemoteRcvr uses it to keep its idea of the UniRemoteCYD clock and does not pass it on to loop().
+ *    A receiver that does not know about it sees a zero-length command.
+ *
+ *    |0|U|B|ver|len| seq | usec_sent | usec_air_min | msec_period |
+ *
+ * The channel probe - UniRemoteCYD sends this to one receiver on one WiFi channel after another to find
+ *    the channel it is on; the MAC layer ACK is the answer. It is also an empty command with a trailer.
+ *    UniRemoteRcvr throws it away; a receiver that does not know about it sees a zero-length command.
+ *
+ *    |0|U|P|ver|len| seq | channel |
+ *
+ * The announcement - a receiver broadcasts this at boot and when asked; UniRemoteCYD builds its directory
+ *    of receivers from them so a command card can use a short alias instead of the MAC address.
+ *    UniRemoteCYD broadcasts the request to announce at boot and when a card has an alias it doesn't know.
+ *    Both are empty commands with a trailer; the sender MAC address comes from ESP-NOW.
+ *
+ *    |0|U|A|ver|len| alias[2] | caps | reserved | name[16] |
+ *    |0|U|Q|ver|len| seq |
+ *
+ * All numbers are little-endian (as stored by the ESP32).
+ */
+
+#ifndef UNI_REMOTE_FRAMES_H
+#define UNI_REMOTE_FRAMES_H 1
+
+#define UNI_FRAME_TRAILER_MAGIC_0 'U'  // first byte of every trailer
+#define UNI_FRAME_TRAILER_HDR_LEN 4    // magic[2], version, len
+#define UNI_FRAME_TIMING_MAGIC_0 UNI_FRAME_TRAILER_MAGIC_0
+#define UNI_FRAME_TIMING_MAGIC_1 'T'   // second byte of timing trailer
+#define UNI_FRAME_TIMING_VERSION 1     // version of uni_frame_timing_t
+#define UNI_FRAME_EXEC_AT_MAGIC_1 'X'  // second byte of execute-at trailer
+#define UNI_FRAME_EXEC_AT_VERSION 1    // version of uni_frame_exec_at_t
+#define UNI_FRAME_BEACON_MAGIC_1 'B'   // second byte of time beacon
+#define UNI_FRAME_BEACON_VERSION 1     // version of uni_frame_beacon_t
+#define UNI_FRAME_PROBE_MAGIC_1 'P'    // second byte of channel probe
+#define UNI_FRAME_PROBE_VERSION 1      // version of uni_frame_probe_t
+#define UNI_FRAME_ANNOUNCE_MAGIC_1 'A' // second byte of announcement
+#define UNI_FRAME_ANNOUNCE_VERSION 1   // version of uni_frame_announce_t
+#define UNI_FRAME_ANNOUNCE_REQ_MAGIC_1 'Q' // second byte of request to announce
+#define UNI_FRAME_ANNOUNCE_REQ_VERSION 1   // version of uni_frame_announce_req_t
+#define UNI_FRAME_ANNOUNCE_ALIAS_LEN 2  // alias is 1 or 2 letters or digits; zero filled
+#define UNI_FRAME_ANNOUNCE_NAME_LEN 16  // name is up to 16 chars; zero filled, not always zero terminated
+
+// capabilities in the announcement
+#define UNI_FRAME_CAP_TIMING  0x01 // understands the timing trailer
+#define UNI_FRAME_CAP_EXEC_AT 0x02 // follows the time beacons and understands the execute-at trailer
+#define UNI_FRAME_CAP_OTA     0x04 // takes the OTA:WEB command
+
+// uni_frame_timing_t - the timing trailer
+//    All the usec times are from esp_timer_get_time() on the sender (UniRemoteCYD).
+//    The stages are:
+//      scan  - reading the command from the RFID card (or QR code)
+//      parse - decoding the MAC address and registering the ESP-NOW peer
+//      queue - from parse done until esp_now_send(); includes waiting for the operator if not "send immediately"
+//    The sender also measures the air time (esp_now_send() until the send callback with the MAC ACK).
+//      It is not known until after this message is sent, so the trailer carries the smallest air time
+//      seen so far to this receiver; the receiver uses it to estimate the clock offset.
+typedef struct __attribute__((packed)) {
+  uint8_t  magic[2];      // UNI_FRAME_TIMING_MAGIC_0, UNI_FRAME_TIMING_MAGIC_1
+  uint8_t  version;       // UNI_FRAME_TIMING_VERSION
+  uint8_t  len;           // sizeof(uni_frame_timing_t) for this version
+  uint32_t seq;           // sender command number
+  int64_t  usec_sent;     // sender esp_timer_get_time() just before esp_now_send()
+  uint32_t usec_scan;     // scan stage
+  uint32_t usec_parse;    // parse stage
+  uint32_t usec_queue;    // queue stage
+  uint32_t usec_air_min;  // smallest air time (send to MAC ACK) seen to this receiver; 0 if none yet
+} uni_frame_timing_t;
+
+// uni_frame_exec_at_t - the execute-at trailer
+//    usec_exec_at is the esp_timer_get_time() on the sender (UniRemoteCYD) when the receivers should act.
+//    Receivers convert it to their own clock using the time beacons (see uni_frame_beacon_t).
+typedef struct __attribute__((packed)) {
+  uint8_t  magic[2];      // UNI_FRAME_TRAILER_MAGIC_0, UNI_FRAME_EXEC_AT_MAGIC_1
+  uint8_t  version;       // UNI_FRAME_EXEC_AT_VERSION
+  uint8_t  len;           // sizeof(uni_frame_exec_at_t) for this version
+  int64_t  usec_exec_at;  // sender esp_timer_get_time() to execute the command
+} uni_frame_exec_at_t;
+
+// uni_frame_beacon_t - the time beacon trailer; sent to the broadcast address after a zero-length command
+//    Every receiver hears the same broadcast at (nearly) the same time, so whatever the air time is,
+//       it is the same for all of them and cancels out when they line up on an "execute at" time.
+//    usec_air_min is the smallest air time the sender has measured to any receiver (0 if none yet);
+//       receivers subtract half of it to get closer to the true offset.
+typedef struct __attribute__((packed)) {
+  uint8_t  magic[2];      // UNI_FRAME_TRAILER_MAGIC_0, UNI_FRAME_BEACON_MAGIC_1
+  uint8_t  version;       // UNI_FRAME_BEACON_VERSION
+  uint8_t  len;           // sizeof(uni_frame_beacon_t) for this version
+  uint32_t seq;           // beacon number; a gap means beacons were missed
+  int64_t  usec_sent;     // sender esp_timer_get_time() just before esp_now_send()
+  uint32_t usec_air_min;  // smallest air time (send to MAC ACK) seen to any receiver; 0 if none yet
+  uint32_t msec_period;   // how often the sender sends beacons
+} uni_frame_beacon_t;
+
+// uni_frame_probe_t - the channel probe trailer; sent to one receiver after a zero-length command
+//    ESP-NOW only reaches a receiver on the same WiFi channel. A receiver that connected to a router
+//       (for instance for OTA web update) is on the router's channel, not the one we started on.
+//    If the send callback says ESP_NOW_SEND_SUCCESS the receiver is on channel.
+typedef struct __attribute__((packed)) {
+  uint8_t  magic[2];      // UNI_FRAME_TRAILER_MAGIC_0, UNI_FRAME_PROBE_MAGIC_1
+  uint8_t  version;       // UNI_FRAME_PROBE_VERSION
+  uint8_t  len;           // sizeof(uni_frame_probe_t) for this version
+  uint32_t seq;           // probe number
+  uint8_t  channel;       // WiFi channel the sender is probing on
+} uni_frame_probe_t;
+
+// uni_frame_announce_t - the announcement trailer; sent to the broadcast address after a zero-length command
+//    A card can then say "K2|LED:ON" instead of "74:4d:bd:11:22:33|LED:ON"; alias "K2" is looked up in the directory.
+typedef struct __attribute__((packed)) {
+  uint8_t  magic[2];      // UNI_FRAME_TRAILER_MAGIC_0, UNI_FRAME_ANNOUNCE_MAGIC_1
+  uint8_t  version;       // UNI_FRAME_ANNOUNCE_VERSION
+  uint8_t  len;           // sizeof(uni_frame_announce_t) for this version
+  char     alias[UNI_FRAME_ANNOUNCE_ALIAS_LEN]; // short name for command cards; all zero if none
+  uint8_t  caps;          // UNI_FRAME_CAP_* bits
+  uint8_t  reserved;      // zero
+  char     name[UNI_FRAME_ANNOUNCE_NAME_LEN];   // name for people to read
+} uni_frame_announce_t;
+
+// uni_frame_announce_req_t - the request to announce trailer; sent to the broadcast address after a zero-length command
+typedef struct __attribute__((packed)) {
+  uint8_t  magic[2];      // UNI_FRAME_TRAILER_MAGIC_0, UNI_FRAME_ANNOUNCE_REQ_MAGIC_1
+  uint8_t  version;       // UNI_FRAME_ANNOUNCE_REQ_VERSION
+  uint8_t  len;           // sizeof(uni_frame_announce_req_t) for this version
+  uint32_t seq;           // request number
+} uni_frame_announce_req_t;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_frame_append_trailer() - append a trailer (magic, version and len already filled in)
+//       returns: new length of frame, or p_frame_len unchanged if the trailer does not fit
+//
+//    p_frame_ptr - frame that holds the command, its zero termination and any earlier trailers
+//    p_frame_len - length of the frame so far
+//    p_frame_max - size of the frame buffer; the result is kept below ESP_NOW_MAX_DATA_LEN
+//                  so that older receivers (which treat 250 bytes as "too big") still take it
+//
+static uint16_t uni_frame_append_trailer(uint8_t * p_frame_ptr, uint16_t p_frame_len, uint16_t p_frame_max, const void * p_trailer_ptr) {
+  uint16_t trailer_len = ((const uint8_t *) p_trailer_ptr)[3];
+  if ((p_frame_len + trailer_len > p_frame_max) ||
+      (p_frame_len + trailer_len >= ESP_NOW_MAX_DATA_LEN)) {
+    return(p_frame_len); // no room; send without it
+  }
+  memcpy(&p_frame_ptr[p_frame_len], p_trailer_ptr, trailer_len);
+  return(p_frame_len + trailer_len);
+} // end uni_frame_append_trailer()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_frame_find_trailer() - find a trailer after the zero-terminated command
+//       returns: pointer to the start of the trailer, or 0 if not found
+//
+//    p_frame_ptr - received frame
+//    p_frame_len - number of bytes received
+//    p_magic_1   - second magic byte of the wanted trailer (UNI_FRAME_TIMING_MAGIC_1 etc.)
+//    p_min_len   - smallest length we can use (sizeof() the version we know about)
+//
+static const uint8_t * uni_frame_find_trailer(const uint8_t * p_frame_ptr, uint16_t p_frame_len, uint8_t p_magic_1, uint16_t p_min_len) {
+  const uint8_t * zero_ptr = (const uint8_t *) memchr(p_frame_ptr, '\0', p_frame_len);
+  if ((const uint8_t *) 0 == zero_ptr) return((const uint8_t *) 0); // not even zero terminated
+  uint16_t idx = (zero_ptr - p_frame_ptr) + 1;  // first byte after zero termination
+
+  while ((p_frame_len - idx) >= UNI_FRAME_TRAILER_HDR_LEN) {
+    uint16_t len_after = p_frame_len - idx;     // number of bytes left
+    uint16_t trailer_len = p_frame_ptr[idx+3];
+    if (UNI_FRAME_TRAILER_MAGIC_0 != p_frame_ptr[idx]) break; // not a trailer
+    if ((trailer_len < UNI_FRAME_TRAILER_HDR_LEN) || (trailer_len > len_after)) break; // bad length
+    if (p_magic_1 == p_frame_ptr[idx+1]) {
+      if (trailer_len < p_min_len) break; // too short for what we know about
+      return(&p_frame_ptr[idx]);
+    }
+    idx += trailer_len; // skip trailers we are not looking for
+  }
+  return((const uint8_t *) 0);
+} // end uni_frame_find_trailer()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_frame_append_timing() - append timing trailer after the zero-terminated command
+//       returns: new length of frame, or p_frame_len unchanged if the trailer does not fit
+//
+//    p_frame_ptr - frame that holds the command and its zero termination
+//    p_frame_len - length of the command including the zero termination
+//    p_frame_max - size of the frame buffer
+//
+static uint16_t uni_frame_append_timing(uint8_t * p_frame_ptr, uint16_t p_frame_len, uint16_t p_frame_max, uni_frame_timing_t * p_timing_ptr) {
+  p_timing_ptr->magic[0] = UNI_FRAME_TIMING_MAGIC_0;
+  p_timing_ptr->magic[1] = UNI_FRAME_TIMING_MAGIC_1;
+  p_timing_ptr->version = UNI_FRAME_TIMING_VERSION;
+  p_timing_ptr->len = sizeof(uni_frame_timing_t);
+  return(uni_frame_append_trailer(p_frame_ptr, p_frame_len, p_frame_max, p_timing_ptr));
+} // end uni_frame_append_timing()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_frame_find_timing() - find timing trailer after the zero-terminated command
+//       returns: 1 if found (and copied to *p_timing_ptr), else 0
+//
+//    p_frame_ptr - received frame
+//    p_frame_len - number of bytes received
+//
+static uint16_t uni_frame_find_timing(const uint8_t * p_frame_ptr, uint16_t p_frame_len, uni_frame_timing_t * p_timing_ptr) {
+  const uint8_t * trailer_ptr = uni_frame_find_trailer(p_frame_ptr, p_frame_len, UNI_FRAME_TIMING_MAGIC_1, sizeof(uni_frame_timing_t));
+  if ((const uint8_t *) 0 == trailer_ptr) return(0);
+  memcpy(p_timing_ptr, trailer_ptr, sizeof(uni_frame_timing_t)); // newer versions may be longer; we only know this much
+  return(1);
+} // end uni_frame_find_timing()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_frame_append_exec_at() - append execute-at trailer
+//       returns: new length of frame, or p_frame_len unchanged if the trailer does not fit
+//
+//    same parameters as uni_frame_append_timing()
+//
+static uint16_t uni_frame_append_exec_at(uint8_t * p_frame_ptr, uint16_t p_frame_len, uint16_t p_frame_max, uni_frame_exec_at_t * p_exec_at_ptr) {
+  p_exec_at_ptr->magic[0] = UNI_FRAME_TRAILER_MAGIC_0;
+  p_exec_at_ptr->magic[1] = UNI_FRAME_EXEC_AT_MAGIC_1;
+  p_exec_at_ptr->version = UNI_FRAME_EXEC_AT_VERSION;
+  p_exec_at_ptr->len = sizeof(uni_frame_exec_at_t);
+  return(uni_frame_append_trailer(p_frame_ptr, p_frame_len, p_frame_max, p_exec_at_ptr));
+} // end uni_frame_append_exec_at()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_frame_find_exec_at() - find execute-at trailer after the zero-terminated command
+//       returns: 1 if found (and copied to *p_exec_at_ptr), else 0
+//
+static uint16_t uni_frame_find_exec_at(const uint8_t * p_frame_ptr, uint16_t p_frame_len, uni_frame_exec_at_t * p_exec_at_ptr) {
+  const uint8_t * trailer_ptr = uni_frame_find_trailer(p_frame_ptr, p_frame_len, UNI_FRAME_EXEC_AT_MAGIC_1, sizeof(uni_frame_exec_at_t));
+  if ((const uint8_t *) 0 == trailer_ptr) return(0);
+  memcpy(p_exec_at_ptr, trailer_ptr, sizeof(uni_frame_exec_at_t));
+  return(1);
+} // end uni_frame_find_exec_at()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_frame_make_beacon() - build a time beacon frame: zero-length command then beacon trailer
+//       returns: length of frame
+//
+//    p_frame_ptr - frame buffer; at least 1 + sizeof(uni_frame_beacon_t) bytes
+//    p_beacon_ptr - seq, usec_sent, usec_air_min and msec_period filled in by caller
+//
+static uint16_t uni_frame_make_beacon(uint8_t * p_frame_ptr, uint16_t p_frame_max, uni_frame_beacon_t * p_beacon_ptr) {
+  p_beacon_ptr->magic[0] = UNI_FRAME_TRAILER_MAGIC_0;
+  p_beacon_ptr->magic[1] = UNI_FRAME_BEACON_MAGIC_1;
+  p_beacon_ptr->version = UNI_FRAME_BEACON_VERSION;
+  p_beacon_ptr->len = sizeof(uni_frame_beacon_t);
+  p_frame_ptr[0] = '\0'; // zero-length command
+  return(uni_frame_append_trailer(p_frame_ptr, 1, p_frame_max, p_beacon_ptr));
+} // end uni_frame_make_beacon()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_frame_find_beacon() - see if this frame is a time beacon
+//       returns: 1 if it is (and copied to *p_beacon_ptr), else 0
+//
+static uint16_t uni_frame_find_beacon(const uint8_t * p_frame_ptr, uint16_t p_frame_len, uni_frame_beacon_t * p_beacon_ptr) {
+  if ((p_frame_len < 1) || ('\0' != p_frame_ptr[0])) return(0); // beacons have no command
+  const uint8_t * trailer_ptr = uni_frame_find_trailer(p_frame_ptr, p_frame_len, UNI_FRAME_BEACON_MAGIC_1, sizeof(uni_frame_beacon_t));
+  if ((const uint8_t *) 0 == trailer_ptr) return(0);
+  memcpy(p_beacon_ptr, trailer_ptr, sizeof(uni_frame_beacon_t));
+  return(1);
+} // end uni_frame_find_beacon()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_frame_make_probe() - build a channel probe frame: zero-length command then probe trailer
+//       returns: length of frame
+//
+//    p_frame_ptr - frame buffer; at least 1 + sizeof(uni_frame_probe_t) bytes
+//    p_probe_ptr - seq and channel filled in by caller
+//
+static uint16_t uni_frame_make_probe(uint8_t * p_frame_ptr, uint16_t p_frame_max, uni_frame_probe_t * p_probe_ptr) {
+  p_probe_ptr->magic[0] = UNI_FRAME_TRAILER_MAGIC_0;
+  p_probe_ptr->magic[1] = UNI_FRAME_PROBE_MAGIC_1;
+  p_probe_ptr->version = UNI_FRAME_PROBE_VERSION;
+  p_probe_ptr->len = sizeof(uni_frame_probe_t);
+  p_frame_ptr[0] = '\0'; // zero-length command
+  return(uni_frame_append_trailer(p_frame_ptr, 1, p_frame_max, p_probe_ptr));
+} // end uni_frame_make_probe()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_frame_is_probe() - see if this frame is a channel probe
+//       returns: 1 if it is, else 0
+//
+static uint16_t uni_frame_is_probe(const uint8_t * p_frame_ptr, uint16_t p_frame_len) {
+  if ((p_frame_len < 1) || ('\0' != p_frame_ptr[0])) return(0); // probes have no command
+  return(((const uint8_t *) 0 != uni_frame_find_trailer(p_frame_ptr, p_frame_len, UNI_FRAME_PROBE_MAGIC_1, sizeof(uni_frame_probe_t))) ? 1 : 0);
+} // end uni_frame_is_probe()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_frame_make_announce() - build an announcement frame: zero-length command then announcement trailer
+//       returns: length of frame
+//
+//    p_frame_ptr - frame buffer; at least 1 + sizeof(uni_frame_announce_t) bytes
+//    p_announce_ptr - alias, caps and name filled in by caller
+//
+static uint16_t uni_frame_make_announce(uint8_t * p_frame_ptr, uint16_t p_frame_max, uni_frame_announce_t * p_announce_ptr) {
+  p_announce_ptr->magic[0] = UNI_FRAME_TRAILER_MAGIC_0;
+  p_announce_ptr->magic[1] = UNI_FRAME_ANNOUNCE_MAGIC_1;
+  p_announce_ptr->version = UNI_FRAME_ANNOUNCE_VERSION;
+  p_announce_ptr->len = sizeof(uni_frame_announce_t);
+  p_announce_ptr->reserved = 0;
+  p_frame_ptr[0] = '\0'; // zero-length command
+  return(uni_frame_append_trailer(p_frame_ptr, 1, p_frame_max, p_announce_ptr));
+} // end uni_frame_make_announce()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_frame_find_announce() - see if this frame is an announcement
+//       returns: 1 if it is (and copied to *p_announce_ptr), else 0
+//
+static uint16_t uni_frame_find_announce(const uint8_t * p_frame_ptr, uint16_t p_frame_len, uni_frame_announce_t * p_announce_ptr) {
+  if ((p_frame_len < 1) || ('\0' != p_frame_ptr[0])) return(0); // announcements have no command
+  const uint8_t * trailer_ptr = uni_frame_find_trailer(p_frame_ptr, p_frame_len, UNI_FRAME_ANNOUNCE_MAGIC_1, sizeof(uni_frame_announce_t));
+  if ((const uint8_t *) 0 == trailer_ptr) return(0);
+  memcpy(p_announce_ptr, trailer_ptr, sizeof(uni_frame_announce_t));
+  return(1);
+} // end uni_frame_find_announce()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_frame_make_announce_req() - build a request to announce frame: zero-length command then request trailer
+//       returns: length of frame
+//
+//    p_frame_ptr - frame buffer; at least 1 + sizeof(uni_frame_announce_req_t) bytes
+//    p_req_ptr - seq filled in by caller
+//
+static uint16_t uni_frame_make_announce_req(uint8_t * p_frame_ptr, uint16_t p_frame_max, uni_frame_announce_req_t * p_req_ptr) {
+  p_req_ptr->magic[0] = UNI_FRAME_TRAILER_MAGIC_0;
+  p_req_ptr->magic[1] = UNI_FRAME_ANNOUNCE_REQ_MAGIC_1;
+  p_req_ptr->version = UNI_FRAME_ANNOUNCE_REQ_VERSION;
+  p_req_ptr->len = sizeof(uni_frame_announce_req_t);
+  p_frame_ptr[0] = '\0'; // zero-length command
+  return(uni_frame_append_trailer(p_frame_ptr, 1, p_frame_max, p_req_ptr));
+} // end uni_frame_make_announce_req()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_frame_is_announce_req() - see if this frame is a request to announce
+//       returns: 1 if it is, else 0
+//
+static uint16_t uni_frame_is_announce_req(const uint8_t * p_frame_ptr, uint16_t p_frame_len) {
+  if ((p_frame_len < 1) || ('\0' != p_frame_ptr[0])) return(0); // requests have no command
+  return(((const uint8_t *) 0 != uni_frame_find_trailer(p_frame_ptr, p_frame_len, UNI_FRAME_ANNOUNCE_REQ_MAGIC_1, sizeof(uni_frame_announce_req_t))) ? 1 : 0);
+} // end uni_frame_is_announce_req()
+
+#endif // UNI_REMOTE_FRAMES_H
@@ -0,0 +1,319 @@
+/* Author: https://github.com/Mark-MDO47  Mar. 9, 2025
+ *  https://github.com/Mark-MDO47/UniRemote
+ */
+
+/*
+   Copyright 2025 Mark Olson
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * UniRemoteJournal - events kept in flash, so after "the show went wrong" and a reset we can still see what happened
+ *
+ * Used by UniRemoteCYD as "../UniRemoteRcvrTemplate/UniRemoteJournal.h" and by UniRemoteRcvrTemplate from
+ *    the sketch directory (copy it along with UniRemoteRcvr.*). It needs a partition scheme with a
+ *    SPIFFS partition (most of them, including "Default"); LittleFS uses it.
+ *
+ * An event is a 16 byte record: sequence number, boot number, millis(), id and two args.
+ *    uni_journal_add() only puts it in RAM; it never waits for flash.
+ *    Records collect in a RAM page of UNI_JOURNAL_PAGE_BYTES (the flash page size). uni_journal_flush(),
+ *    from a periodic job at a quiet time, writes each full page with one write. A page that is not full
+ *    is written too once its first record is UNI_JOURNAL_FLUSH_MSEC old. While a full page waits for
+ *    the flush the next page fills; if that one fills too, records are dropped and counted, and a
+ *    "dropped" record says how many.
+ *
+ * Wear and size: the journal is UNI_JOURNAL_FILE_NUM files of at most UNI_JOURNAL_FILE_BYTES each.
+ *    When the file being written is full the oldest file is emptied and written next, so the journal
+ *    never takes more than their product and the writes go round all of it. LittleFS spreads them over
+ *    the flash blocks on top of that.
+ *
+ * At boot uni_journal_setup() finds the newest file from the sequence numbers, adds one to the boot
+ *    number and records why the ESP32 reset. A record cut short by power off is left out.
+ *
+ * uni_journal_dump() prints everything on Serial, oldest first:
+ *    JOURNAL boot <boot> seq <seq> files <num> bytes <bytes> flash_writes <num> flash_bytes <bytes> dropped <num>
+ *    JOURNAL <seq> <boot> <msec> <id name> <arg> <arg8>
+ *    JOURNAL end
+ *
+ * Everything here is static in the header: each sketch gets its own journal.
+ *    Only call these from loop() level (or setup()), never from a callback.
+ */
+
+#ifndef UNI_REMOTE_JOURNAL_H
+#define UNI_REMOTE_JOURNAL_H 1
+
+#include <Arduino.h>      // for Serial and millis()
+#include <LittleFS.h>     // the journal files
+#include <esp_system.h>   // for esp_reset_reason()
+#include "UniRemoteTimer.h" // for uni_msec_reached(); safe when millis() wraps
+
+#define UNI_JOURNAL_PAGE_BYTES 256      // flash page; records go to flash a page at a time
+#define UNI_JOURNAL_PAGE_NUM 2          // RAM pages: one fills while a full one waits for uni_journal_flush()
+#define UNI_JOURNAL_FILE_NUM 4          // files the journal goes round
+#define UNI_JOURNAL_FILE_BYTES 16384    // most bytes in one file; a multiple of UNI_JOURNAL_PAGE_BYTES
+#define UNI_JOURNAL_FLUSH_MSEC 10000    // a page that is not full goes to flash when its first record is this old
+#define UNI_JOURNAL_ID_NUM 32           // event ids are 0 to UNI_JOURNAL_ID_NUM-1
+#define UNI_JOURNAL_PATH "/journal%d.bin"
+
+#define UNI_JOURNAL_ID_BOOT    0        // arg is esp_reset_reason()
+#define UNI_JOURNAL_ID_DROPPED 1        // arg is how many records were dropped since the last of these
+#define UNI_JOURNAL_ID_FIRST   2        // first id for the sketch
+
+typedef struct {
+  uint32_t seq;                   // record number over all boots; starts at 1
+  uint32_t msec;                  // millis()
+  int32_t  arg;
+  uint16_t boot;                  // boot number; starts at 1
+  uint8_t  id;
+  uint8_t  arg8;
+} uni_journal_rec_t;
+#define UNI_JOURNAL_PAGE_RECS (UNI_JOURNAL_PAGE_BYTES / sizeof(uni_journal_rec_t))
+
+static uni_journal_rec_t g_uni_journal_pages[UNI_JOURNAL_PAGE_NUM][UNI_JOURNAL_PAGE_RECS];
+static uint8_t  g_uni_journal_page = 0;        // page being filled
+static uint16_t g_uni_journal_fill = 0;        // records in it
+static uint8_t  g_uni_journal_waiting = 0;     // full pages before it waiting for uni_journal_flush()
+static uint32_t g_uni_journal_msec_first = 0;  // millis() of the first record in the page being filled
+static uint32_t g_uni_journal_seq = 0;         // last sequence number used
+static uint16_t g_uni_journal_boot = 0;
+static uint32_t g_uni_journal_dropped = 0;     // dropped since the last "dropped" record
+static uint32_t g_uni_journal_dropped_num = 0; // dropped ever
+static uint32_t g_uni_journal_flash_writes = 0;
+static uint32_t g_uni_journal_flash_bytes = 0;
+static uint8_t  g_uni_journal_ok = 0;          // non-zero: LittleFS is mounted
+static uint8_t  g_uni_journal_file = 0;        // file being written
+static uint32_t g_uni_journal_file_size = 0;   // its size
+static File     g_uni_journal_f;               // it, open to append
+static const char * g_uni_journal_names[UNI_JOURNAL_ID_NUM];
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_journal_name() - name an event id for uni_journal_dump()
+//       returns: zero if OK; non-zero if p_id is too big
+//
+static int16_t uni_journal_name(uint8_t p_id, const char * p_name) {
+  if (p_id >= UNI_JOURNAL_ID_NUM) return(-1);
+  g_uni_journal_names[p_id] = p_name;
+  return(0);
+} // end uni_journal_name()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_journal_path() - file name of journal file p_file
+//       returns: p_path
+//
+static char * uni_journal_path(char * p_path, uint8_t p_file) {
+  sprintf(p_path, UNI_JOURNAL_PATH, p_file);
+  return(p_path);
+} // end uni_journal_path()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_journal_add() - record an event in RAM; uni_journal_flush() writes it to flash later
+//       returns: nothing
+//
+static void uni_journal_add(uint8_t p_id, int32_t p_arg, uint8_t p_arg8) {
+  if (g_uni_journal_fill >= UNI_JOURNAL_PAGE_RECS) {
+    // page is full; the next one if it is not waiting too
+    if ((g_uni_journal_waiting + 1) >= UNI_JOURNAL_PAGE_NUM) {
+      g_uni_journal_dropped += 1;
+      g_uni_journal_dropped_num += 1;
+      return;
+    }
+    g_uni_journal_waiting += 1;
+    g_uni_journal_page = (g_uni_journal_page + 1) % UNI_JOURNAL_PAGE_NUM;
+    g_uni_journal_fill = 0;
+  }
+  uni_journal_rec_t * rec_ptr = &g_uni_journal_pages[g_uni_journal_page][g_uni_journal_fill];
+  if (0 == g_uni_journal_fill) g_uni_journal_msec_first = millis();
+  g_uni_journal_seq += 1;
+  rec_ptr->seq = g_uni_journal_seq;
+  rec_ptr->msec = millis();
+  rec_ptr->arg = p_arg;
+  rec_ptr->boot = g_uni_journal_boot;
+  rec_ptr->id = p_id;
+  rec_ptr->arg8 = p_arg8;
+  g_uni_journal_fill += 1;
+} // end uni_journal_add()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_journal_open() - open journal file p_file to append; empty it first if p_empty
+//       returns: zero if OK
+//
+static int16_t uni_journal_open(uint8_t p_file, uint8_t p_empty) {
+  char path[24];
+  if (g_uni_journal_f) g_uni_journal_f.close();
+  g_uni_journal_f = LittleFS.open(uni_journal_path(path, p_file), (0 != p_empty) ? "w" : "a");
+  if (!g_uni_journal_f) return(-1);
+  g_uni_journal_file = p_file;
+  g_uni_journal_file_size = g_uni_journal_f.size();
+  return(0);
+} // end uni_journal_open()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_journal_write() - p_num records to flash with one write; the next file first if they do not fit
+//       returns: zero if OK
+//
+static int16_t uni_journal_write(const uni_journal_rec_t * p_recs, uint16_t p_num) {
+  uint32_t bytes = p_num * sizeof(uni_journal_rec_t);
+  if ((g_uni_journal_file_size + bytes) > UNI_JOURNAL_FILE_BYTES) {
+    if (0 != uni_journal_open((g_uni_journal_file + 1) % UNI_JOURNAL_FILE_NUM, 1)) return(-1);
+  }
+  size_t written = g_uni_journal_f.write((const uint8_t *) p_recs, bytes);
+  g_uni_journal_f.flush();
+  g_uni_journal_file_size += written;
+  g_uni_journal_flash_writes += 1;
+  g_uni_journal_flash_bytes += written;
+  return((written == bytes) ? 0 : -1);
+} // end uni_journal_write()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_journal_flush() - write the full pages to flash, and the page being filled if it is old enough
+//       returns: number of flash writes done
+//
+// p_all - non-zero to write the page being filled whatever its age
+// p_msec_now may be from before the newest record (taken at the top of loop()); that page is young, not old
+//
+static uint16_t uni_journal_flush(uint32_t p_msec_now, uint8_t p_all) {
+  uint16_t write_num = 0;
+  if (0 == g_uni_journal_ok) return(0);
+  while (g_uni_journal_waiting > 0) {
+    uint8_t page = (g_uni_journal_page + UNI_JOURNAL_PAGE_NUM - g_uni_journal_waiting) % UNI_JOURNAL_PAGE_NUM;
+    uni_journal_write(g_uni_journal_pages[page], UNI_JOURNAL_PAGE_RECS);
+    g_uni_journal_waiting -= 1;
+    write_num += 1;
+  }
+  if (0 != g_uni_journal_dropped) {
+    int32_t dropped = (int32_t) g_uni_journal_dropped;
+    g_uni_journal_dropped = 0;
+    uni_journal_add(UNI_JOURNAL_ID_DROPPED, dropped, 0); // there is room now
+  }
+  if ((g_uni_journal_fill > 0) &&
+      ((0 != p_all) || (g_uni_journal_fill >= UNI_JOURNAL_PAGE_RECS) || uni_msec_reached(p_msec_now, g_uni_journal_msec_first + UNI_JOURNAL_FLUSH_MSEC))) {
+    uni_journal_write(g_uni_journal_pages[g_uni_journal_page], g_uni_journal_fill);
+    g_uni_journal_fill = 0;
+    write_num += 1;
+  }
+  return(write_num);
+} // end uni_journal_flush()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_journal_setup() - mount LittleFS, find where the journal left off and record this boot
+//       returns: zero if OK; non-zero if there is no journal (events are still kept in RAM)
+//
+static int16_t uni_journal_setup() {
+  char path[24];
+  uni_journal_rec_t rec;
+  uint32_t seq_max = 0;
+  uint8_t file_newest = 0;
+  uint8_t newest_full = 0;
+
+  g_uni_journal_ok = LittleFS.begin(true) ? 1 : 0; // format it if it will not mount
+  if (0 != g_uni_journal_ok) {
+    for (uint8_t file = 0; file < UNI_JOURNAL_FILE_NUM; file++) {
+      File f = LittleFS.open(uni_journal_path(path, file), "r");
+      if (!f) continue;
+      size_t size = f.size();
+      size_t rec_num = size / sizeof(rec); // a record cut short by power off is left out
+      if ((rec_num > 0) && f.seek((rec_num - 1) * sizeof(rec)) && (sizeof(rec) == f.read((uint8_t *) &rec, sizeof(rec))) &&
+          (rec.seq > seq_max)) {
+        seq_max = rec.seq;
+        g_uni_journal_boot = rec.boot;
+        file_newest = file;
+        // do not append after a cut short record or to a full file
+        newest_full = ((0 != (size % sizeof(rec))) || (size >= UNI_JOURNAL_FILE_BYTES)) ? 1 : 0;
+      }
+      f.close();
+    }
+    g_uni_journal_seq = seq_max;
+    if (0 != newest_full) g_uni_journal_ok = (0 == uni_journal_open((file_newest + 1) % UNI_JOURNAL_FILE_NUM, 1)) ? 1 : 0;
+    else                  g_uni_journal_ok = (0 == uni_journal_open(file_newest, (0 == seq_max) ? 1 : 0)) ? 1 : 0;
+  }
+  g_uni_journal_boot += 1;
+  uni_journal_name(UNI_JOURNAL_ID_BOOT, "boot");
+  uni_journal_name(UNI_JOURNAL_ID_DROPPED, "dropped");
+  uni_journal_add(UNI_JOURNAL_ID_BOOT, (int32_t) esp_reset_reason(), 0);
+  return((0 != g_uni_journal_ok) ? 0 : -1);
+} // end uni_journal_setup()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_journal_dump() - everything in the journal on Serial, oldest first; format at top of file
+//       returns: nothing
+//
+// writes what is in RAM first
+//
+static void uni_journal_dump() {
+  char path[24];
+  uni_journal_rec_t recs[UNI_JOURNAL_PAGE_RECS];
+  uint32_t bytes = 0;
+
+  uni_journal_flush(millis(), 1);
+  for (uint8_t file = 0; (0 != g_uni_journal_ok) && (file < UNI_JOURNAL_FILE_NUM); file++) {
+    if (LittleFS.exists(uni_journal_path(path, file))) {
+      File f = LittleFS.open(path, "r");
+      if (f) { bytes += f.size(); f.close(); }
+    }
+  }
+  Serial.printf("JOURNAL boot %u seq %lu files %d bytes %lu flash_writes %lu flash_bytes %lu dropped %lu\n",
+    g_uni_journal_boot, (unsigned long) g_uni_journal_seq, (0 != g_uni_journal_ok) ? UNI_JOURNAL_FILE_NUM : 0, (unsigned long) bytes,
+    (unsigned long) g_uni_journal_flash_writes, (unsigned long) g_uni_journal_flash_bytes, (unsigned long) g_uni_journal_dropped_num);
+  // the file after the one being written is the oldest
+  for (uint8_t num = 1; (0 != g_uni_journal_ok) && (num <= UNI_JOURNAL_FILE_NUM); num++) {
+    File f = LittleFS.open(uni_journal_path(path, (g_uni_journal_file + num) % UNI_JOURNAL_FILE_NUM), "r");
+    if (!f) continue;
+    size_t got;
+    while ((got = f.read((uint8_t *) recs, sizeof(recs))) >= sizeof(recs[0])) {
+      for (uint16_t idx = 0; idx < (got / sizeof(recs[0])); idx++) {
+        const uni_journal_rec_t * rec_ptr = &recs[idx];
+        const char * name = (rec_ptr->id < UNI_JOURNAL_ID_NUM) ? g_uni_journal_names[rec_ptr->id] : NULL;
+        if (NULL != name) Serial.printf("JOURNAL %lu %u %lu %s %ld %u\n", (unsigned long) rec_ptr->seq, rec_ptr->boot,
+                            (unsigned long) rec_ptr->msec, name, (long) rec_ptr->arg, rec_ptr->arg8);
+        else              Serial.printf("JOURNAL %lu %u %lu id%u %ld %u\n", (unsigned long) rec_ptr->seq, rec_ptr->boot,
+                            (unsigned long) rec_ptr->msec, rec_ptr->id, (long) rec_ptr->arg, rec_ptr->arg8);
+      }
+    }
+    f.close();
+  }
+  Serial.printf("JOURNAL end\n");
+} // end uni_journal_dump()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_journal_clear() - empty all the journal files; sequence and boot numbers go on
+//       returns: nothing
+//
+static void uni_journal_clear() {
+  char path[24];
+  if (0 == g_uni_journal_ok) return;
+  if (g_uni_journal_f) g_uni_journal_f.close();
+  for (uint8_t file = 0; file < UNI_JOURNAL_FILE_NUM; file++) {
+    if (LittleFS.exists(uni_journal_path(path, file))) LittleFS.remove(path);
+  }
+  g_uni_journal_waiting = 0;
+  g_uni_journal_fill = 0;
+  g_uni_journal_ok = (0 == uni_journal_open(0, 1)) ? 1 : 0;
+} // end uni_journal_clear()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_journal_cmd() - Serial command "journal": print the journal; "journal clear" empties it
+//       returns: nothing
+//
+// register it with uni_serial_cmd_add() (UniRemoteSerialCmd.h)
+//
+static void uni_journal_cmd(const char * p_args) {
+  if (0 == strcmp(p_args, "clear")) {
+    uni_journal_clear();
+    Serial.printf("JOURNAL cleared\n");
+  } else {
+    uni_journal_dump();
+  }
+} // end uni_journal_cmd()
+
+#endif // UNI_REMOTE_JOURNAL_H
@@ -0,0 +1,181 @@
+/* Author: https://github.com/Mark-MDO47  Mar. 4, 2025
+ *  https://github.com/Mark-MDO47/UniRemote
+ */
+
+/*
+   Copyright 2025 Mark Olson
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * UniRemotePerf - performance counters and latency histograms for the UniRemote sketches
+ *
+ * Used by UniRemoteCYD as "../UniRemoteRcvrTemplate/UniRemotePerf.h"; a receiver can copy it along
+ *    with UniRemoteRcvr.* the same as UniRemoteTimer.h.
+ *
+ * A histogram counts values (usually microseconds) in buckets by powers of two: bucket b holds the
+ *    values with b significant bits, so bucket 0 is 0, bucket 1 is 1, bucket 2 is 2-3, bucket 3 is 4-7
+ *    and so on up to bucket UNI_PERF_BUCKETS-1, which holds everything bigger. Adding a value is a
+ *    count-leading-zeros and an increment, cheap enough to do every time through loop().
+ *    Percentiles are only as good as the bucket: p90 is the top of the bucket holding the 90th percentile.
+ *
+ * A counter is a pointer to a uint32_t the sketch already keeps; it just gets a name for the dump.
+ *
+ * uni_perf_dump() prints everything on Serial, one line each, for a script to parse:
+ *    PERF hist <name> n <num> min <min> avg <avg> max <max> p50 <p50> p90 <p90> p99 <p99> b <b0>,<b1>,...
+ *    PERF ctr <name> <value>
+ *    PERF end
+ *    trailing empty buckets are left off
+ *
+ * Everything here is static in the header: each sketch gets its own tables.
+ *    Histograms are added to and dumped at loop() level only. A counter may be written by a callback;
+ *    it is only read here.
+ */
+
+#ifndef UNI_REMOTE_PERF_H
+#define UNI_REMOTE_PERF_H 1
+
+#include <Arduino.h>  // for Serial
+
+#define UNI_PERF_BUCKETS 24       // bucket 23 holds 4194304 usec (4.2 sec) and up
+#define UNI_PERF_HIST_NUM 16      // most histograms registered
+#define UNI_PERF_CTR_NUM 16       // most counters registered
+
+typedef struct {
+  const char * name;
+  uint32_t num;                   // values added
+  uint32_t min;                   // smallest value; meaningless if num is zero
+  uint32_t max;                   // largest value
+  uint64_t sum;                   // for the average
+  uint32_t buckets[UNI_PERF_BUCKETS];
+} uni_perf_hist_t;
+
+typedef struct {
+  const char * name;
+  const uint32_t * value_ptr;     // the sketch's own counter
+} uni_perf_ctr_t;
+
+static uni_perf_hist_t * g_uni_perf_hists[UNI_PERF_HIST_NUM];
+static uint16_t g_uni_perf_hist_num = 0;
+static uni_perf_ctr_t g_uni_perf_ctrs[UNI_PERF_CTR_NUM];
+static uint16_t g_uni_perf_ctr_num = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_perf_hist_clear() - start a histogram over
+//       returns: nothing
+//
+static void uni_perf_hist_clear(uni_perf_hist_t * p_hist) {
+  const char * name = p_hist->name;
+  memset(p_hist, 0, sizeof(*p_hist));
+  p_hist->name = name;
+} // end uni_perf_hist_clear()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_perf_hist_register() - name a histogram, clear it and add it to the dump
+//       returns: zero if OK; non-zero if UNI_PERF_HIST_NUM are already registered (it is still cleared and usable)
+//
+static int16_t uni_perf_hist_register(uni_perf_hist_t * p_hist, const char * p_name) {
+  p_hist->name = p_name;
+  uni_perf_hist_clear(p_hist);
+  if (g_uni_perf_hist_num >= UNI_PERF_HIST_NUM) return(-1);
+  g_uni_perf_hists[g_uni_perf_hist_num++] = p_hist;
+  return(0);
+} // end uni_perf_hist_register()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_perf_ctr_register() - name a counter the sketch keeps and add it to the dump
+//       returns: zero if OK; non-zero if UNI_PERF_CTR_NUM are already registered
+//
+static int16_t uni_perf_ctr_register(const uint32_t * p_value_ptr, const char * p_name) {
+  if (g_uni_perf_ctr_num >= UNI_PERF_CTR_NUM) return(-1);
+  g_uni_perf_ctrs[g_uni_perf_ctr_num].name = p_name;
+  g_uni_perf_ctrs[g_uni_perf_ctr_num].value_ptr = p_value_ptr;
+  g_uni_perf_ctr_num += 1;
+  return(0);
+} // end uni_perf_ctr_register()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_perf_hist_add() - count one value
+//       returns: nothing
+//
+static inline void uni_perf_hist_add(uni_perf_hist_t * p_hist, uint32_t p_val) {
+  uint16_t bucket = (0 == p_val) ? 0 : (uint16_t) (32 - __builtin_clz(p_val));
+  if (bucket >= UNI_PERF_BUCKETS) bucket = UNI_PERF_BUCKETS - 1;
+  p_hist->buckets[bucket] += 1;
+  if ((0 == p_hist->num) || (p_val < p_hist->min)) p_hist->min = p_val;
+  if (p_val > p_hist->max) p_hist->max = p_val;
+  p_hist->num += 1;
+  p_hist->sum += p_val;
+} // end uni_perf_hist_add()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_perf_hist_pct() - approximate percentile
+//       returns: top of the bucket that holds the p_pct percentile, but no more than max; zero if empty
+//
+static uint32_t uni_perf_hist_pct(const uni_perf_hist_t * p_hist, uint16_t p_pct) {
+  if (0 == p_hist->num) return(0);
+  uint32_t want = (uint32_t) (((uint64_t) p_hist->num * p_pct + 99) / 100); // rank, rounded up
+  uint32_t seen = 0;
+  for (uint16_t bucket = 0; bucket < UNI_PERF_BUCKETS; bucket++) {
+    seen += p_hist->buckets[bucket];
+    if (seen >= want) {
+      uint32_t top = (0 == bucket) ? 0 : (uint32_t) ((1ULL << bucket) - 1);
+      return((top < p_hist->max) ? top : p_hist->max);
+    }
+  }
+  return(p_hist->max);
+} // end uni_perf_hist_pct()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_perf_hist_avg() - average
+//       returns: average value; zero if empty
+//
+static inline uint32_t uni_perf_hist_avg(const uni_perf_hist_t * p_hist) {
+  return((0 == p_hist->num) ? 0 : (uint32_t) (p_hist->sum / p_hist->num));
+} // end uni_perf_hist_avg()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_perf_clear() - start all registered histograms over; counters belong to the sketch and are not touched
+//       returns: nothing
+//
+static void uni_perf_clear() {
+  for (uint16_t idx = 0; idx < g_uni_perf_hist_num; idx++) uni_perf_hist_clear(g_uni_perf_hists[idx]);
+} // end uni_perf_clear()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_perf_dump() - print all registered histograms and counters on Serial; format at top of file
+//       returns: nothing
+//
+static void uni_perf_dump() {
+  for (uint16_t idx = 0; idx < g_uni_perf_hist_num; idx++) {
+    const uni_perf_hist_t * hist_ptr = g_uni_perf_hists[idx];
+    int16_t last = UNI_PERF_BUCKETS - 1;
+    while ((last > 0) && (0 == hist_ptr->buckets[last])) last -= 1;
+    Serial.printf("PERF hist %s n %lu min %lu avg %lu max %lu p50 %lu p90 %lu p99 %lu b ", hist_ptr->name,
+      (unsigned long) hist_ptr->num, (unsigned long) ((0 == hist_ptr->num) ? 0 : hist_ptr->min),
+      (unsigned long) uni_perf_hist_avg(hist_ptr), (unsigned long) hist_ptr->max,
+      (unsigned long) uni_perf_hist_pct(hist_ptr, 50), (unsigned long) uni_perf_hist_pct(hist_ptr, 90),
+      (unsigned long) uni_perf_hist_pct(hist_ptr, 99));
+    for (int16_t bucket = 0; bucket <= last; bucket++) {
+      Serial.printf((0 == bucket) ? "%lu" : ",%lu", (unsigned long) hist_ptr->buckets[bucket]);
+    }
+    Serial.printf("\n");
+  }
+  for (uint16_t idx = 0; idx < g_uni_perf_ctr_num; idx++) {
+    Serial.printf("PERF ctr %s %lu\n", g_uni_perf_ctrs[idx].name, (unsigned long) *g_uni_perf_ctrs[idx].value_ptr);
+  }
+  Serial.printf("PERF end\n");
+} // end uni_perf_dump()
+
+#endif // UNI_REMOTE_PERF_H
@@ -28,7 +28,7 @@
  * Below is a list of the codes specific to UniRemoteRcvr
  * UNI_REMOTE_RCVR_OK                   same as ESP_OK
  * UNI_REMOTE_RCVR_ERR_CBUF_MSG_DROPPED circular buffer _put() called but no room in circular buffer; message dropped
- * UNI_REMOTE_RCVR_ERR_MSG_TOO_BIG      ESP-NOW rcvr callback message bigger than ESP-NOW allows (cannot happen)
+ * UNI_REMOTE_RCVR_ERR_MSG_TOO_BIG      ESP-NOW rcvr callback message bigger than UNI_REMOTE_RCVR_MAX_MSG_LEN
  * UNI_REMOTE_RCVR_INFO_NO_MSG_2_GET    circular buffer _get() called but circular buffer is empty
  *                                      NOTE: this status only used internally, not returned to callers
  *
@@ -54,107 +54,343 @@
 */
 
 #include <UniRemoteRcvr.h>  // for UniRemoteRcvr "library"
+#include "UniRemoteFrames.h" // for the optional trailers after the command and the time beacon
+#include <esp_wifi.h>        // for esp_wifi_get_mac()
+#include <esp_task_wdt.h>    // for esp_task_wdt_reset() while waiting for "execute at"
 
-// definitions to support ESP-NOW
-#define UNI_ESP_NOW_HDR_MAC_OFFSET 12 // This is where the MAC address is on my system
+// the circular buffer of ESP-NOW messages; sizes and storage are chosen in UniRemoteRcvr.h
+//   the ESP-NOW rcvr callback is the only caller of put(); uni_remote_rcvr_get_msg() is the only caller of get()
+static uni_remote_rcvr_queue_t g_circ_buf;
 
-// private definitions for circular buffer of ESP-NOW messages
-#define UNI_REMOTE_RCVR_NUM_BUFR 3 // number of buffers for messages
+// time beacons from the ESP-NOW rcvr callback waiting for loop() to use them
+//   same rules as g_circ_buf: the callback only calls put(), loop() level only calls get()
+//   each entry is a zero byte (so it is never zero-terminated on top of), the sender MAC address, then the beacon
+#define UNI_REMOTE_RCVR_BEACON_ENTRY_LEN (1 + ESP_NOW_ETH_ALEN + sizeof(uni_frame_beacon_t))
+static UniRemoteRcvrSlotStorage<UNI_REMOTE_RCVR_BEACON_QUEUE_NUM, UNI_REMOTE_RCVR_BEACON_ENTRY_LEN> g_beacon_buf;
+static uint32_t g_beacon_dropped_num = 0; // only written by the callback
+
+// our announcement; filled in by uni_remote_rcvr_announce(), sent again at loop() level when asked
+static_assert(UNI_REMOTE_RCVR_CAP_OTA == UNI_FRAME_CAP_OTA, "UNI_REMOTE_RCVR_CAP_OTA must match UniRemoteFrames.h");
+static uni_frame_announce_t g_announce;
+static uint16_t g_announce_ready = 0;      // non-zero after uni_remote_rcvr_announce()
+static uint32_t g_announce_req_num = 0;    // requests to announce heard; only written by the callback
+static uint32_t g_announce_req_seen = 0;   // g_announce_req_num when loop() level last looked
+static uint16_t g_announce_pending = 0;    // non-zero == answer a request at g_announce_msec_due
+static uint32_t g_announce_msec_due = 0;
+static uint32_t g_announce_jitter_msec = 0;
+static const uint8_t g_announce_broadcast_mac_addr[ESP_NOW_ETH_ALEN] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_remote_rcvr_callback() - callback function that will be executed when data is received
+//    p_info_ptr has the sender MAC address and, in rx_ctrl, the signal strength
+static void uni_remote_rcvr_callback(const esp_now_recv_info_t * p_info_ptr, const uint8_t *p_recv_data, int p_recv_len) {
+  int64_t usec_rcvd = esp_timer_get_time(); // first so beacon time is as accurate as we can make it
+  uni_frame_beacon_t beacon;
+
+  // time beacons only adjust our idea of the sender clock; they are not passed on to loop()
+  if ((p_recv_len > 0) && (0 != uni_frame_find_beacon(p_recv_data, (uint16_t) p_recv_len, &beacon))) {
+    uint8_t entry[UNI_REMOTE_RCVR_BEACON_ENTRY_LEN];
+    entry[0] = '\0';
+    memcpy(&entry[1], p_info_ptr->src_addr, ESP_NOW_ETH_ALEN);
+    memcpy(&entry[1+ESP_NOW_ETH_ALEN], &beacon, sizeof(beacon));
+    if (!g_beacon_buf.put(entry, sizeof(entry), 0, usec_rcvd)) g_beacon_dropped_num += 1;
+    return;
+  }
+
+  // channel probes are answered by the MAC layer ACK; nothing for loop() to do
+  if ((p_recv_len > 0) && (0 != uni_frame_is_probe(p_recv_data, (uint16_t) p_recv_len))) return;
+
+  // requests to announce are answered at loop() level; announcements from other receivers are not for us
+  if ((p_recv_len > 0) && (0 != uni_frame_is_announce_req(p_recv_data, (uint16_t) p_recv_len))) {
+    g_announce_req_num += 1;
+    return;
+  }
+  uni_frame_announce_t announce;
+  if ((p_recv_len > 0) && (0 != uni_frame_find_announce(p_recv_data, (uint16_t) p_recv_len, &announce))) return;
+
+  // signal strength of this message
+  int16_t rssi = 0;
+#if UNI_REMOTE_RCVR_TRACK_RSSI
+  if ((wifi_pkt_rx_ctrl_t *) 0 != p_info_ptr->rx_ctrl) rssi = p_info_ptr->rx_ctrl->rssi;
+#endif // UNI_REMOTE_RCVR_TRACK_RSSI
+
+  // put data into buffer; put() reports if it cannot do it
+  g_circ_buf.put(p_info_ptr->src_addr, p_recv_data, p_recv_len, rssi);
+  return;
+} // end uni_remote_rcvr_callback()
+
+// clock offset to each sender; only used from uni_remote_rcvr_get_msg_timed() so no locking needed
 typedef struct {
-  char msg[ESP_NOW_MAX_DATA_LEN];     // received message
-  uint8_t mac_addr[ESP_NOW_ETH_ALEN]; // sender MAC address
-  uint16_t msg_len;                   // length including trailing zero byte
-  uint16_t msg_num;                   // msg num; may skip if messages discarded
-  int16_t msg_status;                 // status for this individual message. Almost certainly ESP_OK
-} uni_remote_rcvr_circular_buffer_entry_t;
+  uint8_t  mac_addr[ESP_NOW_ETH_ALEN]; // sender MAC address
+  uint16_t in_use;                     // non-zero == this entry is for mac_addr
+  uint16_t idx_next;                   // next sample to replace
+  uint16_t num;                        // number of valid samples
+  int64_t  usec_sample[UNI_REMOTE_RCVR_CLOCK_WINDOW]; // receive time minus send time
+} uni_remote_rcvr_clock_t;
+static uni_remote_rcvr_clock_t g_clocks[UNI_REMOTE_RCVR_MAX_SENDERS];
+static uint16_t g_clock_idx_replace = 0;         // round-robin: next entry to re-use when all are in use
+
+static uni_remote_rcvr_msg_timing_t g_msg_timing; // timing for last message returned
+static int64_t g_msg_usec_got = 0;               // esp_timer_get_time() when last message returned
+static int16_t g_msg_has_exec_at = 0;            // non-zero if last message returned has a usable "execute at"
+static int64_t g_msg_usec_exec_at = 0;           // "execute at" for last message returned, in our esp_timer_get_time()
 
+// clock offset and drift from the time beacons; only used at loop() level so no locking needed
+//    follows one beacon sender at a time
 typedef struct {
-  uni_remote_rcvr_cbuf_extended_status_t  info;
-  uni_remote_rcvr_circular_buffer_entry_t entries[UNI_REMOTE_RCVR_NUM_BUFR];
-} uni_remote_rcvr_circular_buffer_t;
-static uni_remote_rcvr_circular_buffer_t g_circ_buf; // 
+  uint8_t  mac_addr[ESP_NOW_ETH_ALEN]; // beacon sender MAC address
+  uint16_t in_use;                     // non-zero == following the beacons from mac_addr
+  uint16_t idx_next;                   // next window sample to replace
+  uint16_t num;                        // number of valid window samples
+  uint16_t block_num;                  // beacons since the start of this drift block
+  uint16_t have_block;                 // non-zero == usec_block_ref and usec_block_offset are valid
+  uint16_t have_drift;                 // non-zero == drift_ppb is valid
+  uint32_t beacon_num;                 // beacons used
+  uint32_t beacon_missed_num;          // gaps in seq
+  uint32_t seq_last;                   // seq of most recent beacon
+  uint32_t usec_air_min;               // from most recent beacon
+  uint32_t msec_period;                // from most recent beacon
+  uint32_t usec_jitter;                // spread of the window samples after removing drift
+  int32_t  drift_ppb;                  // how fast the offset changes; parts per billion
+  int64_t  usec_rcvd_last;             // our time of most recent beacon
+  int64_t  usec_ref;                   // our time that usec_offset_ref is for
+  int64_t  usec_offset_ref;            // smallest (receive time - send time) projected to usec_ref
+  int64_t  usec_block_ref;             // our time at the end of the previous drift block
+  int64_t  usec_block_offset;          // usec_offset_ref at the end of the previous drift block
+  int64_t  usec_rcvd[UNI_REMOTE_RCVR_BEACON_WINDOW];  // our time for each window sample
+  int64_t  usec_sample[UNI_REMOTE_RCVR_BEACON_WINDOW]; // receive time minus send time
+} uni_remote_rcvr_beacon_clock_t;
+static uni_remote_rcvr_beacon_clock_t g_beacon_clock;
+#define UNI_REMOTE_RCVR_DRIFT_MAX_PPB 200000 // 200 ppm; anything bigger is not a crystal, ignore it
+
+// "execute at" results; only written by uni_remote_rcvr_wait_until()
+static uint32_t g_exec_num = 0;
+static uint32_t g_exec_late_num = 0;
+static int32_t  g_usec_exec_err_last = 0;
+static uint32_t g_usec_exec_err_max = 0;
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
-// uni_remote_rcvr_circ_buf_inc_idx() - return value of incremented index - doesn't check for full
-static uint16_t uni_remote_rcvr_circ_buf_inc_idx(uint16_t p_idx) {
-  // this could be shorter but I wanted it to be clearer
-  uint16_t new_idx = p_idx + 1;
-  if (new_idx >= g_circ_buf.info.idx_num) {
-    new_idx = 0;
+// uni_remote_rcvr_clock_min() - add a sample for this sender, return minimum over the window
+//
+// (receive time - send time) is the clock offset plus the delay for this message. The delay is
+//    never less than the true minimum delay, so the smallest sample is the best offset estimate.
+//    Only the last UNI_REMOTE_RCVR_CLOCK_WINDOW samples are used so that clock drift is followed.
+static int64_t uni_remote_rcvr_clock_min(const uint8_t * p_mac_addr_ptr, int64_t p_usec_sample) {
+  uni_remote_rcvr_clock_t * clock_ptr = (uni_remote_rcvr_clock_t *) 0;
+  uint16_t i;
+
+  for (i = 0; i < UNI_REMOTE_RCVR_MAX_SENDERS; i++) {
+    if ((0 != g_clocks[i].in_use) && (0 == memcmp(g_clocks[i].mac_addr, p_mac_addr_ptr, ESP_NOW_ETH_ALEN))) {
+      clock_ptr = &g_clocks[i];
+      break;
+    }
+  }
+  if ((uni_remote_rcvr_clock_t *) 0 == clock_ptr) { // new sender; use free entry or re-use one
+    for (i = 0; i < UNI_REMOTE_RCVR_MAX_SENDERS; i++) {
+      if (0 == g_clocks[i].in_use) break;
+    }
+    if (i >= UNI_REMOTE_RCVR_MAX_SENDERS) {
+      i = g_clock_idx_replace;
+      g_clock_idx_replace = (g_clock_idx_replace + 1) % UNI_REMOTE_RCVR_MAX_SENDERS;
+    }
+    clock_ptr = &g_clocks[i];
+    memcpy(clock_ptr->mac_addr, p_mac_addr_ptr, ESP_NOW_ETH_ALEN);
+    clock_ptr->in_use = 1;
+    clock_ptr->idx_next = clock_ptr->num = 0;
   }
-  return(new_idx);
-} // end uni_remote_rcvr_circ_buf_inc_idx()
 
-/////////////////////////////////////////////////////////////////////////////////////////////////////////
-// uni_remote_rcvr_circ_buf_get() - get data from circular buffer if data is available
-//    note: only one thread may call put and only one thread may call get
-static int16_t uni_remote_rcvr_circ_buf_get(char * p_msg_ptr, uint8_t * p_mac_addr_ptr, uint16_t * p_msg_len_ptr, uint32_t * p_msg_num_ptr, esp_err_t * p_msg_stat_ptr) {
-  int16_t status = ESP_OK;
-  uint16_t new_idx = uni_remote_rcvr_circ_buf_inc_idx(g_circ_buf.info.idx_out);
-  uni_remote_rcvr_circular_buffer_entry_t * out_entry_ptr = &g_circ_buf.entries[g_circ_buf.info.idx_out];
-
-  if (g_circ_buf.info.idx_in == g_circ_buf.info.idx_out) { // empty
-    status = UNI_REMOTE_RCVR_INFO_NO_MSG_2_GET; // INFO - no data to get 
-  } else { // get data from out_entry_ptr
-    status = ESP_OK;
-    *p_msg_stat_ptr = out_entry_ptr->msg_status;
-    *p_msg_num_ptr =  out_entry_ptr->msg_num;
-    *p_msg_len_ptr =  out_entry_ptr->msg_len;
-    memset(p_msg_ptr, '\0', *p_msg_len_ptr);
-    strncpy(p_msg_ptr, &out_entry_ptr->msg[0], *p_msg_len_ptr);
-    memcpy(p_mac_addr_ptr, &out_entry_ptr->mac_addr[0], ESP_NOW_ETH_ALEN);
-    g_circ_buf.info.idx_out = new_idx;  // MUST be last manipulation of circular buffer
-  } // end if data to transfer
-  return(status);
-} // end uni_remote_rcvr_circ_buf_get()
+  clock_ptr->usec_sample[clock_ptr->idx_next] = p_usec_sample;
+  clock_ptr->idx_next = (clock_ptr->idx_next + 1) % UNI_REMOTE_RCVR_CLOCK_WINDOW;
+  if (clock_ptr->num < UNI_REMOTE_RCVR_CLOCK_WINDOW) clock_ptr->num += 1;
+
+  int64_t usec_min = clock_ptr->usec_sample[0];
+  for (i = 1; i < clock_ptr->num; i++) {
+    if (clock_ptr->usec_sample[i] < usec_min) usec_min = clock_ptr->usec_sample[i];
+  }
+  return(usec_min);
+} // end uni_remote_rcvr_clock_min()
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
-// uni_remote_rcvr_circ_buf_put() - put data into circular buffer if room is available
-//    note: only one thread may call put and only one thread may call get
-static int16_t uni_remote_rcvr_circ_buf_put(const char * p_msg_ptr, const uint8_t * p_mac_addr_ptr, int p_msg_len) {
-  int16_t status = ESP_OK;
-  uint16_t new_idx = uni_remote_rcvr_circ_buf_inc_idx(g_circ_buf.info.idx_in);
-  uni_remote_rcvr_circular_buffer_entry_t * in_entry_ptr = &g_circ_buf.entries[g_circ_buf.info.idx_in];
-
-  if (new_idx == g_circ_buf.info.idx_out) { // no room
-    status = ESP_ERR_ESPNOW_FULL;
-    g_circ_buf.info.flag_circ_buf_full = 1;
+// uni_remote_rcvr_beacon_sample() - use one time beacon to update g_beacon_clock
+//
+// Like uni_remote_rcvr_clock_min(), the smallest (receive time - send time) is the best offset estimate.
+//    The crystals drift apart (typically a few to tens of usec per second) so each sample is first
+//    projected forward to now using the drift, then the smallest is taken. Every
+//    UNI_REMOTE_RCVR_BEACON_WINDOW beacons the new offset is compared with the one from the previous
+//    block to measure the drift; that is smoothed so one odd block does not throw it off.
+static void uni_remote_rcvr_beacon_sample(const uint8_t * p_mac_addr_ptr, const uni_frame_beacon_t * p_beacon_ptr, int64_t p_usec_rcvd) {
+  uni_remote_rcvr_beacon_clock_t * clk = &g_beacon_clock;
+  uint16_t i;
+
+  if ((0 != clk->in_use) && (0 != memcmp(clk->mac_addr, p_mac_addr_ptr, ESP_NOW_ETH_ALEN))) {
+    if ((p_usec_rcvd - clk->usec_rcvd_last) < (int64_t) UNI_REMOTE_RCVR_BEACON_TIMEOUT_MSEC * 1000) return; // follow one sender at a time
+    clk->in_use = 0; // current sender went quiet; follow this one
+  }
+  if ((0 != clk->in_use) && (p_beacon_ptr->seq <= clk->seq_last)) {
+    clk->in_use = 0; // sender restarted; its clock did too
+  }
+  if (0 == clk->in_use) {
+    memset(clk, 0, sizeof(*clk));
+    memcpy(clk->mac_addr, p_mac_addr_ptr, ESP_NOW_ETH_ALEN);
+    clk->in_use = 1;
   } else {
-    status = ESP_OK;
-    in_entry_ptr->msg_status = ESP_OK;
-    in_entry_ptr->msg_num = g_circ_buf.info.msg_callback_num;
-    in_entry_ptr->msg_len = (uint16_t) p_msg_len;
-    memset(&in_entry_ptr->msg[0], '\0', p_msg_len);
-    strncpy(&in_entry_ptr->msg[0], (char *)p_msg_ptr, p_msg_len);
-    memcpy(&in_entry_ptr->mac_addr[0], &p_mac_addr_ptr[0], ESP_NOW_ETH_ALEN);
-    g_circ_buf.info.idx_in = new_idx; // MUST be last manipulation of circular buffer
-  } // end if room available
-  return(status);
-} // end uni_remote_rcvr_circ_buf_put()
+    clk->beacon_missed_num += p_beacon_ptr->seq - clk->seq_last - 1;
+  }
+  clk->beacon_num += 1;
+  clk->seq_last = p_beacon_ptr->seq;
+  clk->usec_air_min = p_beacon_ptr->usec_air_min;
+  clk->msec_period = p_beacon_ptr->msec_period;
+  clk->usec_rcvd_last = p_usec_rcvd;
+
+  clk->usec_rcvd[clk->idx_next] = p_usec_rcvd;
+  clk->usec_sample[clk->idx_next] = p_usec_rcvd - p_beacon_ptr->usec_sent;
+  clk->idx_next = (clk->idx_next + 1) % UNI_REMOTE_RCVR_BEACON_WINDOW;
+  if (clk->num < UNI_REMOTE_RCVR_BEACON_WINDOW) clk->num += 1;
+
+  // project the window samples to now; smallest is the offset, spread is the jitter
+  int64_t usec_lo = 0, usec_hi = 0;
+  for (i = 0; i < clk->num; i++) {
+    int64_t usec_proj = clk->usec_sample[i] + ((int64_t) clk->drift_ppb * (p_usec_rcvd - clk->usec_rcvd[i])) / 1000000000LL;
+    if ((0 == i) || (usec_proj < usec_lo)) usec_lo = usec_proj;
+    if ((0 == i) || (usec_proj > usec_hi)) usec_hi = usec_proj;
+  }
+  clk->usec_ref = p_usec_rcvd;
+  clk->usec_offset_ref = usec_lo;
+  clk->usec_jitter = (uint32_t) (usec_hi - usec_lo);
+
+  // once per window, measure the drift from the previous window
+  clk->block_num += 1;
+  if (clk->block_num >= UNI_REMOTE_RCVR_BEACON_WINDOW) {
+    clk->block_num = 0;
+    if ((0 != clk->have_block) && (p_usec_rcvd > clk->usec_block_ref)) {
+      int64_t drift_ppb = ((usec_lo - clk->usec_block_offset) * 1000000000LL) / (p_usec_rcvd - clk->usec_block_ref);
+      if ((drift_ppb < UNI_REMOTE_RCVR_DRIFT_MAX_PPB) && (drift_ppb > -UNI_REMOTE_RCVR_DRIFT_MAX_PPB)) {
+        if (0 == clk->have_drift) clk->drift_ppb = (int32_t) drift_ppb;
+        else                      clk->drift_ppb += (int32_t) ((drift_ppb - clk->drift_ppb) / 4);
+        clk->have_drift = 1;
+      }
+    }
+    clk->have_block = 1;
+    clk->usec_block_ref = p_usec_rcvd;
+    clk->usec_block_offset = usec_lo;
+  }
+} // end uni_remote_rcvr_beacon_sample()
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
-// uni_remote_rcvr_callback() - callback function that will be executed when data is received
-static void uni_remote_rcvr_callback(const uint8_t * p_mac_addr, const uint8_t *p_recv_data, int p_recv_len) {
-  g_circ_buf.info.msg_callback_num += 1;
-  if (p_recv_len >= ESP_NOW_MAX_DATA_LEN) { // cannot happen - data too big
-    g_circ_buf.info.flag_data_too_big = 1;
-  } else { // put data into buffer; buf_put() reports if it cannot do it
-    uni_remote_rcvr_circ_buf_put((char *)p_recv_data, &p_mac_addr[UNI_ESP_NOW_HDR_MAC_OFFSET], p_recv_len);
+// uni_remote_rcvr_beacon_update() - use the time beacons the callback saved for us
+static void uni_remote_rcvr_beacon_update() {
+  uint8_t entry[UNI_REMOTE_RCVR_BEACON_ENTRY_LEN];
+  uni_frame_beacon_t beacon;
+  uint16_t entry_len;
+  uint32_t entry_num;
+  esp_err_t entry_status;
+  int64_t usec_rcvd;
+
+  while (g_beacon_buf.get((char *) entry, &entry_len, &entry_num, &entry_status, &usec_rcvd)) {
+    memcpy(&beacon, &entry[1+ESP_NOW_ETH_ALEN], sizeof(beacon));
+    uni_remote_rcvr_beacon_sample(&entry[1], &beacon, usec_rcvd);
   }
-  return;
-} // end uni_remote_rcvr_callback()
+} // end uni_remote_rcvr_beacon_update()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_remote_rcvr_announce_send() - broadcast our announcement
+static esp_err_t uni_remote_rcvr_announce_send() {
+  uint8_t frame[1 + sizeof(uni_frame_announce_t)];
+  uint16_t frame_len = uni_frame_make_announce(frame, sizeof(frame), &g_announce);
+  return(esp_now_send(g_announce_broadcast_mac_addr, frame, frame_len));
+} // end uni_remote_rcvr_announce_send()
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_remote_rcvr_announce_update() - answer requests to announce the callback saw
+static void uni_remote_rcvr_announce_update() {
+  if (0 == g_announce_ready) return;
+
+  // any number of requests since we last looked get one answer
+  uint32_t req_num = g_announce_req_num;
+  if (req_num != g_announce_req_seen) {
+    g_announce_req_seen = req_num;
+    if (0 == g_announce_pending) {
+      g_announce_pending = 1;
+      g_announce_msec_due = millis() + g_announce_jitter_msec;
+    }
+  }
+  if ((0 != g_announce_pending) && ((int32_t) (millis() - g_announce_msec_due) >= 0)) {
+    g_announce_pending = 0;
+    uni_remote_rcvr_announce_send();
+  }
+} // end uni_remote_rcvr_announce_update()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_remote_rcvr_beacon_has_sync() - non-zero if g_beacon_clock can be used
+static int16_t uni_remote_rcvr_beacon_has_sync() {
+  return((0 != g_beacon_clock.in_use) && (g_beacon_clock.num >= 2));
+} // end uni_remote_rcvr_beacon_has_sync()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_remote_rcvr_beacon_offset() - our clock minus beacon sender clock at our time p_usec_when
+static int64_t uni_remote_rcvr_beacon_offset(int64_t p_usec_when) {
+  return(g_beacon_clock.usec_offset_ref +
+         ((int64_t) g_beacon_clock.drift_ppb * (p_usec_when - g_beacon_clock.usec_ref)) / 1000000000LL -
+         (g_beacon_clock.usec_air_min / 2));
+} // end uni_remote_rcvr_beacon_offset()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_remote_rcvr_note_timing() - fill in g_msg_timing and "execute at" for the message just returned
+//    if there are trailers, *p_rcvd_len_ptr is changed to cover only the command
+static void uni_remote_rcvr_note_timing(uint16_t * p_rcvd_len_ptr, const char * p_rcvd_msg_ptr, const uint8_t * p_mac_addr_ptr, int64_t p_usec_rcvd) {
+  uni_frame_timing_t trailer;
+  uni_frame_exec_at_t exec_at;
+  uint16_t has_exec_at = uni_frame_find_exec_at((const uint8_t *) p_rcvd_msg_ptr, *p_rcvd_len_ptr, &exec_at);
+
+  g_msg_usec_got = esp_timer_get_time();
+  memset(&g_msg_timing, 0, sizeof(g_msg_timing));
+  g_msg_has_exec_at = 0;
+  g_msg_timing.usec_rcvr_queue = (uint32_t) (g_msg_usec_got - p_usec_rcvd);
+  if (0 != uni_frame_find_timing((const uint8_t *) p_rcvd_msg_ptr, *p_rcvd_len_ptr, &trailer)) {
+    g_msg_timing.has_timing = 1;
+    g_msg_timing.seq = trailer.seq;
+    g_msg_timing.usec_scan = trailer.usec_scan;
+    g_msg_timing.usec_parse = trailer.usec_parse;
+    g_msg_timing.usec_queue = trailer.usec_queue;
+    g_msg_timing.usec_clock_offset = uni_remote_rcvr_clock_min(p_mac_addr_ptr, p_usec_rcvd - trailer.usec_sent) - (trailer.usec_air_min / 2);
+    g_msg_timing.usec_air = (int32_t) (p_usec_rcvd - trailer.usec_sent - g_msg_timing.usec_clock_offset);
+    *p_rcvd_len_ptr = strlen(p_rcvd_msg_ptr) + 1; // the trailer is not part of the command
+  }
+
+  if (0 != has_exec_at) {
+    *p_rcvd_len_ptr = strlen(p_rcvd_msg_ptr) + 1; // the trailer is not part of the command
+    if (uni_remote_rcvr_beacon_has_sync() && (0 == memcmp(g_beacon_clock.mac_addr, p_mac_addr_ptr, ESP_NOW_ETH_ALEN))) {
+      // offset at about the execute time, so drift until then is included
+      int64_t usec_exec_at = exec_at.usec_exec_at + uni_remote_rcvr_beacon_offset(g_msg_usec_got);
+      g_msg_usec_exec_at = exec_at.usec_exec_at + uni_remote_rcvr_beacon_offset(usec_exec_at);
+      g_msg_has_exec_at = 1;
+    } else if (0 != g_msg_timing.has_timing) {
+      g_msg_usec_exec_at = exec_at.usec_exec_at + g_msg_timing.usec_clock_offset;
+      g_msg_has_exec_at = 1;
+    }
+  }
+} // end uni_remote_rcvr_note_timing()
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 // uni_remote_rcvr_get_extended_status()
 //       returns: nothing for status
 //
 // uni_remote_rcvr_cbuf_extended_status_t - returned by uni_remote_rcvr_get_extended_status()
-// The idx_* items are for internal usage by UniRemoteRcvr.
+// The idx_num is the number of entries in the circular buffer for each sender.
+//    Each sender can have at most (idx_num-1) messages waiting.
+//    If UNI_REMOTE_RCVR_STORAGE is UniRemoteRcvrByteRingStorage, idx_num is instead the
+//    number of bytes in the byte ring for each sender; each message takes its length plus 16 bytes.
+// The num_senders is how many of the UNI_REMOTE_RCVR_MAX_SENDERS sender slots are tracking a sender.
+// The last_dropped_mac_addr is the sender MAC address of the most recent dropped message.
+//    See uni_remote_rcvr_get_sender_stats() for counts of received and dropped messages per sender.
+// The msg_dropped_num and msg_too_big_num count every message lost since uni_remote_rcvr_init();
+//    unlike the flags they are never cleared, so you can tell how many were lost, not just that some were.
+// The queue_high_water_num is the most messages ever waiting at once in any one sender circ_buf.
+//    If it reaches the most the circ_buf can hold, you are close to dropping messages.
 // The msg_callback_num is the number of times that the ESP-NOW rcvr callback routine was called.
 //    It gets stored into the circular buffer each time a message is stored, and returned via p_msg_num_ptr.
 //    The *p_msg_num_ptr returned by uni_remote_rcvr_get_msg() will normally increment by one
-//    each time a message is returned.
+//    each time a message is returned (with more than one sender, it can be out of order between senders).
 //      If it skips a number, that means there was no room in the circular buffer to store it.
 //      See the description about flag_circ_buf_full, UNI_REMOTE_RCVR_ERR_CBUF_MSG_DROPPED,
 //      and uni_remote_rcvr_clear_extended_status_flags() 
@@ -162,13 +398,15 @@ static void uni_remote_rcvr_callback(const uint8_t * p_mac_addr, const uint8_t *
 //    flag_circ_buf_full (UNI_REMOTE_RCVR_ERR_CBUF_MSG_DROPPED) - circular buffer got full and message lost
 //         This means that you should either
 //            call uni_remote_rcvr_get_msg() more frequently
-//            increase UNI_REMOTE_RCVR_NUM_BUFR to allow more buffering
-//    flag_data_too_big  (UNI_REMOTE_RCVR_ERR_MSG_TOO_BIG) - some bug in ESP-NOW or a bad actor generated
-//         condition that didn't cause a buffer overflow because we checked.
-//         Honestly I don't expect to ever see this one.
+//            increase UNI_REMOTE_RCVR_NUM_BUFR to allow more buffering per sender
+//            increase UNI_REMOTE_RCVR_MAX_SENDERS to track more senders
+//    flag_data_too_big  (UNI_REMOTE_RCVR_ERR_MSG_TOO_BIG) - message longer than UNI_REMOTE_RCVR_MAX_MSG_LEN
+//         was not stored. With the default UNI_REMOTE_RCVR_MAX_MSG_LEN this would take some bug in
+//         ESP-NOW or a bad actor; it didn't cause a buffer overflow because we checked.
+//         If you made UNI_REMOTE_RCVR_MAX_MSG_LEN smaller, either increase it or send shorter messages.
 //
 void uni_remote_rcvr_get_extended_status(uni_remote_rcvr_cbuf_extended_status_t * extended_status_ptr) {
-  memcpy(extended_status_ptr, &g_circ_buf.info, sizeof(uni_remote_rcvr_cbuf_extended_status_t));
+  g_circ_buf.get_extended_status(extended_status_ptr);
 } // end uni_remote_rcvr_get_extended_status()
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -185,14 +423,15 @@ void uni_remote_rcvr_get_extended_status(uni_remote_rcvr_cbuf_extended_status_t
 //    flag_circ_buf_full (UNI_REMOTE_RCVR_ERR_CBUF_MSG_DROPPED) - circular buffer got full and message lost
 //         This means that you should either
 //            call uni_remote_rcvr_get_msg() more frequently
-//            increase UNI_REMOTE_RCVR_NUM_BUFR to allow more buffering
-//    flag_data_too_big  (UNI_REMOTE_RCVR_ERR_MSG_TOO_BIG) - some bug in ESP-NOW or a bad actor generated
-//         condition that didn't cause a buffer overflow because we checked.
-//         Honestly I don't expect to ever see this one.
+//            increase UNI_REMOTE_RCVR_NUM_BUFR to allow more buffering per sender
+//            increase UNI_REMOTE_RCVR_MAX_SENDERS to track more senders
+//    flag_data_too_big  (UNI_REMOTE_RCVR_ERR_MSG_TOO_BIG) - message longer than UNI_REMOTE_RCVR_MAX_MSG_LEN
+//         was not stored. With the default UNI_REMOTE_RCVR_MAX_MSG_LEN this would take some bug in
+//         ESP-NOW or a bad actor; it didn't cause a buffer overflow because we checked.
+//         If you made UNI_REMOTE_RCVR_MAX_MSG_LEN smaller, either increase it or send shorter messages.
 //
 void uni_remote_rcvr_clear_extended_status_flags() {
-  g_circ_buf.info.flag_circ_buf_full = 0;
-  g_circ_buf.info.flag_data_too_big  = 0;
+  g_circ_buf.clear_extended_status_flags();
 } // end uni_remote_rcvr_clear_extended_status_flags()
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -207,11 +446,11 @@ void uni_remote_rcvr_clear_extended_status_flags() {
 esp_err_t uni_remote_rcvr_init() {
 
   // initialize our circular buffer data struct
-  g_circ_buf.info.idx_num = UNI_REMOTE_RCVR_NUM_BUFR;
-  g_circ_buf.info.idx_in = g_circ_buf.info.idx_out = 0; // when in == out, circ_buf is empty
-  g_circ_buf.info.msg_callback_num = 0;   // number of times ESP-NOW rcvr callback is called
-  g_circ_buf.info.flag_circ_buf_full = 0; // non-zero == flag that circular buffer was full in ESP-NOW rcvr callback
-  g_circ_buf.info.flag_data_too_big = 0;  // non-zero == flag that ESP-NOW rcvr callback with too much data for ESP-NOW
+  g_circ_buf.init(); // all sender slots free, all queues empty, all counts and flags zero
+  g_beacon_buf.reset();
+  memset(&g_beacon_clock, 0, sizeof(g_beacon_clock)); // no beacons heard yet
+  g_announce_ready = g_announce_pending = 0; // nothing to announce until uni_remote_rcvr_announce()
+  g_announce_req_seen = g_announce_req_num;
 
   // Set device as a Wi-Fi Station
   WiFi.mode(WIFI_STA);
@@ -223,7 +462,7 @@ esp_err_t uni_remote_rcvr_init() {
   }
 
   // register ESP-NOW receiver callback
-  return(esp_now_register_recv_cb(esp_now_recv_cb_t(uni_remote_rcvr_callback)));
+  return(esp_now_register_recv_cb(uni_remote_rcvr_callback));
 } // end uni_remote_rcvr_init()
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -247,25 +486,220 @@ esp_err_t uni_remote_rcvr_init() {
 // p_rcvd_msg will have the zero-terminated message
 // p_mac_addr will have the array of bytes (uint8_t mac_addr[6] or [ESP_NOW_ETH_ALEN]) filled with the MAC address of the sending node
 // p_msg_num  will have the number of callbacks associated with this message
+// Messages are returned round-robin between senders: one message from each sender that has
+//    messages waiting before a second message from any of them. Messages from any one sender
+//    are returned in the order they were received.
 //    The *p_msg_num_ptr returned by uni_remote_rcvr_get_msg() will normally increment by one
-//    each time a message is returned.
+//    each time a message is returned (with more than one sender, it can be out of order between senders).
 //      If it skips a number, that means there was no room in the circular buffer to store it.
 //      See the description about flag_circ_buf_full, UNI_REMOTE_RCVR_ERR_CBUF_MSG_DROPPED,
 //      and uni_remote_rcvr_clear_extended_status_flags() 
 //
 esp_err_t uni_remote_rcvr_get_msg(uint16_t * p_rcvd_len_ptr, char * p_rcvd_msg_ptr, uint8_t * p_mac_addr_ptr, uint32_t * p_msg_num_ptr) {
-  static esp_err_t msg_status;
-  static esp_err_t circ_buf_status;
-  static esp_err_t my_status;
+  int64_t usec_rcvd; // caller did not ask for it
+
+  return(uni_remote_rcvr_get_msg_timed(p_rcvd_len_ptr, p_rcvd_msg_ptr, p_mac_addr_ptr, p_msg_num_ptr, &usec_rcvd));
+} // end uni_remote_rcvr_get_msg()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_remote_rcvr_get_msg_timed()
+//       returns: esp_err_t status
+//          same as uni_remote_rcvr_get_msg()
+//
+//    Parameters: same as uni_remote_rcvr_get_msg() plus
+//      p_usec_rcvd_ptr - output - pointer to esp_timer_get_time() when the ESP-NOW rcvr callback received the message
+//
+// esp_timer_get_time() - *p_usec_rcvd_ptr is how long the message waited before you got it.
+//    *p_usec_rcvd_ptr is only changed if p_rcvd_len is > 0
+//
+// If UniRemoteCYD sent a timing trailer after the command, *p_rcvd_len_ptr covers only the command
+//    (and its zero termination). Use uni_remote_rcvr_get_msg_timing() to see the timing.
+//
+esp_err_t uni_remote_rcvr_get_msg_timed(uint16_t * p_rcvd_len_ptr, char * p_rcvd_msg_ptr, uint8_t * p_mac_addr_ptr, uint32_t * p_msg_num_ptr, int64_t * p_usec_rcvd_ptr) {
+  // keep our idea of the beacon sender clock up to date
+  uni_remote_rcvr_beacon_update();
+
+  // answer any request to announce
+  uni_remote_rcvr_announce_update();
 
   // get the next message if there is one
-  circ_buf_status = uni_remote_rcvr_circ_buf_get(p_rcvd_msg_ptr, p_mac_addr_ptr, p_rcvd_len_ptr, p_msg_num_ptr, &msg_status);
-  if (UNI_REMOTE_RCVR_INFO_NO_MSG_2_GET == circ_buf_status) {
-    // there is no data to return
-    *p_rcvd_len_ptr = 0;
+  esp_err_t status = g_circ_buf.get(p_rcvd_len_ptr, p_rcvd_msg_ptr, p_mac_addr_ptr, p_msg_num_ptr, p_usec_rcvd_ptr);
+  if (*p_rcvd_len_ptr > 0) {
+    uni_remote_rcvr_note_timing(p_rcvd_len_ptr, p_rcvd_msg_ptr, p_mac_addr_ptr, *p_usec_rcvd_ptr);
   }
-  if (0 != g_circ_buf.info.flag_circ_buf_full)     my_status = UNI_REMOTE_RCVR_ERR_CBUF_MSG_DROPPED;
-  else if (0 != g_circ_buf.info.flag_data_too_big) my_status = UNI_REMOTE_RCVR_ERR_MSG_TOO_BIG;
-  else                                             my_status = ESP_OK;
-  return(my_status);
-} // end uni_remote_rcvr_get_msg()
+  return(status);
+} // end uni_remote_rcvr_get_msg_timed()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_remote_rcvr_get_sender_stats()
+//       returns: nothing for status
+//
+// uni_remote_rcvr_all_sender_stats_t - returned by uni_remote_rcvr_get_sender_stats()
+//    One entry per sender slot; entries with in_use == 0 are not tracking a sender.
+//    msg_rcvd_num and msg_dropped_num tell you whose messages were received and whose were lost.
+//    These counts are never cleared by uni_remote_rcvr_clear_extended_status_flags().
+//
+void uni_remote_rcvr_get_sender_stats(uni_remote_rcvr_all_sender_stats_t * p_stats_ptr) {
+  g_circ_buf.get_sender_stats(&p_stats_ptr->senders[0], UNI_REMOTE_RCVR_MAX_SENDERS,
+                              &p_stats_ptr->msg_dropped_no_slot_num, &p_stats_ptr->sender_evicted_num);
+} // end uni_remote_rcvr_get_sender_stats()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_remote_rcvr_get_residency()
+//       returns: nothing for status
+//
+// uni_remote_rcvr_residency_t - returned by uni_remote_rcvr_get_residency()
+//    Histogram of how long messages waited between the ESP-NOW rcvr callback and uni_remote_rcvr_get_msg().
+//    Use it with queue_high_water_num from uni_remote_rcvr_get_extended_status() to choose
+//    UNI_REMOTE_RCVR_NUM_BUFR and how often loop() calls uni_remote_rcvr_get_msg().
+//    These counts are never cleared by uni_remote_rcvr_clear_extended_status_flags().
+//
+void uni_remote_rcvr_get_residency(uni_remote_rcvr_residency_t * p_residency_ptr) {
+  g_circ_buf.get_residency(p_residency_ptr);
+} // end uni_remote_rcvr_get_residency()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_remote_rcvr_get_msg_timing()
+//       returns: nothing for status
+//
+// uni_remote_rcvr_msg_timing_t - returned by uni_remote_rcvr_get_msg_timing()
+//    Timing for the last message returned by uni_remote_rcvr_get_msg() or uni_remote_rcvr_get_msg_timed().
+//    Call it when your code is done with the message; the time since the message was returned
+//    is reported as usec_handler.
+//
+void uni_remote_rcvr_get_msg_timing(uni_remote_rcvr_msg_timing_t * p_timing_ptr) {
+  g_msg_timing.usec_handler = (uint32_t) (esp_timer_get_time() - g_msg_usec_got);
+  g_msg_timing.usec_total = g_msg_timing.usec_scan + g_msg_timing.usec_parse + g_msg_timing.usec_queue +
+                            g_msg_timing.usec_air + g_msg_timing.usec_rcvr_queue + g_msg_timing.usec_handler;
+  memcpy(p_timing_ptr, &g_msg_timing, sizeof(uni_remote_rcvr_msg_timing_t));
+} // end uni_remote_rcvr_get_msg_timing()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_remote_rcvr_get_msg_exec_at()
+//       returns: non-zero if the last message returned has an "execute at" time we can use
+//
+//    Parameters:
+//      p_usec_exec_at_ptr - output - esp_timer_get_time() on this receiver when the message should be executed
+//
+// UniRemoteCYD adds an "execute at" time to a command when asked (see UniRemoteFrames.h).
+//    The time is converted to this receiver's clock with the beacon clock offset if the command
+//    came from the beacon sender, otherwise with the offset from the timing trailer.
+//    If neither is available it returns zero; execute the command right away.
+//
+int16_t uni_remote_rcvr_get_msg_exec_at(int64_t * p_usec_exec_at_ptr) {
+  if (0 != g_msg_has_exec_at) *p_usec_exec_at_ptr = g_msg_usec_exec_at;
+  return(g_msg_has_exec_at);
+} // end uni_remote_rcvr_get_msg_exec_at()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_remote_rcvr_wait_until()
+//       returns: actual esp_timer_get_time() when it returned minus p_usec_exec_at, in microseconds
+//
+//    Parameters:
+//      p_usec_exec_at - input - esp_timer_get_time() on this receiver to wait for
+//
+// Uses delay() until UNI_REMOTE_RCVR_EXEC_SPIN_USEC before the time, then busy-waits so that the
+//    receivers line up well under a millisecond. If already past the time it returns right away
+//    (and the result is how late it was). If the time is more than UNI_REMOTE_RCVR_EXEC_MAX_MSEC
+//    away it also returns right away (and the result is negative).
+//    The results are kept in uni_remote_rcvr_get_time_sync().
+//    While in delay() it feeds the task watchdog every UNI_REMOTE_RCVR_EXEC_FEED_MSEC, so a wait up to
+//    UNI_REMOTE_RCVR_EXEC_MAX_MSEC does not reset a receiver that uses UniRemoteStall.h.
+//
+int32_t uni_remote_rcvr_wait_until(int64_t p_usec_exec_at) {
+  int64_t usec_now = esp_timer_get_time();
+
+  g_exec_num += 1;
+  if (usec_now >= p_usec_exec_at) {
+    g_exec_late_num += 1; // loop() got to the message too late; nothing we can do now
+  } else if ((p_usec_exec_at - usec_now) > (int64_t) UNI_REMOTE_RCVR_EXEC_MAX_MSEC * 1000) {
+    ; // too far away to be believed (bad clock offset?); do not hang loop(), return early
+  } else {
+    int64_t usec_left = p_usec_exec_at - usec_now;
+    if (usec_left > UNI_REMOTE_RCVR_EXEC_SPIN_USEC) {
+      uint32_t msec_left = (uint32_t) ((usec_left - UNI_REMOTE_RCVR_EXEC_SPIN_USEC) / 1000);
+      while (msec_left > 0) { // let other tasks run
+        uint32_t msec_delay = (msec_left > UNI_REMOTE_RCVR_EXEC_FEED_MSEC) ? UNI_REMOTE_RCVR_EXEC_FEED_MSEC : msec_left;
+        delay(msec_delay);
+        esp_task_wdt_reset(); // harmless if this task is not on the watchdog
+        msec_left -= msec_delay;
+      }
+    }
+    while ((usec_now = esp_timer_get_time()) < p_usec_exec_at) {
+      ; // busy-wait the last bit; delay() is only good to a millisecond or so
+    }
+    uint32_t usec_err = (uint32_t) (usec_now - p_usec_exec_at);
+    if (usec_err > g_usec_exec_err_max) g_usec_exec_err_max = usec_err;
+  }
+  g_usec_exec_err_last = (int32_t) (usec_now - p_usec_exec_at);
+  return(g_usec_exec_err_last);
+} // end uni_remote_rcvr_wait_until()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_remote_rcvr_get_time_sync()
+//       returns: nothing for status
+//
+// uni_remote_rcvr_time_sync_t - returned by uni_remote_rcvr_get_time_sync()
+//    How well this receiver knows the UniRemoteCYD clock, and how closely "execute at" was honored.
+//
+void uni_remote_rcvr_get_time_sync(uni_remote_rcvr_time_sync_t * p_sync_ptr) {
+  int64_t usec_now;
+
+  uni_remote_rcvr_beacon_update();
+  usec_now = esp_timer_get_time();
+  memset(p_sync_ptr, 0, sizeof(*p_sync_ptr));
+  p_sync_ptr->has_sync = uni_remote_rcvr_beacon_has_sync();
+  memcpy(p_sync_ptr->beacon_mac_addr, g_beacon_clock.mac_addr, ESP_NOW_ETH_ALEN);
+  p_sync_ptr->beacon_num = g_beacon_clock.beacon_num;
+  p_sync_ptr->beacon_missed_num = g_beacon_clock.beacon_missed_num;
+  p_sync_ptr->beacon_dropped_num = g_beacon_dropped_num;
+  if (0 != g_beacon_clock.in_use) {
+    p_sync_ptr->msec_since_beacon = (uint32_t) ((usec_now - g_beacon_clock.usec_rcvd_last) / 1000);
+  }
+  p_sync_ptr->msec_period = g_beacon_clock.msec_period;
+  if (0 != p_sync_ptr->has_sync) {
+    p_sync_ptr->usec_clock_offset = uni_remote_rcvr_beacon_offset(usec_now);
+  }
+  p_sync_ptr->drift_ppb = g_beacon_clock.drift_ppb;
+  p_sync_ptr->usec_jitter = g_beacon_clock.usec_jitter;
+  p_sync_ptr->exec_num = g_exec_num;
+  p_sync_ptr->exec_late_num = g_exec_late_num;
+  p_sync_ptr->usec_exec_err_last = g_usec_exec_err_last;
+  p_sync_ptr->usec_exec_err_max = g_usec_exec_err_max;
+} // end uni_remote_rcvr_get_time_sync()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_remote_rcvr_announce()
+//       returns: esp_err_t status
+//
+//    Parameters: see UniRemoteRcvr.h
+//
+// The broadcast address is registered as an ESP-NOW peer if it is not already.
+//
+esp_err_t uni_remote_rcvr_announce(const char * p_name, const char * p_alias, uint8_t p_caps) {
+  uint8_t mac_addr[ESP_NOW_ETH_ALEN];
+  esp_now_peer_info_t peer_info;
+  esp_err_t status;
+
+  memset(&g_announce, 0, sizeof(g_announce));
+  strncpy(g_announce.alias, p_alias, UNI_FRAME_ANNOUNCE_ALIAS_LEN);
+  strncpy(g_announce.name, p_name, UNI_FRAME_ANNOUNCE_NAME_LEN);
+  g_announce.caps = p_caps | UNI_FRAME_CAP_TIMING | UNI_FRAME_CAP_EXEC_AT;
+
+  // spread the answers to a request to announce
+  memset(mac_addr, 0, sizeof(mac_addr));
+  esp_wifi_get_mac(WIFI_IF_STA, mac_addr);
+  g_announce_jitter_msec = (mac_addr[ESP_NOW_ETH_ALEN-1] % 16) * UNI_REMOTE_RCVR_ANNOUNCE_JITTER_MSEC;
+
+  if (!esp_now_is_peer_exist(g_announce_broadcast_mac_addr)) {
+    memset(&peer_info, 0, sizeof(peer_info));
+    memcpy(peer_info.peer_addr, g_announce_broadcast_mac_addr, ESP_NOW_ETH_ALEN);
+    peer_info.channel = 0; // whatever channel we are on
+    peer_info.encrypt = false;
+    status = esp_now_add_peer(&peer_info);
+    if (ESP_OK != status) return(status);
+  }
+
+  g_announce_ready = 1;
+  return(uni_remote_rcvr_announce_send());
+} // end uni_remote_rcvr_announce()
@@ -21,6 +21,8 @@
 /*
  * UniRemoteRcvr - Code for receiving commands from UniRemote
  *
+ * Needs ESP32 Arduino core 3.x: the ESP-NOW receive callback takes const esp_now_recv_info_t *
+ *
  * Status returns from these routines return an "expanded" esp_err_t code
  * It is also possible to receive an error code from Espressif ESP32 library files esp_err.h or esp_now.h
  * I tried to give my codes different values than the ESP-NOW codes (except for ESP_OK)
@@ -28,7 +30,7 @@
  * Below is a list of the codes specific to UniRemoteRcvr
  * UNI_REMOTE_RCVR_OK                   same as ESP_OK
  * UNI_REMOTE_RCVR_ERR_CBUF_MSG_DROPPED circular buffer _put() called but no room in circular buffer; message dropped
- * UNI_REMOTE_RCVR_ERR_MSG_TOO_BIG      ESP-NOW rcvr callback message bigger than ESP-NOW allows (cannot happen)
+ * UNI_REMOTE_RCVR_ERR_MSG_TOO_BIG      ESP-NOW rcvr callback message bigger than UNI_REMOTE_RCVR_MAX_MSG_LEN
  * UNI_REMOTE_RCVR_INFO_NO_MSG_2_GET    circular buffer _get() called but circular buffer is empty
  *                                      NOTE: this status only used internally, not returned to callers
  *
@@ -44,19 +46,59 @@
  */
 
 #ifndef UNI_REMOTE_RCVR_H
+#define UNI_REMOTE_RCVR_H 1
 
 // include Espressif ESP32 wifi and ESP-NOW 
 #include <esp_now.h>  // for ESP-NOW
 #include <WiFi.h>     // for ESP-NOW
+#include <esp_timer.h> // for esp_timer_get_time() receive timestamps
+#if defined(ESP_ARDUINO_VERSION_MAJOR) && (ESP_ARDUINO_VERSION_MAJOR < 3)
+#error "UniRemoteRcvr needs ESP32 Arduino core 3.x (esp_now_recv_info_t in the receive callback)"
+#endif
 
 // public definitions for circular buffer of ESP-NOW messages
+//   These sizes are checked at compile time (static_assert) in UniRemoteRcvrQueue.h
+//   UNI_REMOTE_RCVR_STORAGE is one of these
+//     UniRemoteRcvrSlotStorage     - UNI_REMOTE_RCVR_NUM_BUFR entries, each big enough for UNI_REMOTE_RCVR_MAX_MSG_LEN
+//     UniRemoteRcvrByteRingStorage - a ring of length-prefixed records with room for NUM_BUFR-1 of the largest messages
+//          A typical 10 to 30 byte command takes 26 to 46 bytes instead of a whole 266 byte entry, so
+//          many more short messages fit in the same RAM. A message is still dropped if it does not fit.
+//   The defaults use about 800 bytes for messages, what the single queue before per-sender queues used:
+//     3 senders, each with a 267 byte ring; one full-size message or about seven 20 byte commands each.
+//   Each sender slot costs (NUM_BUFR-1)*(MAX_MSG_LEN+16)+1 bytes with the byte ring.
+//     A receiver with many busy UniRemotes can raise UNI_REMOTE_RCVR_MAX_SENDERS and UNI_REMOTE_RCVR_NUM_BUFR;
+//     a receiver short on RAM whose commands are all short can lower UNI_REMOTE_RCVR_MAX_MSG_LEN.
+#define UNI_REMOTE_RCVR_MAX_SENDERS 3 // number of different sender MAC addresses with their own circular buffer
+#define UNI_REMOTE_RCVR_NUM_BUFR 2    // number of buffers for messages for each sender; holds NUM_BUFR-1 of the largest messages
+#define UNI_REMOTE_RCVR_MAX_MSG_LEN ESP_NOW_MAX_DATA_LEN       // largest message stored (including zero termination); max 250
+#define UNI_REMOTE_RCVR_STORAGE     UniRemoteRcvrByteRingStorage // how messages are stored for each sender
+#define UNI_REMOTE_RCVR_RESIDENCY_HIST_NUM 12 // residency histogram buckets: <1 msec, then doubling up to 1024 msec, then longer
+#define UNI_REMOTE_RCVR_CLOCK_WINDOW 8        // clock offset to each sender is the minimum over this many messages
+#define UNI_REMOTE_RCVR_BEACON_WINDOW 8       // clock offset from time beacons is the minimum over this many beacons
+#define UNI_REMOTE_RCVR_BEACON_QUEUE_NUM 4    // time beacons waiting for loop(); holds NUM-1
+#define UNI_REMOTE_RCVR_BEACON_TIMEOUT_MSEC 10000 // follow a different beacon sender if the current one is quiet this long
+#define UNI_REMOTE_RCVR_EXEC_SPIN_USEC 2000   // uni_remote_rcvr_wait_until() busy-waits for the last part instead of delay()
+#define UNI_REMOTE_RCVR_EXEC_MAX_MSEC 10000   // uni_remote_rcvr_wait_until() will not wait longer than this
+#define UNI_REMOTE_RCVR_EXEC_FEED_MSEC 1000   // uni_remote_rcvr_wait_until() feeds the task watchdog at least this often
+#define UNI_REMOTE_RCVR_TRACK_RSSI 1          // non-zero to keep the signal strength of each sender
+#define UNI_REMOTE_RCVR_ANNOUNCE_JITTER_MSEC 4 // answer a request to announce (last byte of our MAC % 16) times this late
 
 // uni_remote_rcvr_cbuf_extended_status_t - returned by uni_remote_rcvr_get_extended_status()
-// The idx_* items are for internal usage by UniRemoteRcvr.
+// The idx_num is the number of entries in the circular buffer for each sender.
+//    Each sender can have at most (idx_num-1) messages waiting.
+//    If UNI_REMOTE_RCVR_STORAGE is UniRemoteRcvrByteRingStorage, idx_num is instead the
+//    number of bytes in the byte ring for each sender; each message takes its length plus 16 bytes.
+// The num_senders is how many of the UNI_REMOTE_RCVR_MAX_SENDERS sender slots are tracking a sender.
+// The last_dropped_mac_addr is the sender MAC address of the most recent dropped message.
+//    See uni_remote_rcvr_get_sender_stats() for counts of received and dropped messages per sender.
+// The msg_dropped_num and msg_too_big_num count every message lost since uni_remote_rcvr_init();
+//    unlike the flags they are never cleared, so you can tell how many were lost, not just that some were.
+// The queue_high_water_num is the most messages ever waiting at once in any one sender circ_buf.
+//    If it reaches the most the circ_buf can hold, you are close to dropping messages.
 // The msg_callback_num is the number of times that the ESP-NOW rcvr callback routine was called.
 //    It gets stored into the circular buffer each time a message is stored, and returned via p_msg_num_ptr.
 //    The *p_msg_num_ptr returned by uni_remote_rcvr_get_msg() will normally increment by one
-//    each time a message is returned.
+//    each time a message is returned (with more than one sender, it can be out of order between senders).
 //      If it skips a number, that means there was no room in the circular buffer to store it.
 //      See the description about flag_circ_buf_full, UNI_REMOTE_RCVR_ERR_CBUF_MSG_DROPPED,
 //      and uni_remote_rcvr_clear_extended_status_flags() 
@@ -64,35 +106,140 @@
 //    flag_circ_buf_full (UNI_REMOTE_RCVR_ERR_CBUF_MSG_DROPPED) - circular buffer got full and message lost
 //         This means that you should either
 //            call uni_remote_rcvr_get_msg() more frequently
-//            increase UNI_REMOTE_RCVR_NUM_BUFR to allow more buffering
-//    flag_data_too_big  (UNI_REMOTE_RCVR_ERR_MSG_TOO_BIG) - some bug in ESP-NOW or a bad actor generated
-//         condition that didn't cause a buffer overflow because we checked.
-//         Honestly I don't expect to ever see this one.
+//            increase UNI_REMOTE_RCVR_NUM_BUFR to allow more buffering per sender
+//            increase UNI_REMOTE_RCVR_MAX_SENDERS to track more senders
+//    flag_data_too_big  (UNI_REMOTE_RCVR_ERR_MSG_TOO_BIG) - message longer than UNI_REMOTE_RCVR_MAX_MSG_LEN
+//         was not stored. With the default UNI_REMOTE_RCVR_MAX_MSG_LEN this would take some bug in
+//         ESP-NOW or a bad actor; it didn't cause a buffer overflow because we checked.
+//         If you made UNI_REMOTE_RCVR_MAX_MSG_LEN smaller, either increase it or send shorter messages.
 //
 typedef struct {
-  uint16_t idx_in;             // next entry index for circ_buf_put
-  uint16_t idx_out;            // next entry index for circ_buf_get
-  uint16_t idx_num;            // number of entries in circ_buf
+  uint16_t idx_num;            // number of entries (or bytes if byte ring) in each sender circ_buf
+  uint16_t num_senders;        // number of sender slots currently tracking a sender MAC address
   uint32_t msg_callback_num;   // number of times ESP-NOW rcvr callback is called
+  uint32_t msg_dropped_num;    // cumulative number of messages dropped because circ_buf was full or no sender slot
+  uint32_t msg_too_big_num;    // cumulative number of messages longer than UNI_REMOTE_RCVR_MAX_MSG_LEN
+  uint16_t queue_high_water_num; // most messages ever waiting in any one sender circ_buf
   uint16_t flag_circ_buf_full; // non-zero == flag that circular buffer was full in ESP-NOW rcvr callback
   uint16_t flag_data_too_big;  // non-zero == flag that ESP-NOW rcvr callback with too much data for ESP-NOW
+  uint8_t  last_dropped_mac_addr[ESP_NOW_ETH_ALEN]; // MAC address of sender of most recent dropped message
 } uni_remote_rcvr_cbuf_extended_status_t;
 
+// uni_remote_rcvr_sender_stats_t - one per tracked sender; part of uni_remote_rcvr_all_sender_stats_t
+//    Each sender MAC address gets its own small circular buffer so one busy UniRemote cannot
+//    fill the buffer and starve the others. uni_remote_rcvr_get_msg() takes messages
+//    round-robin from the senders that have messages waiting.
+//    If in_use is zero the rest of the entry is meaningless.
+typedef struct {
+  uint8_t  mac_addr[ESP_NOW_ETH_ALEN]; // MAC address of the sender
+  uint16_t in_use;                     // non-zero == this slot is tracking the sender in mac_addr
+  uint16_t msg_queued_num;             // number of messages from this sender waiting in its circ_buf
+  uint16_t msg_queued_high_water_num;  // most messages from this sender ever waiting in its circ_buf
+  uint32_t msg_rcvd_num;               // number of messages from this sender stored in its circ_buf
+  uint32_t msg_dropped_num;            // number of messages from this sender dropped because its circ_buf was full
+  uint32_t msec_last_rcvd;             // millis() at the most recent callback for this sender
+  int16_t  rssi_last;                  // signal strength of the most recent message in dBm; 0 if not known
+  int16_t  rssi_avg;                   // signal strength averaged over about the last 8 messages in dBm; 0 if not known
+} uni_remote_rcvr_sender_stats_t;
+
+// uni_remote_rcvr_all_sender_stats_t - returned by uni_remote_rcvr_get_sender_stats()
+//    If a message comes from a new sender and all UNI_REMOTE_RCVR_MAX_SENDERS slots are in use,
+//       the slot of the least-recently-heard sender with nothing queued is re-used (its counts start over).
+//       If every slot has messages queued, the message is dropped and counted in msg_dropped_no_slot_num.
+typedef struct {
+  uint32_t msg_dropped_no_slot_num;    // messages dropped because no sender slot was available
+  uint32_t sender_evicted_num;         // number of times a sender slot was re-used for a new sender
+  uni_remote_rcvr_sender_stats_t senders[UNI_REMOTE_RCVR_MAX_SENDERS];
+} uni_remote_rcvr_all_sender_stats_t;
+
+// uni_remote_rcvr_residency_t - returned by uni_remote_rcvr_get_residency()
+//    How long messages waited in the circ_buf between the ESP-NOW rcvr callback and uni_remote_rcvr_get_msg().
+//    If most messages are in the higher buckets, call uni_remote_rcvr_get_msg() more often.
+//    hist[0] counts waits less than 1 msec; hist[i] counts waits at least 2^(i-1) and less than 2^i msec
+//    hist[UNI_REMOTE_RCVR_RESIDENCY_HIST_NUM-1] counts everything longer than that
+typedef struct {
+  uint32_t msg_num;            // number of messages returned by uni_remote_rcvr_get_msg()
+  uint32_t usec_max;           // longest wait in microseconds
+  uint64_t usec_total;         // total of all waits in microseconds; usec_total/msg_num is the average
+  uint32_t hist[UNI_REMOTE_RCVR_RESIDENCY_HIST_NUM]; // number of messages in each wait-time bucket
+} uni_remote_rcvr_residency_t;
+
+// uni_remote_rcvr_msg_timing_t - returned by uni_remote_rcvr_get_msg_timing()
+//    Where the time went for the last message returned by uni_remote_rcvr_get_msg(), from the operator
+//    scanning the card to your code finishing with it. Each stage is in microseconds.
+//    If has_timing is zero the sender did not include a timing trailer (see UniRemoteFrames.h);
+//       then only usec_rcvr_queue and usec_handler are valid.
+//    The sender and receiver clocks are not the same. usec_clock_offset is estimated from the smallest
+//       (receive time - send time) over the last UNI_REMOTE_RCVR_CLOCK_WINDOW messages from this sender,
+//       less half the smallest air time the sender measured. usec_air depends on this estimate.
+typedef struct {
+  uint16_t has_timing;         // non-zero if the message had a timing trailer
+  uint32_t seq;                // sender command number
+  uint32_t usec_scan;          // sender: reading the RFID card or QR code
+  uint32_t usec_parse;         // sender: decoding the MAC address and registering the ESP-NOW peer
+  uint32_t usec_queue;         // sender: parse done until esp_now_send()
+  int32_t  usec_air;           // esp_now_send() on sender until ESP-NOW rcvr callback here (estimated)
+  uint32_t usec_rcvr_queue;    // ESP-NOW rcvr callback until uni_remote_rcvr_get_msg() returned it
+  uint32_t usec_handler;       // uni_remote_rcvr_get_msg() returned it until uni_remote_rcvr_get_msg_timing() called
+  uint32_t usec_total;         // sum of all the stages
+  int64_t  usec_clock_offset;  // estimated receiver esp_timer_get_time() minus sender esp_timer_get_time()
+} uni_remote_rcvr_msg_timing_t;
+
+// uni_remote_rcvr_time_sync_t - returned by uni_remote_rcvr_get_time_sync()
+//    UniRemoteCYD broadcasts a time beacon every so often (see UniRemoteFrames.h). The smallest
+//       (receive time - send time) over the last UNI_REMOTE_RCVR_BEACON_WINDOW beacons gives the clock offset;
+//       comparing the offset from one window to the next gives the drift between the two crystals.
+//    Every receiver hears the same broadcast, so their offsets all have the same air time error;
+//       they line up with each other on an "execute at" time even though none knows the air time exactly.
+//    If has_sync is zero no beacons have been heard (or only one) and the rest is meaningless.
+//    usec_jitter is the spread of the beacon samples after removing drift; receivers line up
+//       within about this much (plus how late loop() gets to the message; see usec_exec_err_max).
+typedef struct {
+  uint16_t has_sync;            // non-zero if clock offset and drift from beacons are valid
+  uint8_t  beacon_mac_addr[ESP_NOW_ETH_ALEN]; // MAC address of the beacon sender we follow
+  uint32_t beacon_num;          // beacons used from beacon_mac_addr
+  uint32_t beacon_missed_num;   // gaps in the beacon seq; lost over the air
+  uint32_t beacon_dropped_num;  // beacons lost because loop() did not call uni_remote_rcvr_get_msg() in time
+  uint32_t msec_since_beacon;   // millisec since the most recent beacon
+  uint32_t msec_period;         // how often the sender says it sends beacons
+  int64_t  usec_clock_offset;   // receiver esp_timer_get_time() minus sender esp_timer_get_time(), right now
+  int32_t  drift_ppb;           // how fast usec_clock_offset changes, in parts per billion (1000 == 1 usec per sec)
+  uint32_t usec_jitter;         // spread of beacon (receive - send) over the window after removing drift
+  uint32_t exec_num;            // number of uni_remote_rcvr_wait_until() calls
+  uint32_t exec_late_num;       // of those, how many were already past the time when called
+  int32_t  usec_exec_err_last;  // last uni_remote_rcvr_wait_until(): actual time minus wanted time
+  uint32_t usec_exec_err_max;   // largest error of those not already late when called
+} uni_remote_rcvr_time_sync_t;
+
 #define UNI_REMOTE_RCVR_OK                  ESP_OK // success
 #define UNI_REMOTE_RCVR_ERR_CBUF_MSG_DROPPED  -101 // circular buffer _put() called but no room in circular buffer; message dropped
-#define UNI_REMOTE_RCVR_ERR_MSG_TOO_BIG       -102 // ESP-NOW rcvr callback message bigger than ESP-NOW allows (cannot happen)
+#define UNI_REMOTE_RCVR_ERR_MSG_TOO_BIG       -102 // ESP-NOW rcvr callback message bigger than UNI_REMOTE_RCVR_MAX_MSG_LEN
 #define UNI_REMOTE_RCVR_INFO_NO_MSG_2_GET     -201 // circular buffer _get() called but circular buffer is empty
 
+// the circular buffer itself is a class template; UniRemoteRcvr.cpp has the one used by the routines below
+#include "UniRemoteRcvrQueue.h"
+typedef UniRemoteRcvrQueue<UNI_REMOTE_RCVR_MAX_SENDERS, UNI_REMOTE_RCVR_NUM_BUFR, UNI_REMOTE_RCVR_MAX_MSG_LEN, UNI_REMOTE_RCVR_STORAGE> uni_remote_rcvr_queue_t;
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 // uni_remote_rcvr_get_extended_status()
 //       returns: nothing for status
 //
 // uni_remote_rcvr_cbuf_extended_status_t - returned by uni_remote_rcvr_get_extended_status()
-// The idx_* items are for internal usage by UniRemoteRcvr.
+// The idx_num is the number of entries in the circular buffer for each sender.
+//    Each sender can have at most (idx_num-1) messages waiting.
+//    If UNI_REMOTE_RCVR_STORAGE is UniRemoteRcvrByteRingStorage, idx_num is instead the
+//    number of bytes in the byte ring for each sender; each message takes its length plus 16 bytes.
+// The num_senders is how many of the UNI_REMOTE_RCVR_MAX_SENDERS sender slots are tracking a sender.
+// The last_dropped_mac_addr is the sender MAC address of the most recent dropped message.
+//    See uni_remote_rcvr_get_sender_stats() for counts of received and dropped messages per sender.
+// The msg_dropped_num and msg_too_big_num count every message lost since uni_remote_rcvr_init();
+//    unlike the flags they are never cleared, so you can tell how many were lost, not just that some were.
+// The queue_high_water_num is the most messages ever waiting at once in any one sender circ_buf.
+//    If it reaches the most the circ_buf can hold, you are close to dropping messages.
 // The msg_callback_num is the number of times that the ESP-NOW rcvr callback routine was called.
 //    It gets stored into the circular buffer each time a message is stored, and returned via p_msg_num_ptr.
 //    The *p_msg_num_ptr returned by uni_remote_rcvr_get_msg() will normally increment by one
-//    each time a message is returned.
+//    each time a message is returned (with more than one sender, it can be out of order between senders).
 //      If it skips a number, that means there was no room in the circular buffer to store it.
 //      See the description about flag_circ_buf_full, UNI_REMOTE_RCVR_ERR_CBUF_MSG_DROPPED,
 //      and uni_remote_rcvr_clear_extended_status_flags() 
@@ -100,10 +247,12 @@ typedef struct {
 //    flag_circ_buf_full (UNI_REMOTE_RCVR_ERR_CBUF_MSG_DROPPED) - circular buffer got full and message lost
 //         This means that you should either
 //            call uni_remote_rcvr_get_msg() more frequently
-//            increase UNI_REMOTE_RCVR_NUM_BUFR to allow more buffering
-//    flag_data_too_big  (UNI_REMOTE_RCVR_ERR_MSG_TOO_BIG) - some bug in ESP-NOW or a bad actor generated
-//         condition that didn't cause a buffer overflow because we checked.
-//         Honestly I don't expect to ever see this one.
+//            increase UNI_REMOTE_RCVR_NUM_BUFR to allow more buffering per sender
+//            increase UNI_REMOTE_RCVR_MAX_SENDERS to track more senders
+//    flag_data_too_big  (UNI_REMOTE_RCVR_ERR_MSG_TOO_BIG) - message longer than UNI_REMOTE_RCVR_MAX_MSG_LEN
+//         was not stored. With the default UNI_REMOTE_RCVR_MAX_MSG_LEN this would take some bug in
+//         ESP-NOW or a bad actor; it didn't cause a buffer overflow because we checked.
+//         If you made UNI_REMOTE_RCVR_MAX_MSG_LEN smaller, either increase it or send shorter messages.
 //
 void uni_remote_rcvr_get_extended_status(uni_remote_rcvr_cbuf_extended_status_t * extended_status_ptr);
 
@@ -121,10 +270,12 @@ void uni_remote_rcvr_get_extended_status(uni_remote_rcvr_cbuf_extended_status_t
 //    flag_circ_buf_full (UNI_REMOTE_RCVR_ERR_CBUF_MSG_DROPPED) - circular buffer got full and message lost
 //         This means that you should either
 //            call uni_remote_rcvr_get_msg() more frequently
-//            increase UNI_REMOTE_RCVR_NUM_BUFR to allow more buffering
-//    flag_data_too_big  (UNI_REMOTE_RCVR_ERR_MSG_TOO_BIG) - some bug in ESP-NOW or a bad actor generated
-//         condition that didn't cause a buffer overflow because we checked.
-//         Honestly I don't expect to ever see this one.
+//            increase UNI_REMOTE_RCVR_NUM_BUFR to allow more buffering per sender
+//            increase UNI_REMOTE_RCVR_MAX_SENDERS to track more senders
+//    flag_data_too_big  (UNI_REMOTE_RCVR_ERR_MSG_TOO_BIG) - message longer than UNI_REMOTE_RCVR_MAX_MSG_LEN
+//         was not stored. With the default UNI_REMOTE_RCVR_MAX_MSG_LEN this would take some bug in
+//         ESP-NOW or a bad actor; it didn't cause a buffer overflow because we checked.
+//         If you made UNI_REMOTE_RCVR_MAX_MSG_LEN smaller, either increase it or send shorter messages.
 //
 void uni_remote_rcvr_clear_extended_status_flags();
 
@@ -160,12 +311,126 @@ esp_err_t uni_remote_rcvr_init();
 // p_rcvd_msg will have the zero-terminated message
 // p_mac_addr will have the array of bytes (uint8_t mac_addr[6] or [ESP_NOW_ETH_ALEN]) filled with the MAC address of the sending node
 // p_msg_num  will have the number of callbacks associated with this message
+// Messages are returned round-robin between senders: one message from each sender that has
+//    messages waiting before a second message from any of them. Messages from any one sender
+//    are returned in the order they were received.
 //    The *p_msg_num_ptr returned by uni_remote_rcvr_get_msg() will normally increment by one
-//    each time a message is returned.
+//    each time a message is returned (with more than one sender, it can be out of order between senders).
 //      If it skips a number, that means there was no room in the circular buffer to store it.
 //      See the description about flag_circ_buf_full, UNI_REMOTE_RCVR_ERR_CBUF_MSG_DROPPED,
 //      and uni_remote_rcvr_clear_extended_status_flags() 
 //
 esp_err_t uni_remote_rcvr_get_msg(uint16_t * rcvd_len_ptr, char * rcvd_msg_ptr, uint8_t * mac_addr_ptr, uint32_t * p_msg_num_ptr);
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_remote_rcvr_get_msg_timed()
+//       returns: esp_err_t status
+//          same as uni_remote_rcvr_get_msg()
+//
+//    Parameters: same as uni_remote_rcvr_get_msg() plus
+//      p_usec_rcvd_ptr - output - pointer to esp_timer_get_time() when the ESP-NOW rcvr callback received the message
+//
+// esp_timer_get_time() - *p_usec_rcvd_ptr is how long the message waited before you got it.
+//    *p_usec_rcvd_ptr is only changed if p_rcvd_len is > 0
+//
+// If UniRemoteCYD sent a timing trailer after the command, *p_rcvd_len_ptr covers only the command
+//    (and its zero termination). Use uni_remote_rcvr_get_msg_timing() to see the timing.
+//
+esp_err_t uni_remote_rcvr_get_msg_timed(uint16_t * p_rcvd_len_ptr, char * p_rcvd_msg_ptr, uint8_t * p_mac_addr_ptr, uint32_t * p_msg_num_ptr, int64_t * p_usec_rcvd_ptr);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_remote_rcvr_get_sender_stats()
+//       returns: nothing for status
+//
+// uni_remote_rcvr_all_sender_stats_t - returned by uni_remote_rcvr_get_sender_stats()
+//    One entry per sender slot; entries with in_use == 0 are not tracking a sender.
+//    msg_rcvd_num and msg_dropped_num tell you whose messages were received and whose were lost.
+//    rssi_last and rssi_avg tell you how strong each sender's signal is here (if UNI_REMOTE_RCVR_TRACK_RSSI).
+//       Above about -67 dBm is a good link; below about -80 dBm messages start to be lost.
+//    These counts are never cleared by uni_remote_rcvr_clear_extended_status_flags().
+//
+void uni_remote_rcvr_get_sender_stats(uni_remote_rcvr_all_sender_stats_t * p_stats_ptr);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_remote_rcvr_get_residency()
+//       returns: nothing for status
+//
+// uni_remote_rcvr_residency_t - returned by uni_remote_rcvr_get_residency()
+//    Histogram of how long messages waited between the ESP-NOW rcvr callback and uni_remote_rcvr_get_msg().
+//    Use it with queue_high_water_num from uni_remote_rcvr_get_extended_status() to choose
+//    UNI_REMOTE_RCVR_NUM_BUFR and how often loop() calls uni_remote_rcvr_get_msg().
+//    These counts are never cleared by uni_remote_rcvr_clear_extended_status_flags().
+//
+void uni_remote_rcvr_get_residency(uni_remote_rcvr_residency_t * p_residency_ptr);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_remote_rcvr_get_msg_timing()
+//       returns: nothing for status
+//
+// uni_remote_rcvr_msg_timing_t - returned by uni_remote_rcvr_get_msg_timing()
+//    Timing for the last message returned by uni_remote_rcvr_get_msg() or uni_remote_rcvr_get_msg_timed().
+//    Call it when your code is done with the message; the time since the message was returned
+//    is reported as usec_handler.
+//
+void uni_remote_rcvr_get_msg_timing(uni_remote_rcvr_msg_timing_t * p_timing_ptr);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_remote_rcvr_get_msg_exec_at()
+//       returns: non-zero if the last message returned has an "execute at" time we can use
+//
+//    Parameters:
+//      p_usec_exec_at_ptr - output - esp_timer_get_time() on this receiver when the message should be executed
+//
+// UniRemoteCYD adds an "execute at" time to a command when asked (see UniRemoteFrames.h).
+//    The time is converted to this receiver's clock with the beacon clock offset if the command
+//    came from the beacon sender, otherwise with the offset from the timing trailer.
+//    If neither is available it returns zero; execute the command right away.
+//
+int16_t uni_remote_rcvr_get_msg_exec_at(int64_t * p_usec_exec_at_ptr);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_remote_rcvr_wait_until()
+//       returns: actual esp_timer_get_time() when it returned minus p_usec_exec_at, in microseconds
+//
+//    Parameters:
+//      p_usec_exec_at - input - esp_timer_get_time() on this receiver to wait for
+//
+// Uses delay() until UNI_REMOTE_RCVR_EXEC_SPIN_USEC before the time, then busy-waits so that the
+//    receivers line up well under a millisecond. If already past the time it returns right away
+//    (and the result is how late it was). If the time is more than UNI_REMOTE_RCVR_EXEC_MAX_MSEC
+//    away it also returns right away (and the result is negative).
+//    The results are kept in uni_remote_rcvr_get_time_sync().
+//    While in delay() it feeds the task watchdog every UNI_REMOTE_RCVR_EXEC_FEED_MSEC, so a wait up to
+//    UNI_REMOTE_RCVR_EXEC_MAX_MSEC does not reset a receiver that uses UniRemoteStall.h.
+//
+int32_t uni_remote_rcvr_wait_until(int64_t p_usec_exec_at);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_remote_rcvr_get_time_sync()
+//       returns: nothing for status
+//
+// uni_remote_rcvr_time_sync_t - returned by uni_remote_rcvr_get_time_sync()
+//    How well this receiver knows the UniRemoteCYD clock, and how closely "execute at" was honored.
+//
+void uni_remote_rcvr_get_time_sync(uni_remote_rcvr_time_sync_t * p_sync_ptr);
+
+// capabilities for uni_remote_rcvr_announce(); same bits as UNI_FRAME_CAP_* in UniRemoteFrames.h
+#define UNI_REMOTE_RCVR_CAP_OTA 0x04 // this receiver does "OTA:WEB"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_remote_rcvr_announce()
+//       returns: esp_err_t status
+//
+//    Parameters:
+//      p_name  - input - name for people to read; up to 16 chars are sent
+//      p_alias - input - 1 or 2 letters or digits for command cards ("K2|LED:ON"); "" for none
+//      p_caps  - input - UNI_REMOTE_RCVR_CAP_* bits for what this receiver does beyond the basics
+//
+// Call after uni_remote_rcvr_init(). Broadcasts an announcement so UniRemoteCYD can put this
+//    receiver in its directory, then answers each request to announce from uni_remote_rcvr_get_msg_timed().
+//    Answers are delayed a few millisec depending on our MAC address so receivers do not all answer at once.
+//    Timing trailers and "execute at" are always announced.
+//
+esp_err_t uni_remote_rcvr_announce(const char * p_name, const char * p_alias, uint8_t p_caps);
+
 #endif // UNI_REMOTE_RCVR_H 
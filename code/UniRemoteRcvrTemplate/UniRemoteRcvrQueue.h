@@ -0,0 +1,442 @@
+/* Author: https://github.com/Mark-MDO47  Feb. 28, 2025
+ *  https://github.com/Mark-MDO47/UniRemote
+ */
+
+/*
+   Copyright 2025 Mark Olson
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * UniRemoteRcvrQueue - the per-sender message queues behind UniRemoteRcvr
+ *
+ * UniRemoteRcvrQueue<MAX_SENDERS, QUEUE_DEPTH, MAX_MSG_LEN, STORAGE> is a class template so the
+ *    sizes are chosen at compile time and checked with static_assert.
+ *    MAX_SENDERS - number of different sender MAC addresses with their own queue
+ *    QUEUE_DEPTH - number of entries in each sender queue; holds QUEUE_DEPTH-1 messages of MAX_MSG_LEN
+ *    MAX_MSG_LEN - largest message (including zero termination) that will be stored
+ *    STORAGE     - storage policy for each sender queue; one of these
+ *       UniRemoteRcvrSlotStorage     - QUEUE_DEPTH entries, each big enough for MAX_MSG_LEN
+ *       UniRemoteRcvrByteRingStorage - a ring of length-prefixed records just big enough for QUEUE_DEPTH-1
+ *                                      messages of MAX_MSG_LEN; many more short messages fit
+ *
+ * UniRemoteRcvr.cpp makes one of these using the sizes in UniRemoteRcvr.h and connects it to the
+ *    ESP-NOW rcvr callback; the uni_remote_rcvr_*() routines just call its methods.
+ *    You can make more of them (for instance a smaller one for a different purpose) and feed
+ *    them yourself with put().
+ *
+ * The methods use the same status codes as the uni_remote_rcvr_*() routines.
+ *    put() is called from one thread (the ESP-NOW rcvr callback) and get() from one other thread (loop()).
+ *    The put() side is the only writer of idx_in, the put count, the extended status and the sender stats;
+ *    the get() side is the only writer of idx_out, the get count and the residency histogram.
+ *    That way no locking is needed.
+ */
+
+#ifndef UNI_REMOTE_RCVR_QUEUE_H
+#define UNI_REMOTE_RCVR_QUEUE_H 1
+
+// UniRemoteRcvrQueue.h is included from UniRemoteRcvr.h after the public typedefs and status codes
+
+// uni_remote_rcvr_zero_terminate() - the message always is zero terminated
+//    anything after the first zero (for instance the UniRemoteFrames.h timing trailer) is left alone
+static inline void uni_remote_rcvr_zero_terminate(char * p_msg_ptr, uint16_t p_msg_len) {
+  if ((p_msg_len > 0) && ((void *) 0 == memchr(p_msg_ptr, '\0', p_msg_len))) p_msg_ptr[p_msg_len-1] = '\0';
+} // end uni_remote_rcvr_zero_terminate()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// UniRemoteRcvrSlotStorage - one sender queue; QUEUE_DEPTH entries each big enough for MAX_MSG_LEN
+//
+template <uint16_t QUEUE_DEPTH, uint16_t MAX_MSG_LEN>
+class UniRemoteRcvrSlotStorage {
+public:
+  static constexpr uint16_t CAPACITY = QUEUE_DEPTH; // reported as extended status idx_num
+
+  void reset() { m_idx_in = m_idx_out = 0; m_put_num = m_got_num = 0; } // when in == out, circ_buf is empty
+
+  bool is_empty() const { return(m_idx_in == m_idx_out); }
+
+  // num_queued() - each count has only one writer so this is safe from either side
+  uint16_t num_queued() const { return((uint16_t) (m_put_num - m_got_num)); }
+
+  // put() - returns false if no room
+  bool put(const uint8_t * p_msg_ptr, uint16_t p_msg_len, uint32_t p_msg_num, int64_t p_usec_rcvd) {
+    uint16_t new_idx = inc_idx(m_idx_in);
+    if (new_idx == m_idx_out) return(false); // no room
+    entry_t * in_entry_ptr = &m_entries[m_idx_in];
+    in_entry_ptr->usec_rcvd = p_usec_rcvd;
+    in_entry_ptr->msg_status = ESP_OK;
+    in_entry_ptr->msg_num = p_msg_num;
+    in_entry_ptr->msg_len = p_msg_len;
+    memcpy(&in_entry_ptr->msg[0], p_msg_ptr, p_msg_len);
+    m_put_num += 1;
+    m_idx_in = new_idx; // MUST be last manipulation of circular buffer
+    return(true);
+  } // end put()
+
+  // get() - returns false if empty
+  bool get(char * p_msg_ptr, uint16_t * p_msg_len_ptr, uint32_t * p_msg_num_ptr, esp_err_t * p_msg_stat_ptr, int64_t * p_usec_rcvd_ptr) {
+    if (is_empty()) return(false);
+    const entry_t * out_entry_ptr = &m_entries[m_idx_out];
+    *p_usec_rcvd_ptr = out_entry_ptr->usec_rcvd;
+    *p_msg_stat_ptr = out_entry_ptr->msg_status;
+    *p_msg_num_ptr =  out_entry_ptr->msg_num;
+    *p_msg_len_ptr =  out_entry_ptr->msg_len;
+    memcpy(p_msg_ptr, &out_entry_ptr->msg[0], out_entry_ptr->msg_len);
+    uni_remote_rcvr_zero_terminate(p_msg_ptr, out_entry_ptr->msg_len);
+    m_got_num += 1;
+    m_idx_out = inc_idx(m_idx_out);  // MUST be last manipulation of circular buffer
+    return(true);
+  } // end get()
+
+private:
+  typedef struct {
+    char msg[MAX_MSG_LEN];              // received message
+    int64_t usec_rcvd;                  // esp_timer_get_time() in the ESP-NOW rcvr callback
+    uint32_t msg_num;                   // msg num; may skip if messages discarded
+    uint16_t msg_len;                   // length including trailing zero byte
+    int16_t msg_status;                 // status for this individual message. Almost certainly ESP_OK
+  } entry_t;
+
+  static uint16_t inc_idx(uint16_t p_idx) { return((p_idx + 1 >= QUEUE_DEPTH) ? 0 : p_idx + 1); }
+
+  uint16_t m_idx_in;                    // next entry index for circ_buf_put
+  uint16_t m_idx_out;                   // next entry index for circ_buf_get
+  uint32_t m_put_num;                   // messages stored; only written by put()
+  uint32_t m_got_num;                   // messages returned; only written by get()
+  entry_t m_entries[QUEUE_DEPTH];
+}; // end class UniRemoteRcvrSlotStorage
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// UniRemoteRcvrByteRingStorage - one sender queue; a ring of length-prefixed records
+//    The ring is QUEUE_DEPTH-1 records of MAX_MSG_LEN plus the one byte that keeps full from looking
+//    like empty, so it always holds QUEUE_DEPTH-1 messages of MAX_MSG_LEN just like UniRemoteRcvrSlotStorage,
+//    but many more short messages, in less RAM than QUEUE_DEPTH slots.
+//    Each message takes its length (including the zero termination) plus sizeof(record_hdr_t) (16) bytes.
+//
+template <uint16_t QUEUE_DEPTH, uint16_t MAX_MSG_LEN>
+class UniRemoteRcvrByteRingStorage {
+private:
+  typedef struct {
+    int64_t usec_rcvd;                  // esp_timer_get_time() in the ESP-NOW rcvr callback
+    uint32_t msg_num;                   // msg num; may skip if messages discarded
+    uint16_t msg_len;                   // length including trailing zero byte
+    int16_t msg_status;                 // status for this individual message. Almost certainly ESP_OK
+  } record_hdr_t;
+
+public:
+  static constexpr uint32_t RING_NUM_BYTES = (uint32_t) (QUEUE_DEPTH - 1) * (MAX_MSG_LEN + sizeof(record_hdr_t)) + 1;
+  static_assert(RING_NUM_BYTES <= 0xFFFF, "UniRemoteRcvrByteRingStorage: (QUEUE_DEPTH-1)*(MAX_MSG_LEN+16)+1 must fit in uint16_t");
+  static constexpr uint16_t CAPACITY = RING_NUM_BYTES; // reported as extended status idx_num
+
+  void reset() { m_idx_in = m_idx_out = 0; m_put_num = m_got_num = 0; } // when in == out, ring is empty
+
+  bool is_empty() const { return(m_idx_in == m_idx_out); }
+
+  // num_queued() - each count has only one writer so this is safe from either side
+  uint16_t num_queued() const { return((uint16_t) (m_put_num - m_got_num)); }
+
+  // put() - returns false if no room
+  bool put(const uint8_t * p_msg_ptr, uint16_t p_msg_len, uint32_t p_msg_num, int64_t p_usec_rcvd) {
+    record_hdr_t hdr;
+    // need room for header and message plus one byte so that full never looks like empty
+    if ((ring_used(m_idx_in, m_idx_out) + sizeof(hdr) + p_msg_len) >= RING_NUM_BYTES) return(false); // no room
+    hdr.usec_rcvd = p_usec_rcvd;
+    hdr.msg_status = ESP_OK;
+    hdr.msg_num = p_msg_num;
+    hdr.msg_len = p_msg_len;
+    uint16_t new_idx = ring_write(m_idx_in, &hdr, sizeof(hdr));
+    new_idx = ring_write(new_idx, p_msg_ptr, p_msg_len);
+    m_put_num += 1;
+    m_idx_in = new_idx; // MUST be last manipulation of circular buffer
+    return(true);
+  } // end put()
+
+  // get() - returns false if empty
+  bool get(char * p_msg_ptr, uint16_t * p_msg_len_ptr, uint32_t * p_msg_num_ptr, esp_err_t * p_msg_stat_ptr, int64_t * p_usec_rcvd_ptr) {
+    if (is_empty()) return(false);
+    record_hdr_t hdr;
+    uint16_t new_idx = ring_read(m_idx_out, &hdr, sizeof(hdr));
+    *p_usec_rcvd_ptr = hdr.usec_rcvd;
+    *p_msg_stat_ptr = hdr.msg_status;
+    *p_msg_num_ptr =  hdr.msg_num;
+    *p_msg_len_ptr =  hdr.msg_len;
+    new_idx = ring_read(new_idx, p_msg_ptr, hdr.msg_len);
+    uni_remote_rcvr_zero_terminate(p_msg_ptr, hdr.msg_len);
+    m_got_num += 1;
+    m_idx_out = new_idx;  // MUST be last manipulation of circular buffer
+    return(true);
+  } // end get()
+
+private:
+  // ring_used() - return number of bytes in use
+  static uint16_t ring_used(uint16_t p_idx_in, uint16_t p_idx_out) {
+    if (p_idx_in >= p_idx_out) return(p_idx_in - p_idx_out);
+    return(p_idx_in + RING_NUM_BYTES - p_idx_out);
+  } // end ring_used()
+
+  // ring_write() - copy bytes into the ring starting at p_idx, wrapping around the end
+  //       returns: byte offset just past the copied bytes
+  uint16_t ring_write(uint16_t p_idx, const void * p_src_ptr, uint16_t p_len) {
+    uint16_t len_to_end = RING_NUM_BYTES - p_idx;
+    if (p_len <= len_to_end) {
+      memcpy(&m_ring[p_idx], p_src_ptr, p_len);
+    } else {
+      memcpy(&m_ring[p_idx], p_src_ptr, len_to_end);
+      memcpy(&m_ring[0], (const uint8_t *)p_src_ptr + len_to_end, p_len - len_to_end);
+    }
+    return((p_idx + p_len) % RING_NUM_BYTES);
+  } // end ring_write()
+
+  // ring_read() - copy bytes out of the ring starting at p_idx, wrapping around the end
+  //       returns: byte offset just past the copied bytes
+  uint16_t ring_read(uint16_t p_idx, void * p_dst_ptr, uint16_t p_len) const {
+    uint16_t len_to_end = RING_NUM_BYTES - p_idx;
+    if (p_len <= len_to_end) {
+      memcpy(p_dst_ptr, &m_ring[p_idx], p_len);
+    } else {
+      memcpy(p_dst_ptr, &m_ring[p_idx], len_to_end);
+      memcpy((uint8_t *)p_dst_ptr + len_to_end, &m_ring[0], p_len - len_to_end);
+    }
+    return((p_idx + p_len) % RING_NUM_BYTES);
+  } // end ring_read()
+
+  uint16_t m_idx_in;                    // byte offset of next record for put
+  uint16_t m_idx_out;                   // byte offset of next record for get
+  uint32_t m_put_num;                   // messages stored; only written by put()
+  uint32_t m_got_num;                   // messages returned; only written by get()
+  uint8_t m_ring[RING_NUM_BYTES];
+}; // end class UniRemoteRcvrByteRingStorage
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// UniRemoteRcvrQueue - per-sender queues with round-robin get()
+//
+template <uint16_t MAX_SENDERS, uint16_t QUEUE_DEPTH, uint16_t MAX_MSG_LEN, template <uint16_t, uint16_t> class STORAGE>
+class UniRemoteRcvrQueue {
+  static_assert(MAX_SENDERS >= 1, "UniRemoteRcvrQueue: need at least one sender slot");
+  static_assert(MAX_SENDERS <= 64, "UniRemoteRcvrQueue: more than 64 sender slots makes put() too slow for the ESP-NOW rcvr callback");
+  static_assert(QUEUE_DEPTH >= 2, "UniRemoteRcvrQueue: QUEUE_DEPTH must be at least 2; a queue of QUEUE_DEPTH holds QUEUE_DEPTH-1 messages");
+  static_assert(MAX_MSG_LEN >= 2, "UniRemoteRcvrQueue: MAX_MSG_LEN must hold at least one character and the zero termination");
+  static_assert(MAX_MSG_LEN <= ESP_NOW_MAX_DATA_LEN, "UniRemoteRcvrQueue: MAX_MSG_LEN cannot be more than ESP_NOW_MAX_DATA_LEN");
+
+public:
+  static constexpr uint16_t NUM_SENDERS = MAX_SENDERS;
+
+  /////////////////////////////////////////////////////////////////////////////////////////////////////////
+  // init() - empty all the queues, forget all the senders, zero all the counts
+  void init() {
+    for (uint16_t i = 0; i < MAX_SENDERS; i++) {
+      memset(&m_senders[i].stats, 0, sizeof(m_senders[i].stats));
+      m_senders[i].storage.reset();
+    }
+    memset(&m_info, 0, sizeof(m_info));
+    memset(&m_residency, 0, sizeof(m_residency));
+    m_info.idx_num = STORAGE<QUEUE_DEPTH, MAX_MSG_LEN>::CAPACITY;
+    m_msg_dropped_no_slot_num = 0;
+    m_sender_evicted_num = 0;
+    m_idx_next_sender = 0;
+  } // end init()
+
+  /////////////////////////////////////////////////////////////////////////////////////////////////////////
+  // put() - store a message from the ESP-NOW rcvr callback (or anywhere else; but only one thread)
+  //       returns: esp_err_t status
+  //          ESP_OK, ESP_ERR_ESPNOW_FULL (no room; message dropped), or UNI_REMOTE_RCVR_ERR_MSG_TOO_BIG
+  //    Counts this as a callback for msg_callback_num.
+  //    p_rssi is the signal strength of the message in dBm, or zero if not known.
+  //
+  esp_err_t put(const uint8_t * p_mac_addr_ptr, const uint8_t * p_msg_ptr, int p_msg_len, int16_t p_rssi = 0) {
+    int64_t usec_rcvd = esp_timer_get_time(); // before anything else so residency includes all of our time
+    m_info.msg_callback_num += 1;
+    if ((p_msg_len < 0) || (p_msg_len > MAX_MSG_LEN)) { // message too big for this queue
+      m_info.flag_data_too_big = 1;
+      m_info.msg_too_big_num += 1;
+      return(UNI_REMOTE_RCVR_ERR_MSG_TOO_BIG);
+    }
+
+    sender_t * sender_ptr = find_sender(p_mac_addr_ptr);
+    if ((sender_t *) 0 == sender_ptr) { // no sender slot available
+      m_msg_dropped_no_slot_num += 1;
+      note_dropped(p_mac_addr_ptr);
+      return(ESP_ERR_ESPNOW_FULL);
+    }
+    sender_ptr->stats.msec_last_rcvd = millis();
+    if (0 != p_rssi) note_rssi(sender_ptr, p_rssi); // even if the message is dropped, we heard it
+
+    if (!sender_ptr->storage.put(p_msg_ptr, (uint16_t) p_msg_len, m_info.msg_callback_num, usec_rcvd)) { // no room
+      sender_ptr->stats.msg_dropped_num += 1;
+      note_dropped(p_mac_addr_ptr);
+      return(ESP_ERR_ESPNOW_FULL);
+    }
+    sender_ptr->stats.msg_rcvd_num += 1;
+
+    // high-water marks; get() can only make the queue shorter so this never reads too high
+    uint16_t num_queued = sender_ptr->storage.num_queued();
+    if (num_queued > sender_ptr->stats.msg_queued_high_water_num) sender_ptr->stats.msg_queued_high_water_num = num_queued;
+    if (num_queued > m_info.queue_high_water_num) m_info.queue_high_water_num = num_queued;
+    return(ESP_OK);
+  } // end put()
+
+  /////////////////////////////////////////////////////////////////////////////////////////////////////////
+  // get() - same as uni_remote_rcvr_get_msg_timed()
+  //    Senders are visited round-robin starting after the sender we returned a message from last time.
+  //    The time the message waited in the queue goes into the residency histogram.
+  //
+  esp_err_t get(uint16_t * p_rcvd_len_ptr, char * p_rcvd_msg_ptr, uint8_t * p_mac_addr_ptr, uint32_t * p_msg_num_ptr, int64_t * p_usec_rcvd_ptr) {
+    esp_err_t msg_status;
+    uint16_t sender_idx = m_idx_next_sender;
+
+    *p_rcvd_len_ptr = 0; // there is no data to return unless we find some
+    for (uint16_t i = 0; i < MAX_SENDERS; i++, sender_idx = (sender_idx + 1) % MAX_SENDERS) {
+      sender_t * sender_ptr = &m_senders[sender_idx];
+      if (sender_ptr->storage.is_empty()) continue;
+      // the slot is never re-used while it has messages, so the MAC address is stable
+      memcpy(p_mac_addr_ptr, &sender_ptr->stats.mac_addr[0], ESP_NOW_ETH_ALEN);
+      sender_ptr->storage.get(p_rcvd_msg_ptr, p_rcvd_len_ptr, p_msg_num_ptr, &msg_status, p_usec_rcvd_ptr);
+      note_residency(esp_timer_get_time() - *p_usec_rcvd_ptr);
+      m_idx_next_sender = (sender_idx + 1) % MAX_SENDERS;
+      break;
+    } // end for all senders
+
+    if (0 != m_info.flag_circ_buf_full)     return(UNI_REMOTE_RCVR_ERR_CBUF_MSG_DROPPED);
+    else if (0 != m_info.flag_data_too_big) return(UNI_REMOTE_RCVR_ERR_MSG_TOO_BIG);
+    return(ESP_OK);
+  } // end get()
+
+  /////////////////////////////////////////////////////////////////////////////////////////////////////////
+  // get_extended_status() - same as uni_remote_rcvr_get_extended_status()
+  void get_extended_status(uni_remote_rcvr_cbuf_extended_status_t * p_extended_status_ptr) const {
+    memcpy(p_extended_status_ptr, &m_info, sizeof(uni_remote_rcvr_cbuf_extended_status_t));
+  } // end get_extended_status()
+
+  /////////////////////////////////////////////////////////////////////////////////////////////////////////
+  // clear_extended_status_flags() - same as uni_remote_rcvr_clear_extended_status_flags()
+  void clear_extended_status_flags() {
+    m_info.flag_circ_buf_full = 0;
+    m_info.flag_data_too_big  = 0;
+  } // end clear_extended_status_flags()
+
+  /////////////////////////////////////////////////////////////////////////////////////////////////////////
+  // get_residency() - same as uni_remote_rcvr_get_residency()
+  void get_residency(uni_remote_rcvr_residency_t * p_residency_ptr) const {
+    memcpy(p_residency_ptr, &m_residency, sizeof(uni_remote_rcvr_residency_t));
+  } // end get_residency()
+
+  /////////////////////////////////////////////////////////////////////////////////////////////////////////
+  // get_sender_stats() - fills in up to p_num_senders entries of p_senders_ptr
+  //    also returns the two counts that are not per-sender (either pointer may be zero)
+  void get_sender_stats(uni_remote_rcvr_sender_stats_t * p_senders_ptr, uint16_t p_num_senders,
+                        uint32_t * p_msg_dropped_no_slot_num_ptr, uint32_t * p_sender_evicted_num_ptr) const {
+    for (uint16_t i = 0; (i < MAX_SENDERS) && (i < p_num_senders); i++) {
+      memcpy(&p_senders_ptr[i], &m_senders[i].stats, sizeof(uni_remote_rcvr_sender_stats_t));
+      p_senders_ptr[i].msg_queued_num = m_senders[i].storage.num_queued();
+    }
+    for (uint16_t i = MAX_SENDERS; i < p_num_senders; i++) {
+      memset(&p_senders_ptr[i], 0, sizeof(uni_remote_rcvr_sender_stats_t));
+    }
+    if ((uint32_t *) 0 != p_msg_dropped_no_slot_num_ptr) *p_msg_dropped_no_slot_num_ptr = m_msg_dropped_no_slot_num;
+    if ((uint32_t *) 0 != p_sender_evicted_num_ptr)      *p_sender_evicted_num_ptr = m_sender_evicted_num;
+  } // end get_sender_stats()
+
+private:
+  typedef struct {
+    uni_remote_rcvr_sender_stats_t stats;   // MAC address and counts for this sender
+    STORAGE<QUEUE_DEPTH, MAX_MSG_LEN> storage; // the queue for this sender
+    int32_t rssi_avg_x16;                   // stats.rssi_avg times 16 so the average does not stick; only written by put()
+  } sender_t;
+
+  // note_rssi() - keep the most recent and averaged signal strength of a sender; only called from put()
+  //    the average moves 1/8 of the way to each new value
+  void note_rssi(sender_t * p_sender_ptr, int16_t p_rssi) {
+    if (0 == p_sender_ptr->stats.rssi_avg) p_sender_ptr->rssi_avg_x16 = (int32_t) p_rssi * 16; // first one
+    else p_sender_ptr->rssi_avg_x16 += ((int32_t) p_rssi * 16 - p_sender_ptr->rssi_avg_x16) / 8;
+    p_sender_ptr->stats.rssi_last = p_rssi;
+    p_sender_ptr->stats.rssi_avg = (int16_t) (p_sender_ptr->rssi_avg_x16 / 16);
+  } // end note_rssi()
+
+  // note_dropped() - set the sticky flag and remember whose message it was
+  void note_dropped(const uint8_t * p_mac_addr_ptr) {
+    m_info.flag_circ_buf_full = 1;
+    m_info.msg_dropped_num += 1;
+    memcpy(m_info.last_dropped_mac_addr, p_mac_addr_ptr, ESP_NOW_ETH_ALEN);
+  } // end note_dropped()
+
+  // note_residency() - count how long a message waited; only called from get()
+  //    hist[0] is less than 1 msec; hist[i] is at least 2^(i-1) and less than 2^i msec; the last one is everything longer
+  void note_residency(int64_t p_usec_waited) {
+    uint32_t usec_waited = (p_usec_waited < 0) ? 0 : ((p_usec_waited > 0xFFFFFFFF) ? 0xFFFFFFFF : (uint32_t) p_usec_waited);
+    uint32_t msec_waited = usec_waited / 1000;
+    uint16_t bucket = (0 == msec_waited) ? 0 : (32 - __builtin_clz(msec_waited));
+    if (bucket >= UNI_REMOTE_RCVR_RESIDENCY_HIST_NUM) bucket = UNI_REMOTE_RCVR_RESIDENCY_HIST_NUM - 1;
+    m_residency.hist[bucket] += 1;
+    m_residency.msg_num += 1;
+    m_residency.usec_total += usec_waited;
+    if (usec_waited > m_residency.usec_max) m_residency.usec_max = usec_waited;
+  } // end note_residency()
+
+  /////////////////////////////////////////////////////////////////////////////////////////////////////////
+  // find_sender() - return pointer to sender for p_mac_addr_ptr or zero if there is no slot available
+  //    note: only called from put()
+  //
+  // If the sender is not already tracked, use a free slot. If there are no free slots,
+  //    re-use the slot of the least-recently-heard sender that has nothing queued.
+  //    A slot with messages queued is never re-used.
+  sender_t * find_sender(const uint8_t * p_mac_addr_ptr) {
+    sender_t * sender_ptr;
+    sender_t * free_ptr = (sender_t *) 0;
+    sender_t * evict_ptr = (sender_t *) 0;
+    uint32_t msec_now = millis();
+
+    for (uint16_t i = 0; i < MAX_SENDERS; i++) {
+      sender_ptr = &m_senders[i];
+      if (0 == sender_ptr->stats.in_use) {
+        if ((sender_t *) 0 == free_ptr) free_ptr = sender_ptr;
+      } else if (0 == memcmp(sender_ptr->stats.mac_addr, p_mac_addr_ptr, ESP_NOW_ETH_ALEN)) {
+        return(sender_ptr); // already tracking this sender
+      } else if (sender_ptr->storage.is_empty()) {
+        if (((sender_t *) 0 == evict_ptr) ||
+            ((msec_now - sender_ptr->stats.msec_last_rcvd) > (msec_now - evict_ptr->stats.msec_last_rcvd))) {
+          evict_ptr = sender_ptr;
+        }
+      }
+    } // end for all sender slots
+
+    if ((sender_t *) 0 != free_ptr) {
+      sender_ptr = free_ptr;
+      m_info.num_senders += 1;
+    } else if ((sender_t *) 0 != evict_ptr) {
+      sender_ptr = evict_ptr;
+      m_sender_evicted_num += 1;
+    } else {
+      return((sender_t *) 0); // every slot has messages queued
+    }
+
+    // start tracking the new sender; its queue is empty
+    memcpy(sender_ptr->stats.mac_addr, p_mac_addr_ptr, ESP_NOW_ETH_ALEN);
+    sender_ptr->stats.msg_rcvd_num = 0;
+    sender_ptr->stats.msg_dropped_num = 0;
+    sender_ptr->stats.msg_queued_high_water_num = 0;
+    sender_ptr->stats.rssi_last = sender_ptr->stats.rssi_avg = 0;
+    sender_ptr->rssi_avg_x16 = 0;
+    sender_ptr->stats.in_use = 1;
+    return(sender_ptr);
+  } // end find_sender()
+
+  uni_remote_rcvr_cbuf_extended_status_t m_info;
+  uni_remote_rcvr_residency_t m_residency; // only written by get()
+  uint32_t m_msg_dropped_no_slot_num;   // messages dropped because no sender slot was available
+  uint32_t m_sender_evicted_num;        // number of times a sender slot was re-used for a new sender
+  uint16_t m_idx_next_sender;           // round-robin: next sender to look at in get()
+  sender_t m_senders[MAX_SENDERS];
+}; // end class UniRemoteRcvrQueue
+
+#endif // UNI_REMOTE_RCVR_QUEUE_H
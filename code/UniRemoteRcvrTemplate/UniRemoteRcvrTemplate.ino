@@ -33,6 +33,10 @@
 
 
 #include "UniRemoteRcvr.h" // my library for UniRemoteRcvr
+#include "UniRemoteTimer.h" // deadlines and periodic jobs; safe when millis() wraps
+#include "UniRemoteStall.h" // report code that stops loop() too long; watchdog
+#include "UniRemoteSerialCmd.h" // commands typed on the Serial port
+#include "UniRemoteJournal.h" // what happened, kept in flash across resets; "journal" on Serial prints it
 
 #define MDO_USE_OTA 1   // zero to not use, non-zero to use OTA ESP32 Over-The-Air software updates
 
@@ -43,6 +47,46 @@
 static char g_my_message[ESP_NOW_MAX_DATA_LEN];     // received message
 static uint8_t g_sender_mac_addr[ESP_NOW_ETH_ALEN]; // sender MAC address
 static uint32_t g_my_message_num = 0;               // increments for each msg received unless UNI_REMOTE_RCVR_ERR_CBUF_MSG_DROPPED
+static int64_t g_my_message_usec_rcvd = 0;          // esp_timer_get_time() when ESP-NOW rcvr callback got the message
+
+#define UNI_TELEMETRY_PRINT_MSEC 60000 // how often to print receiver telemetry; zero to never print
+#define UNI_PRINT_MSG_TIMING 1          // non-zero to print where the time went for each message
+#define UNI_LOOP_SLEEP_MAX_MSEC 200     // longest loop() sleep; how long a message can wait for us
+#define UNI_RCVR_NAME "RcvrTemplate"   // name UniRemoteCYD shows for this receiver; up to 16 chars
+#define UNI_RCVR_ALIAS ""              // 1 or 2 letters or digits for command cards ("K2|LED:ON"); "" for none
+#define UNI_STALL_WDT_MSEC 8000        // loop() must come around this often or the ESP32 resets; zero for no watchdog
+#define UNI_JOURNAL_CHECK_MSEC 1000     // how often to see if journal records should go to flash
+
+// journal event ids; see UniRemoteJournal.h
+#define UNI_JOURNAL_ID_MSG      (UNI_JOURNAL_ID_FIRST+0) // message received; arg is g_my_message_num, arg8 its length
+#define UNI_JOURNAL_ID_RCVR_ERR (UNI_JOURNAL_ID_FIRST+1) // uni_remote_rcvr_get_msg_timed() error; arg is the status
+#define UNI_JOURNAL_ID_EXEC_AT  (UNI_JOURNAL_ID_FIRST+2) // executed at the requested time; arg is the error in usec
+#define UNI_JOURNAL_ID_OTA      (UNI_JOURNAL_ID_FIRST+3) // OTA:WEB received; OTA web updater started
+
+// timed pieces of loop(); see UniRemoteStall.h
+static uni_stall_section_t g_stall_handle_msg = UNI_STALL_SECTION("handle_msg", 100);
+// waiting for "execute at" is on purpose; it can take up to UNI_REMOTE_RCVR_EXEC_MAX_MSEC and feeds the watchdog
+static uni_stall_section_t g_stall_exec_wait = UNI_STALL_SECTION("exec_wait", UNI_REMOTE_RCVR_EXEC_MAX_MSEC+100);
+static_assert(UNI_REMOTE_RCVR_EXEC_FEED_MSEC < UNI_STALL_WDT_MSEC, "uni_remote_rcvr_wait_until() must feed the watchdog in time");
+static uni_stall_section_t g_stall_journal = UNI_STALL_SECTION("journal", 100); // journal records to flash
+#if MDO_USE_OTA
+static uni_stall_section_t g_stall_ota = UNI_STALL_SECTION("ota", 100); // connecting to the router takes seconds, once
+#endif // MDO_USE_OTA
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// print_mac_addr()
+//       returns: nothing
+//   prints MAC address as :XX:XX:XX:XX:XX:XX
+//
+void print_mac_addr(const uint8_t * p_mac_addr) {
+  for (int i = 0; i < ESP_NOW_ETH_ALEN; i++) {
+    Serial.print(":");
+    if (p_mac_addr[i] < 16) { // is this stupid or what?
+      Serial.print("0");
+    }
+    Serial.print(p_mac_addr[i],HEX);
+  }
+} // end print_mac_addr()
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 // print_error_status_info()
@@ -53,8 +97,14 @@ void print_error_status_info(esp_err_t msg_status) {
   if (UNI_REMOTE_RCVR_OK == msg_status) {
     return;
   } else if (UNI_REMOTE_RCVR_ERR_CBUF_MSG_DROPPED == msg_status) {
+    uni_remote_rcvr_cbuf_extended_status_t extended_status;
+    uni_remote_rcvr_get_extended_status(&extended_status);
     Serial.print("ERROR: ESP-NOW recv cb error: recv msg but no room in FIFO, some message(s) dropped: msg ");
-    Serial.println(g_my_message_num);
+    Serial.print(g_my_message_num);
+    Serial.print(" last dropped from mac_addr");
+    print_mac_addr(extended_status.last_dropped_mac_addr);
+    Serial.print(" total dropped ");
+    Serial.println(extended_status.msg_dropped_num);
   } else if (UNI_REMOTE_RCVR_ERR_MSG_TOO_BIG == msg_status) {
     Serial.print("ERROR: ESP-NOW recv cb error: recv_len too big: msg ");
     Serial.println(g_my_message_num);
@@ -66,6 +116,129 @@ void print_error_status_info(esp_err_t msg_status) {
   } // end display error status returns
 } // end print_error_status_info()
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// print_telemetry()
+//       returns: nothing
+//   prints the receiver counts used to choose UNI_REMOTE_RCVR_NUM_BUFR and how often loop() gets messages
+//
+void print_telemetry() {
+  uni_remote_rcvr_cbuf_extended_status_t extended_status;
+  uni_remote_rcvr_residency_t residency;
+  uni_remote_rcvr_all_sender_stats_t sender_stats;
+  uni_remote_rcvr_get_extended_status(&extended_status);
+  uni_remote_rcvr_get_residency(&residency);
+  uni_remote_rcvr_get_sender_stats(&sender_stats);
+
+  Serial.print("UniRemoteRcvr telemetry: callbacks ");
+  Serial.print(extended_status.msg_callback_num);
+  Serial.print(" dropped ");
+  Serial.print(extended_status.msg_dropped_num);
+  Serial.print(" too big ");
+  Serial.print(extended_status.msg_too_big_num);
+  Serial.print(" queue high water ");
+  Serial.println(extended_status.queue_high_water_num);
+  for (int i = 0; i < UNI_REMOTE_RCVR_MAX_SENDERS; i++) {
+    if (0 == sender_stats.senders[i].in_use) continue;
+    Serial.print("   sender ");
+    print_mac_addr(sender_stats.senders[i].mac_addr);
+    Serial.print(" rcvd ");
+    Serial.print(sender_stats.senders[i].msg_rcvd_num);
+    Serial.print(" dropped ");
+    Serial.print(sender_stats.senders[i].msg_dropped_num);
+    Serial.print(" rssi dBm avg ");
+    Serial.print(sender_stats.senders[i].rssi_avg);
+    Serial.print(" last ");
+    Serial.println(sender_stats.senders[i].rssi_last);
+  }
+  if (0 == residency.msg_num) return;
+  Serial.print("   waited usec avg ");
+  Serial.print((uint32_t) (residency.usec_total / residency.msg_num));
+  Serial.print(" max ");
+  Serial.print(residency.usec_max);
+  Serial.print(" msec histogram");
+  for (int i = 0; i < UNI_REMOTE_RCVR_RESIDENCY_HIST_NUM; i++) {
+    if (i < UNI_REMOTE_RCVR_RESIDENCY_HIST_NUM-1) { Serial.print(" <");  Serial.print(1 << i); }
+    else                                          { Serial.print(" >="); Serial.print(1 << (i-1)); }
+    Serial.print(":");
+    Serial.print(residency.hist[i]);
+  }
+  Serial.println(" ");
+} // end print_telemetry()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// print_time_sync()
+//       returns: nothing
+//   prints how well we know the UniRemoteCYD clock from its time beacons and how well "execute at" went
+//
+void print_time_sync() {
+  uni_remote_rcvr_time_sync_t sync;
+  uni_remote_rcvr_get_time_sync(&sync);
+
+  if (0 == sync.has_sync) {
+    Serial.println("UniRemoteRcvr time sync: no time beacons yet");
+    return;
+  }
+  Serial.print("UniRemoteRcvr time sync: beacon mac_addr");
+  print_mac_addr(sync.beacon_mac_addr);
+  Serial.print(" beacons ");
+  Serial.print(sync.beacon_num);
+  Serial.print(" missed ");
+  Serial.print(sync.beacon_missed_num);
+  Serial.print(" dropped ");
+  Serial.print(sync.beacon_dropped_num);
+  Serial.print(" msec since last ");
+  Serial.println(sync.msec_since_beacon);
+  Serial.print("   clock offset usec ");
+  Serial.print(sync.usec_clock_offset);
+  Serial.print(" drift ppb ");
+  Serial.print(sync.drift_ppb);
+  Serial.print(" jitter usec ");
+  Serial.print(sync.usec_jitter);
+  Serial.print(" execute-at num ");
+  Serial.print(sync.exec_num);
+  Serial.print(" late ");
+  Serial.print(sync.exec_late_num);
+  Serial.print(" max err usec ");
+  Serial.println(sync.usec_exec_err_max);
+} // end print_time_sync()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// print_msg_timing()
+//       returns: nothing
+//   prints per-stage latency for the message just handled, from scan on UniRemoteCYD to handler done here
+//
+void print_msg_timing() {
+  uni_remote_rcvr_msg_timing_t timing;
+  uni_remote_rcvr_get_msg_timing(&timing); // call when done with the message; measures handler time
+
+  Serial.print(" timing usec:");
+  if (0 != timing.has_timing) {
+    Serial.print(" seq ");
+    Serial.print(timing.seq);
+    Serial.print(" scan ");
+    Serial.print(timing.usec_scan);
+    Serial.print(" parse ");
+    Serial.print(timing.usec_parse);
+    Serial.print(" queue ");
+    Serial.print(timing.usec_queue);
+    Serial.print(" air ");
+    Serial.print(timing.usec_air);
+  } else {
+    Serial.print(" (no sender timing)");
+  }
+  Serial.print(" rcvr queue ");
+  Serial.print(timing.usec_rcvr_queue);
+  Serial.print(" handler ");
+  Serial.print(timing.usec_handler);
+  if (0 != timing.has_timing) {
+    Serial.print(" total ");
+    Serial.print(timing.usec_total);
+    Serial.print(" clock offset ");
+    Serial.print(timing.usec_clock_offset);
+  }
+  Serial.println(" ");
+} // end print_msg_timing()
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 // handle_message()
 //       returns: nothing
@@ -79,13 +252,7 @@ void handle_message(uint16_t rcvd_len) {
 
   // print originating MAC address
   Serial.print(" sending mac_addr");
-  for (int i = 0; i < sizeof(g_sender_mac_addr); i++) {
-    Serial.print(":");
-    if (g_sender_mac_addr[i] < 16) { // is this stupid or what?
-      Serial.print("0");
-    }
-    Serial.print(g_sender_mac_addr[i],HEX);
-  }
+  print_mac_addr(g_sender_mac_addr);
   Serial.println(" ");
 
   // print info about message and the message itself (assumed to be zero-terminated ASCII string)
@@ -93,17 +260,39 @@ void handle_message(uint16_t rcvd_len) {
   Serial.print(rcvd_len);
   Serial.print(" '");
   Serial.print((char *)g_my_message);
-  Serial.println("'");
+  Serial.print("' waited usec ");
+  Serial.println((uint32_t) (esp_timer_get_time() - g_my_message_usec_rcvd));
 
 #if MDO_USE_OTA // if using Over-The-Air software updates
   if ((NULL != strstr(g_my_message,"OTA:WEB")) && (NULL != strstr(g_my_message,WIFI_OTA_ESP_NOW_PWD))) {
     // This is the correct parameter for code that is using ESP-NOW but not connecting to router (already in WiFi STA mode but no IP address)
+    uni_journal_add(UNI_JOURNAL_ID_OTA, 0, 0);
     mdo_ota_web_request(START_OTA_WEB_BEGIN_WIFI | START_OTA_WEB_INIT_MDNS | START_OTA_WEB_INIT_UPDATER_WEBPAGE); // loop() will handle it
   }
 #endif // MDO_USE_OTA if using Over-The-Air software updates
 
 } // end handle_message()
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// print_telemetry_job() - periodic job every UNI_TELEMETRY_PRINT_MSEC; see setup()
+//       returns: nothing
+//
+void print_telemetry_job(uint32_t p_msec_now) {
+  print_telemetry();
+  print_time_sync();
+} // end print_telemetry_job()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// journal_flush_job() - periodic job every UNI_JOURNAL_CHECK_MSEC; see setup()
+//       returns: nothing
+//
+// runs from uni_timer_run() after any message has been handled, so a message never waits for flash
+//
+void journal_flush_job(uint32_t p_msec_now) {
+  UNI_STALL_SCOPE(g_stall_journal);
+  uni_journal_flush(p_msec_now, 0);
+} // end journal_flush_job()
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 // setup() - initialize hardware and software
 //       returns: nothing
@@ -126,6 +315,32 @@ void setup() {
     Serial.println(status_init_uni_remote_rcvr);
     return;
   }
+
+  // print telemetry every so often
+  if (0 != UNI_TELEMETRY_PRINT_MSEC) {
+    uni_timer_add(print_telemetry_job, UNI_TELEMETRY_PRINT_MSEC, UNI_TELEMETRY_PRINT_MSEC, 1);
+  }
+
+  // journal in flash; records why we reset, then each message and error
+  if (0 != uni_journal_setup()) {
+    Serial.println("ERROR: LittleFS journal not available; is there a SPIFFS partition?");
+  }
+  uni_journal_name(UNI_JOURNAL_ID_MSG, "msg");
+  uni_journal_name(UNI_JOURNAL_ID_RCVR_ERR, "rcvr_err");
+  uni_journal_name(UNI_JOURNAL_ID_EXEC_AT, "exec_at");
+  uni_journal_name(UNI_JOURNAL_ID_OTA, "ota");
+  uni_timer_add(journal_flush_job, UNI_JOURNAL_CHECK_MSEC, UNI_JOURNAL_CHECK_MSEC, 1);
+  uni_serial_cmd_add("journal", uni_journal_cmd, "journal [clear] - print what happened, every boot; clear empties it");
+
+  // tell UniRemoteCYD who we are; it answers requests to announce from then on
+  esp_err_t status_announce = uni_remote_rcvr_announce(UNI_RCVR_NAME, UNI_RCVR_ALIAS, MDO_USE_OTA ? UNI_REMOTE_RCVR_CAP_OTA : 0);
+  if (status_announce != ESP_OK) {
+    Serial.print("ERROR: announcement error; status: ");
+    Serial.println(status_announce);
+  }
+
+  // report a stall that reset us last time; then loop() goes on the watchdog
+  uni_stall_setup(UNI_STALL_WDT_MSEC);
 } // end setup()
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -136,10 +351,11 @@ void loop() {
   uint16_t rcvd_len = 0; // the length of the message/command. If zero, no message.
 
   // get any message received. If 0 == rcvd_len, no message.
-  esp_err_t msg_status = uni_remote_rcvr_get_msg(&rcvd_len, &g_my_message[0], &g_sender_mac_addr[0], &g_my_message_num);
+  esp_err_t msg_status = uni_remote_rcvr_get_msg_timed(&rcvd_len, &g_my_message[0], &g_sender_mac_addr[0], &g_my_message_num, &g_my_message_usec_rcvd);
 
   // we can get an error even if no message
   print_error_status_info(msg_status); // won't print if UNI_REMOTE_RCVR_OK (== ESP_OK)
+  if (UNI_REMOTE_RCVR_OK != msg_status) uni_journal_add(UNI_JOURNAL_ID_RCVR_ERR, msg_status, 0);
 
   // these error codes come from set/clear flags; clear so can detect next time
   if ((UNI_REMOTE_RCVR_ERR_CBUF_MSG_DROPPED == msg_status) || (UNI_REMOTE_RCVR_ERR_MSG_TOO_BIG == msg_status)) {
@@ -149,13 +365,39 @@ void loop() {
   // we can get a message with or without an error; see above uni_remote_rcvr_clear_extended_status_flags()
   // If 0 == rcvd_len, no message.
   if (rcvd_len > 0) {
+    // if UniRemoteCYD said when to execute it, wait for that time so all the receivers act together
+    int64_t usec_exec_at;
+    int16_t has_exec_at = uni_remote_rcvr_get_msg_exec_at(&usec_exec_at);
+    int32_t usec_exec_err = 0;
+    if (0 != has_exec_at) {
+      uni_stall_enter(&g_stall_exec_wait);
+      usec_exec_err = uni_remote_rcvr_wait_until(usec_exec_at);
+      uni_stall_leave();
+    }
+    UNI_STALL_SCOPE(g_stall_handle_msg);
     handle_message(rcvd_len);
+    uni_journal_add(UNI_JOURNAL_ID_MSG, (int32_t) g_my_message_num, (rcvd_len > 255) ? 255 : (uint8_t) rcvd_len);
+    if (0 != has_exec_at) {
+      Serial.print(" executed at the requested time; error usec "); // positive is late
+      Serial.println(usec_exec_err);
+      uni_journal_add(UNI_JOURNAL_ID_EXEC_AT, usec_exec_err, 0);
+    }
+#if UNI_PRINT_MSG_TIMING
+    print_msg_timing();
+#endif // UNI_PRINT_MSG_TIMING
   }
 
+  uni_serial_cmd_poll(); // commands typed on Serial: "journal", "help"
+
+  // periodic jobs (telemetry, journal); sleep until the next one is due but no longer than UNI_LOOP_SLEEP_MAX_MSEC
+  uint32_t msec_sleep = uni_timer_run(millis(), UNI_LOOP_SLEEP_MAX_MSEC);
+
 #if MDO_USE_OTA // if using Over-The-Air software updates
   // if using Over-The-Air software updates
+  uni_stall_enter(&g_stall_ota);
   mdo_ota_web_loop();
+  uni_stall_leave();
 #endif // MDO_USE_OTA if using Over-The-Air software updates
 
-  delay(200);
+  delay(msec_sleep);
 } // end loop()
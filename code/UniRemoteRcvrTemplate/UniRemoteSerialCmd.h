@@ -0,0 +1,123 @@
+/* Author: https://github.com/Mark-MDO47  Mar. 4, 2025
+ *  https://github.com/Mark-MDO47/UniRemote
+ */
+
+/*
+   Copyright 2025 Mark Olson
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * UniRemoteSerialCmd - commands typed on the Serial port for the UniRemote sketches
+ *
+ * Used by UniRemoteCYD as "../UniRemoteRcvrTemplate/UniRemoteSerialCmd.h"; a receiver can copy it
+ *    along with UniRemoteRcvr.* the same as UniRemoteTimer.h.
+ *
+ * A component registers a command with uni_serial_cmd_add(): the first word of the line, a function
+ *    to call with the rest of the line, and one line of help. loop() calls uni_serial_cmd_poll(), which
+ *    takes whatever characters have arrived without waiting and calls the command when the line ends.
+ *    "help" lists the commands.
+ *
+ * Everything here is static in the header: each sketch gets its own table.
+ *    Only call these from loop() level, never from a callback.
+ */
+
+#ifndef UNI_REMOTE_SERIAL_CMD_H
+#define UNI_REMOTE_SERIAL_CMD_H 1
+
+#include <Arduino.h>  // for Serial
+
+#define UNI_SERIAL_CMD_NUM 12         // most commands in the table
+#define UNI_SERIAL_CMD_LINE_MAX 80    // longest line; longer lines are thrown away
+#define UNI_SERIAL_CMD_POLL_MAX 64    // most characters taken per uni_serial_cmd_poll()
+
+// a command; p_args is the rest of the line after the command word and spaces; never NULL
+typedef void (*uni_serial_cmd_fn_t)(const char * p_args);
+
+typedef struct {
+  const char * name;              // first word of the line
+  uni_serial_cmd_fn_t fn;
+  const char * help;              // one line for "help"
+} uni_serial_cmd_t;
+static uni_serial_cmd_t g_uni_serial_cmds[UNI_SERIAL_CMD_NUM];
+static uint16_t g_uni_serial_cmd_num = 0;
+static char g_uni_serial_cmd_line[UNI_SERIAL_CMD_LINE_MAX+1];
+static uint16_t g_uni_serial_cmd_len = 0;
+static uint8_t g_uni_serial_cmd_overflow = 0; // non-zero: the line got too long; throw it away at its end
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_serial_cmd_add() - register a command
+//       returns: zero if OK; non-zero if the table is full
+//
+static int16_t uni_serial_cmd_add(const char * p_name, uni_serial_cmd_fn_t p_fn, const char * p_help) {
+  if (g_uni_serial_cmd_num >= UNI_SERIAL_CMD_NUM) return(-1);
+  g_uni_serial_cmds[g_uni_serial_cmd_num].name = p_name;
+  g_uni_serial_cmds[g_uni_serial_cmd_num].fn = p_fn;
+  g_uni_serial_cmds[g_uni_serial_cmd_num].help = p_help;
+  g_uni_serial_cmd_num += 1;
+  return(0);
+} // end uni_serial_cmd_add()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_serial_cmd_exec() - run one complete line
+//       returns: nothing
+//
+static void uni_serial_cmd_exec(char * p_line) {
+  char * word = p_line;
+  while (' ' == *word) word += 1;
+  if ('\0' == *word) return; // empty line
+  char * args = word;
+  while (('\0' != *args) && (' ' != *args)) args += 1;
+  if ('\0' != *args) *args++ = '\0';
+  while (' ' == *args) args += 1;
+
+  if (0 == strcmp(word, "help")) {
+    Serial.printf("CMD help - this list\n");
+    for (uint16_t idx = 0; idx < g_uni_serial_cmd_num; idx++) Serial.printf("CMD %s\n", g_uni_serial_cmds[idx].help);
+    return;
+  }
+  for (uint16_t idx = 0; idx < g_uni_serial_cmd_num; idx++) {
+    if (0 == strcmp(word, g_uni_serial_cmds[idx].name)) {
+      g_uni_serial_cmds[idx].fn(args);
+      return;
+    }
+  }
+  Serial.printf("CMD unknown %s; try help\n", word);
+} // end uni_serial_cmd_exec()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_serial_cmd_poll() - take the characters that have arrived; run the command when a line ends
+//       returns: nothing
+//
+// never waits; a line ends with CR or LF (either or both)
+//
+static void uni_serial_cmd_poll() {
+  for (uint16_t num = 0; (num < UNI_SERIAL_CMD_POLL_MAX) && (Serial.available() > 0); num++) {
+    int in_char = Serial.read();
+    if (in_char < 0) break;
+    if (('\r' == in_char) || ('\n' == in_char)) {
+      g_uni_serial_cmd_line[g_uni_serial_cmd_len] = '\0';
+      if (0 != g_uni_serial_cmd_overflow) Serial.printf("CMD line too long; ignored\n");
+      else uni_serial_cmd_exec(g_uni_serial_cmd_line);
+      g_uni_serial_cmd_len = 0;
+      g_uni_serial_cmd_overflow = 0;
+    } else if (g_uni_serial_cmd_len < UNI_SERIAL_CMD_LINE_MAX) {
+      g_uni_serial_cmd_line[g_uni_serial_cmd_len++] = (char) in_char;
+    } else {
+      g_uni_serial_cmd_overflow = 1;
+    }
+  }
+} // end uni_serial_cmd_poll()
+
+#endif // UNI_REMOTE_SERIAL_CMD_H
@@ -0,0 +1,251 @@
+/* Author: https://github.com/Mark-MDO47  Mar. 6, 2025
+ *  https://github.com/Mark-MDO47/UniRemote
+ */
+
+/*
+   Copyright 2025 Mark Olson
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * UniRemoteStall - find the code that stops loop() for too long
+ *
+ * Used by UniRemoteCYD as "../UniRemoteRcvrTemplate/UniRemoteStall.h" and by Uni_RW_PICC the same way;
+ *    a receiver can copy it along with UniRemoteRcvr.* the same as UniRemoteTimer.h.
+ *
+ * A section is a named piece of code with a time budget. UNI_STALL_SCOPE(section) at the top of a
+ *    block times the block. Leaving a section that took longer than its budget counts an overrun and
+ *    prints a STALL line on Serial when it is the longest yet for that section.
+ *
+ * Some stalls never end: a wait for WiFi that never connects, a while(1) after an error. For those:
+ *    - uni_stall_setup() with a watchdog time puts the loop() task on the ESP32 task watchdog; if loop()
+ *      does not come around in that time the ESP32 resets.
+ *    - the innermost open section and the worst overrun are kept in RTC memory that is not cleared by a
+ *      reset (RTC_NOINIT_ATTR), so after the reset uni_stall_setup() prints which section was open, for
+ *      how long, and why the ESP32 reset. Turning the power off does clear it.
+ *    - an esp_timer heartbeat writes millis() into the RTC record every UNI_STALL_HEARTBEAT_MSEC even
+ *      while loop() is stuck, so "how long" is known to within that.
+ *    - a section that waits on purpose (for an operator or a router) calls uni_stall_feed() in its wait loop.
+ *
+ * Everything here is static in the header: each sketch gets its own table.
+ *    A separate .cpp file that included it would get its own copy too, which uni_stall_setup() never
+ *    reports; time the call into that file from the sketch instead (see mdo_ota_web_loop() in the template).
+ *    Only use sections at loop() level (or in setup()), never in a callback.
+ */
+
+#ifndef UNI_REMOTE_STALL_H
+#define UNI_REMOTE_STALL_H 1
+
+#include <Arduino.h>      // for Serial, millis() and enableLoopWDT()
+#include <esp_attr.h>     // for RTC_NOINIT_ATTR
+#include <esp_system.h>   // for esp_reset_reason()
+#include <esp_timer.h>    // for esp_timer_get_time()
+#include <esp_task_wdt.h> // for the task watchdog
+
+#define UNI_STALL_SECTION_NUM 16      // most sections kept for uni_stall_dump()
+#define UNI_STALL_NAME_LEN 15         // section name chars kept in RTC memory
+#define UNI_STALL_NEST_MAX 4          // deepest nesting of sections
+#define UNI_STALL_RTC_MAGIC 0x55AA5354UL // "ST"; RTC record is valid
+#define UNI_STALL_HEARTBEAT_MSEC 100  // how often the heartbeat writes millis() into the RTC record
+
+typedef struct {
+  const char * name;
+  uint32_t budget_usec;           // longer than this is an overrun
+  uint32_t num;                   // times left
+  uint32_t over_num;              // overruns
+  uint32_t usec_max;              // longest
+  uint8_t  listed;                // non-zero once in g_uni_stall_sections[]
+} uni_stall_section_t;
+
+// define a section; p_budget_msec is in milliseconds
+#define UNI_STALL_SECTION(p_name, p_budget_msec) { (p_name), (uint32_t) (p_budget_msec) * 1000UL, 0, 0, 0, 0 }
+
+// kept across a reset but not power off
+typedef struct {
+  uint32_t magic;                 // UNI_STALL_RTC_MAGIC if the rest is valid
+  uint32_t boot_num;              // resets since power on
+  char     open_name[UNI_STALL_NAME_LEN+1]; // innermost open section; empty if none
+  uint32_t open_msec_start;       // millis() when it was entered
+  uint32_t open_budget_msec;
+  uint32_t msec_heartbeat;        // millis() from the heartbeat; about when the reset happened
+  char     worst_name[UNI_STALL_NAME_LEN+1]; // section with the worst overrun since power on
+  uint32_t worst_usec;
+  uint32_t worst_budget_usec;
+  uint32_t worst_boot_num;        // boot_num when it happened
+} uni_stall_rtc_t;
+RTC_NOINIT_ATTR static uni_stall_rtc_t g_uni_stall_rtc;
+
+static uni_stall_section_t * g_uni_stall_sections[UNI_STALL_SECTION_NUM];
+static uint16_t g_uni_stall_section_num = 0;
+static uni_stall_section_t * g_uni_stall_open[UNI_STALL_NEST_MAX]; // open sections, outermost first
+static int64_t g_uni_stall_open_usec[UNI_STALL_NEST_MAX];
+static uint16_t g_uni_stall_depth = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_stall_rtc_open() - record the innermost open section (or none) in RTC memory
+//       returns: nothing
+//
+static void uni_stall_rtc_open() {
+  uni_stall_rtc_t * rtc_ptr = &g_uni_stall_rtc;
+  if ((0 == g_uni_stall_depth) || (g_uni_stall_depth > UNI_STALL_NEST_MAX)) {
+    rtc_ptr->open_name[0] = '\0';
+  } else {
+    uni_stall_section_t * section_ptr = g_uni_stall_open[g_uni_stall_depth-1];
+    strncpy(rtc_ptr->open_name, section_ptr->name, UNI_STALL_NAME_LEN);
+    rtc_ptr->open_name[UNI_STALL_NAME_LEN] = '\0';
+    rtc_ptr->open_msec_start = (uint32_t) (g_uni_stall_open_usec[g_uni_stall_depth-1] / 1000);
+    rtc_ptr->open_budget_msec = section_ptr->budget_usec / 1000;
+  }
+} // end uni_stall_rtc_open()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_stall_heartbeat() - esp_timer callback every UNI_STALL_HEARTBEAT_MSEC; runs even while loop() is stuck
+//       returns: nothing
+//
+// the only writer of msec_heartbeat
+//
+static void uni_stall_heartbeat(void * p_arg) {
+  g_uni_stall_rtc.msec_heartbeat = millis();
+} // end uni_stall_heartbeat()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_stall_enter() - start timing a section
+//       returns: nothing
+//
+static void uni_stall_enter(uni_stall_section_t * p_section) {
+  if ((0 == p_section->listed) && (g_uni_stall_section_num < UNI_STALL_SECTION_NUM)) {
+    g_uni_stall_sections[g_uni_stall_section_num++] = p_section;
+    p_section->listed = 1;
+  }
+  if (g_uni_stall_depth < UNI_STALL_NEST_MAX) {
+    g_uni_stall_open[g_uni_stall_depth] = p_section;
+    g_uni_stall_open_usec[g_uni_stall_depth] = esp_timer_get_time();
+  }
+  g_uni_stall_depth += 1;
+  uni_stall_rtc_open();
+} // end uni_stall_enter()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_stall_leave() - stop timing the innermost section; count and report an overrun
+//       returns: nothing
+//
+static void uni_stall_leave() {
+  if (0 == g_uni_stall_depth) return;
+  g_uni_stall_depth -= 1;
+  if (g_uni_stall_depth >= UNI_STALL_NEST_MAX) return; // nested too deep to have been timed
+
+  uni_stall_section_t * section_ptr = g_uni_stall_open[g_uni_stall_depth];
+  int64_t usec_took = esp_timer_get_time() - g_uni_stall_open_usec[g_uni_stall_depth];
+  uint32_t usec = (usec_took > 0xFFFFFFFFLL) ? 0xFFFFFFFFUL : (uint32_t) usec_took;
+
+  section_ptr->num += 1;
+  if (usec > section_ptr->budget_usec) {
+    section_ptr->over_num += 1;
+    if (usec > section_ptr->usec_max) {
+      Serial.printf("STALL section %s took usec %lu budget %lu\n", section_ptr->name, (unsigned long) usec, (unsigned long) section_ptr->budget_usec);
+    }
+    if (usec > g_uni_stall_rtc.worst_usec) {
+      strncpy(g_uni_stall_rtc.worst_name, section_ptr->name, UNI_STALL_NAME_LEN);
+      g_uni_stall_rtc.worst_name[UNI_STALL_NAME_LEN] = '\0';
+      g_uni_stall_rtc.worst_usec = usec;
+      g_uni_stall_rtc.worst_budget_usec = section_ptr->budget_usec;
+      g_uni_stall_rtc.worst_boot_num = g_uni_stall_rtc.boot_num;
+    }
+  }
+  if (usec > section_ptr->usec_max) section_ptr->usec_max = usec;
+  uni_stall_rtc_open();
+} // end uni_stall_leave()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_stall_feed() - a section that waits on purpose is still alive; keep the watchdog from resetting
+//       returns: nothing
+//
+static void uni_stall_feed() {
+  esp_task_wdt_reset(); // harmless if this task is not on the watchdog
+} // end uni_stall_feed()
+
+// UNI_STALL_SCOPE(section) - time from here to the end of the enclosing block
+class UniStallScope {
+  public:
+    UniStallScope(uni_stall_section_t * p_section) { uni_stall_enter(p_section); }
+    ~UniStallScope() { uni_stall_leave(); }
+};
+#define UNI_STALL_SCOPE_CAT2(p_a, p_b) p_a ## p_b
+#define UNI_STALL_SCOPE_CAT(p_a, p_b) UNI_STALL_SCOPE_CAT2(p_a, p_b)
+#define UNI_STALL_SCOPE(p_section) UniStallScope UNI_STALL_SCOPE_CAT(uni_stall_scope_, __LINE__)(&(p_section))
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_stall_setup() - report what the RTC record says about the last reset; start the watchdog
+//       returns: nothing
+//
+// p_wdt_msec - loop() must come around this often or the ESP32 resets; zero for no watchdog
+// call at the end of setup() so a long setup() does not trip the watchdog
+//
+static void uni_stall_setup(uint32_t p_wdt_msec) {
+  static esp_timer_handle_t heartbeat_timer = (esp_timer_handle_t) 0;
+  uni_stall_rtc_t * rtc_ptr = &g_uni_stall_rtc;
+  esp_reset_reason_t reason = esp_reset_reason();
+
+  if ((UNI_STALL_RTC_MAGIC != rtc_ptr->magic) || (ESP_RST_POWERON == reason)) {
+    memset(rtc_ptr, 0, sizeof(*rtc_ptr)); // power on: RTC memory is garbage
+    rtc_ptr->magic = UNI_STALL_RTC_MAGIC;
+  } else {
+    rtc_ptr->open_name[UNI_STALL_NAME_LEN] = rtc_ptr->worst_name[UNI_STALL_NAME_LEN] = '\0';
+    Serial.printf("STALL reset reason %d boot %lu\n", (int) reason, (unsigned long) rtc_ptr->boot_num);
+    if ('\0' != rtc_ptr->open_name[0]) {
+      Serial.printf("STALL reset inside section %s open msec %lu budget %lu\n", rtc_ptr->open_name,
+        (unsigned long) (rtc_ptr->msec_heartbeat - rtc_ptr->open_msec_start), (unsigned long) rtc_ptr->open_budget_msec);
+    }
+    if ('\0' != rtc_ptr->worst_name[0]) {
+      Serial.printf("STALL worst since power on section %s usec %lu budget %lu boot %lu\n", rtc_ptr->worst_name,
+        (unsigned long) rtc_ptr->worst_usec, (unsigned long) rtc_ptr->worst_budget_usec, (unsigned long) rtc_ptr->worst_boot_num);
+    }
+  }
+  rtc_ptr->boot_num += 1;
+  rtc_ptr->open_name[0] = '\0';
+  rtc_ptr->msec_heartbeat = millis();
+  g_uni_stall_depth = 0;
+
+  if ((esp_timer_handle_t) 0 == heartbeat_timer) {
+    esp_timer_create_args_t timer_args = { .callback = uni_stall_heartbeat, .arg = NULL, .dispatch_method = ESP_TIMER_TASK, .name = "uni_stall", .skip_unhandled_events = true };
+    if (ESP_OK == esp_timer_create(&timer_args, &heartbeat_timer)) esp_timer_start_periodic(heartbeat_timer, UNI_STALL_HEARTBEAT_MSEC * 1000ULL);
+  }
+
+  if (0 != p_wdt_msec) {
+    esp_task_wdt_config_t wdt_config = { .timeout_ms = p_wdt_msec, .idle_core_mask = 0, .trigger_panic = true };
+    if (ESP_OK != esp_task_wdt_reconfigure(&wdt_config)) esp_task_wdt_init(&wdt_config); // not started by sdkconfig
+    enableLoopWDT(); // the Arduino core resets it each time around loop()
+  }
+} // end uni_stall_setup()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_stall_dump() - print every section that has been entered on Serial
+//       returns: nothing
+//
+//    STALL section <name> n <num> over <over_num> max <usec_max> budget <budget_usec>
+//
+static void uni_stall_dump() {
+  for (uint16_t idx = 0; idx < g_uni_stall_section_num; idx++) {
+    const uni_stall_section_t * section_ptr = g_uni_stall_sections[idx];
+    Serial.printf("STALL section %s n %lu over %lu max %lu budget %lu\n", section_ptr->name, (unsigned long) section_ptr->num,
+      (unsigned long) section_ptr->over_num, (unsigned long) section_ptr->usec_max, (unsigned long) section_ptr->budget_usec);
+  }
+  if ('\0' != g_uni_stall_rtc.worst_name[0]) {
+    Serial.printf("STALL worst since power on section %s usec %lu budget %lu boot %lu\n", g_uni_stall_rtc.worst_name,
+      (unsigned long) g_uni_stall_rtc.worst_usec, (unsigned long) g_uni_stall_rtc.worst_budget_usec, (unsigned long) g_uni_stall_rtc.worst_boot_num);
+  }
+  Serial.printf("STALL end\n");
+} // end uni_stall_dump()
+
+#endif // UNI_REMOTE_STALL_H
@@ -0,0 +1,149 @@
+/* Author: https://github.com/Mark-MDO47  Feb. 28, 2025
+ *  https://github.com/Mark-MDO47/UniRemote
+ */
+
+/*
+   Copyright 2025 Mark Olson
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * UniRemoteTimer - deadlines and periodic jobs on millis() for the UniRemote sketches
+ *
+ * Used by UniRemoteCYD as "../UniRemoteRcvrTemplate/UniRemoteTimer.h", by Uni_RW_PICC the same way,
+ *    and by UniRemoteRcvrTemplate from the sketch directory (copy it along with UniRemoteRcvr.*).
+ *
+ * millis() wraps around to zero after about 49.7 days. A test like (msec_now < msec_waitfor)
+ *    goes wrong at the wrap: a deadline just past the wrap looks like it is far in the past.
+ *    uni_msec_reached() compares the signed difference instead, which is right as long as
+ *    deadlines are less than 24.8 days away.
+ *
+ * The job table - a component registers a job with uni_timer_add(): a function to call, when to
+ *    call it first and how often after that (zero for one shot; uni_timer_start() arms it again).
+ *    loop() calls uni_timer_run(), which calls every job that is due and returns how long until
+ *    the next one, so loop() can sleep until then instead of for a fixed time.
+ *    UNI_TIMER_NUM is small, so the table is just scanned; each scan also finds the next deadline.
+ *
+ * Everything here is static in the header: each sketch gets its own table.
+ *    Only call these from loop() level, never from a callback.
+ */
+
+#ifndef UNI_REMOTE_TIMER_H
+#define UNI_REMOTE_TIMER_H 1
+
+#include <Arduino.h>  // for millis()
+
+#define UNI_TIMER_NUM 8           // most jobs in the table
+#define UNI_TIMER_ID_NONE -1      // uni_timer_add() could not get an entry
+
+// a job; p_msec_now is the millis() that uni_timer_run() was called with
+typedef void (*uni_timer_fn_t)(uint32_t p_msec_now);
+
+typedef struct {
+  uni_timer_fn_t fn;              // function to call; 0 == entry free
+  uint32_t msec_due;              // millis() when fn is due
+  uint32_t msec_period;           // call again this much later; zero == one shot
+  uint8_t  armed;                 // non-zero == msec_due is valid
+} uni_timer_t;
+static uni_timer_t g_uni_timers[UNI_TIMER_NUM];
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_msec_reached() - wrap-safe "has p_msec_due come yet"
+//       returns: non-zero if p_msec_now is at or after p_msec_due
+//
+static inline int16_t uni_msec_reached(uint32_t p_msec_now, uint32_t p_msec_due) {
+  return(((int32_t) (p_msec_now - p_msec_due) >= 0) ? 1 : 0);
+} // end uni_msec_reached()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_msec_until() - wrap-safe time until p_msec_due
+//       returns: millisec until p_msec_due; zero if it has come
+//
+static inline uint32_t uni_msec_until(uint32_t p_msec_now, uint32_t p_msec_due) {
+  return(uni_msec_reached(p_msec_now, p_msec_due) ? 0 : (p_msec_due - p_msec_now));
+} // end uni_msec_until()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_timer_add() - register a job
+//       returns: job id for uni_timer_start() and uni_timer_stop(), or UNI_TIMER_ID_NONE if the table is full
+//
+//    p_fn          - function to call when due
+//    p_msec_first  - call it this long from now; zero == at the next uni_timer_run()
+//    p_msec_period - then call it this often; zero == one shot
+//    p_armed       - zero to register without arming; uni_timer_start() arms it later
+//
+static int16_t uni_timer_add(uni_timer_fn_t p_fn, uint32_t p_msec_first, uint32_t p_msec_period, uint8_t p_armed) {
+  for (int16_t id = 0; id < UNI_TIMER_NUM; id++) {
+    if ((uni_timer_fn_t) 0 != g_uni_timers[id].fn) continue;
+    g_uni_timers[id].fn = p_fn;
+    g_uni_timers[id].msec_due = millis() + p_msec_first;
+    g_uni_timers[id].msec_period = p_msec_period;
+    g_uni_timers[id].armed = p_armed;
+    return(id);
+  }
+  return(UNI_TIMER_ID_NONE);
+} // end uni_timer_add()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_timer_start() - arm a job to be called p_msec_from_now from now
+//       returns: nothing
+//
+// periodic jobs keep their period from then on
+//
+static void uni_timer_start(int16_t p_id, uint32_t p_msec_from_now) {
+  if ((p_id < 0) || (p_id >= UNI_TIMER_NUM) || ((uni_timer_fn_t) 0 == g_uni_timers[p_id].fn)) return;
+  g_uni_timers[p_id].msec_due = millis() + p_msec_from_now;
+  g_uni_timers[p_id].armed = 1;
+} // end uni_timer_start()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_timer_stop() - disarm a job; it stays registered
+//       returns: nothing
+//
+static void uni_timer_stop(int16_t p_id) {
+  if ((p_id < 0) || (p_id >= UNI_TIMER_NUM)) return;
+  g_uni_timers[p_id].armed = 0;
+} // end uni_timer_stop()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_timer_run() - call every job that is due
+//       returns: millisec until the next job is due, at most p_msec_max
+//
+// A periodic job that fell behind (loop() was busy) is called once and then keeps its period
+//    from now, rather than being called several times in a row to catch up.
+// A job may call uni_timer_start() or uni_timer_stop() on itself or any other job.
+//
+static uint32_t uni_timer_run(uint32_t p_msec_now, uint32_t p_msec_max) {
+  uint32_t msec_next = p_msec_max;
+
+  for (int16_t id = 0; id < UNI_TIMER_NUM; id++) {
+    uni_timer_t * timer_ptr = &g_uni_timers[id];
+    if (((uni_timer_fn_t) 0 == timer_ptr->fn) || (0 == timer_ptr->armed)) continue;
+    if (uni_msec_reached(p_msec_now, timer_ptr->msec_due)) {
+      if (0 == timer_ptr->msec_period) {
+        timer_ptr->armed = 0; // before calling so the job can arm itself again
+      } else {
+        timer_ptr->msec_due += timer_ptr->msec_period;
+        if (uni_msec_reached(p_msec_now, timer_ptr->msec_due)) timer_ptr->msec_due = p_msec_now + timer_ptr->msec_period;
+      }
+      timer_ptr->fn(p_msec_now);
+    }
+    if ((0 != timer_ptr->armed) && (uni_msec_until(p_msec_now, timer_ptr->msec_due) < msec_next)) {
+      msec_next = uni_msec_until(p_msec_now, timer_ptr->msec_due);
+    }
+  }
+  return(msec_next);
+} // end uni_timer_run()
+
+#endif // UNI_REMOTE_TIMER_H
@@ -0,0 +1,228 @@
+/* Author: https://github.com/Mark-MDO47  Mar. 7, 2025
+ *  https://github.com/Mark-MDO47/UniRemote
+ */
+
+/*
+   Copyright 2025 Mark Olson
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * UniRemoteTrace - a timeline of what the sketch did, for when "the remote hung"
+ *
+ * Used by UniRemoteCYD as "../UniRemoteRcvrTemplate/UniRemoteTrace.h"; a receiver can copy it along
+ *    with UniRemoteRcvr.* the same as UniRemoteTimer.h.
+ *
+ * A trace ring holds the last few hundred events, 12 bytes each, oldest overwritten first. An event is
+ *    - complete (X): something that took time: start in usec, duration in usec and an arg.
+ *                    Shorter than the min_usec given to uni_trace_name() is not kept, so the ring is
+ *                    not filled with the loop() passes where nothing happened.
+ *    - instant (i):  something that happened at one time, with an arg.
+ *    An event with arg names (uni_trace_arg_name()) is a state: each one lasts until the next one.
+ *
+ * Each ring has exactly one writer, like the SPSC rings in UniRemoteRcvrQueue.h: a ring for loop()
+ *    and a separate ring for each callback that traces. Writers check g_uni_trace_on, which only loop()
+ *    level changes; uni_trace_dump() turns it off while it prints so no record changes under it.
+ *
+ * uni_trace_dump() prints everything on Serial for uni_trace_json.py (in code/UniRemoteCYD) to turn
+ *    into Chrome trace_event JSON for https://ui.perfetto.dev or chrome://tracing:
+ *    TRACE now <usec>                              usec is the low 32 bits of esp_timer_get_time()
+ *    TRACE name <id> <name>
+ *    TRACE arg <id> <arg> <arg name>
+ *    TRACE ring <track> <num kept> <num written>
+ *    TRACE ev <usec> <dur usec> <id> <X or i> <arg> oldest first; usec wraps every 71 minutes
+ *    TRACE end
+ *
+ * Everything here is static in the header: each sketch gets its own tables.
+ */
+
+#ifndef UNI_REMOTE_TRACE_H
+#define UNI_REMOTE_TRACE_H 1
+
+#include <Arduino.h>    // for Serial
+#include <esp_timer.h>  // for esp_timer_get_time()
+
+#define UNI_TRACE_ID_NUM 16          // event ids are 0 to UNI_TRACE_ID_NUM-1
+#define UNI_TRACE_ARG_NAME_NUM 16    // most arg names over all ids
+#define UNI_TRACE_RING_NUM 4         // most rings in the dump
+
+#define UNI_TRACE_PH_COMPLETE 'X'
+#define UNI_TRACE_PH_INSTANT  'i'
+
+typedef struct {
+  uint32_t usec;                  // low 32 bits of esp_timer_get_time(); start if complete
+  uint32_t dur_usec;              // zero if instant
+  uint16_t arg;
+  uint8_t  id;
+  uint8_t  ph;                    // UNI_TRACE_PH_*
+} uni_trace_rec_t;
+
+typedef struct {
+  const char * track;             // "loop", "send_cb" ...; a row in the viewer
+  uni_trace_rec_t * recs;
+  uint32_t num;                   // records in recs; a power of 2
+  volatile uint32_t next;         // records ever written; written only by the ring's writer
+} uni_trace_ring_t;
+
+typedef struct {
+  const char * name;              // NULL if the id is not used
+  uint32_t min_usec;              // complete events shorter than this are not kept
+} uni_trace_id_t;
+
+typedef struct {
+  uint8_t id;
+  uint16_t arg;
+  const char * name;
+} uni_trace_arg_name_t;
+
+static volatile uint8_t g_uni_trace_on = 0; // written only at loop() level
+static uni_trace_id_t g_uni_trace_ids[UNI_TRACE_ID_NUM];
+static uni_trace_arg_name_t g_uni_trace_arg_names[UNI_TRACE_ARG_NAME_NUM];
+static uint16_t g_uni_trace_arg_name_num = 0;
+static uni_trace_ring_t * g_uni_trace_rings[UNI_TRACE_RING_NUM];
+static uint16_t g_uni_trace_ring_num = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_trace_ring_init() - set up a ring and add it to the dump; tracing starts with the first ring
+//       returns: zero if OK; non-zero if p_num is not a power of 2 or UNI_TRACE_RING_NUM are already set up
+//
+static int16_t uni_trace_ring_init(uni_trace_ring_t * p_ring, const char * p_track, uni_trace_rec_t * p_recs, uint32_t p_num) {
+  if ((0 == p_num) || (0 != (p_num & (p_num - 1))) || (g_uni_trace_ring_num >= UNI_TRACE_RING_NUM)) return(-1);
+  p_ring->track = p_track;
+  p_ring->recs = p_recs;
+  p_ring->num = p_num;
+  p_ring->next = 0;
+  g_uni_trace_rings[g_uni_trace_ring_num++] = p_ring;
+  g_uni_trace_on = 1;
+  return(0);
+} // end uni_trace_ring_init()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_trace_name() - name an event id
+//       returns: zero if OK; non-zero if p_id is too big
+//
+static int16_t uni_trace_name(uint8_t p_id, const char * p_name, uint32_t p_min_usec) {
+  if (p_id >= UNI_TRACE_ID_NUM) return(-1);
+  g_uni_trace_ids[p_id].name = p_name;
+  g_uni_trace_ids[p_id].min_usec = p_min_usec;
+  return(0);
+} // end uni_trace_name()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_trace_arg_name() - name one arg value of an event; makes the event a state (see top of file)
+//       returns: zero if OK; non-zero if UNI_TRACE_ARG_NAME_NUM are already named
+//
+static int16_t uni_trace_arg_name(uint8_t p_id, uint16_t p_arg, const char * p_name) {
+  if (g_uni_trace_arg_name_num >= UNI_TRACE_ARG_NAME_NUM) return(-1);
+  g_uni_trace_arg_names[g_uni_trace_arg_name_num].id = p_id;
+  g_uni_trace_arg_names[g_uni_trace_arg_name_num].arg = p_arg;
+  g_uni_trace_arg_names[g_uni_trace_arg_name_num].name = p_name;
+  g_uni_trace_arg_name_num += 1;
+  return(0);
+} // end uni_trace_arg_name()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_trace_put() - write one record; only the ring's writer calls this
+//       returns: nothing
+//
+static inline void uni_trace_put(uni_trace_ring_t * p_ring, uint8_t p_id, uint8_t p_ph, uint32_t p_usec, uint32_t p_dur_usec, uint16_t p_arg) {
+  if ((0 == g_uni_trace_on) || (0 == p_ring->num)) return;
+  uni_trace_rec_t * rec_ptr = &p_ring->recs[p_ring->next & (p_ring->num - 1)];
+  rec_ptr->usec = p_usec;
+  rec_ptr->dur_usec = p_dur_usec;
+  rec_ptr->arg = p_arg;
+  rec_ptr->id = p_id;
+  rec_ptr->ph = p_ph;
+  p_ring->next += 1; // last
+} // end uni_trace_put()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_trace_instant() - something happened now
+//       returns: nothing
+//
+static inline void uni_trace_instant(uni_trace_ring_t * p_ring, uint8_t p_id, uint16_t p_arg) {
+  uni_trace_put(p_ring, p_id, UNI_TRACE_PH_INSTANT, (uint32_t) esp_timer_get_time(), 0, p_arg);
+} // end uni_trace_instant()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_trace_complete() - something that started at p_usec_start (esp_timer_get_time()) just ended
+//       returns: nothing
+//
+static inline void uni_trace_complete(uni_trace_ring_t * p_ring, uint8_t p_id, int64_t p_usec_start, uint16_t p_arg) {
+  int64_t usec_dur = esp_timer_get_time() - p_usec_start;
+  if ((p_id < UNI_TRACE_ID_NUM) && (usec_dur < (int64_t) g_uni_trace_ids[p_id].min_usec)) return;
+  uni_trace_put(p_ring, p_id, UNI_TRACE_PH_COMPLETE, (uint32_t) p_usec_start,
+    (usec_dur > 0xFFFFFFFFLL) ? 0xFFFFFFFFUL : (uint32_t) usec_dur, p_arg);
+} // end uni_trace_complete()
+
+// UNI_TRACE_SCOPE(ring, id) - a complete event from here to the end of the enclosing block, arg zero
+class UniTraceScope {
+  public:
+    UniTraceScope(uni_trace_ring_t * p_ring, uint8_t p_id) : m_ring(p_ring), m_id(p_id), m_usec_start(esp_timer_get_time()) { }
+    ~UniTraceScope() { uni_trace_complete(m_ring, m_id, m_usec_start, 0); }
+  private:
+    uni_trace_ring_t * m_ring;
+    uint8_t m_id;
+    int64_t m_usec_start;
+};
+#define UNI_TRACE_SCOPE_CAT2(p_a, p_b) p_a ## p_b
+#define UNI_TRACE_SCOPE_CAT(p_a, p_b) UNI_TRACE_SCOPE_CAT2(p_a, p_b)
+#define UNI_TRACE_SCOPE(p_ring, p_id) UniTraceScope UNI_TRACE_SCOPE_CAT(uni_trace_scope_, __LINE__)(&(p_ring), (p_id))
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_trace_clear() - forget all events; names are kept
+//       returns: nothing
+//
+// loop() level only; a callback may still write one record into its ring as it is cleared
+//
+static void uni_trace_clear() {
+  g_uni_trace_on = 0;
+  for (uint16_t idx = 0; idx < g_uni_trace_ring_num; idx++) g_uni_trace_rings[idx]->next = 0;
+  g_uni_trace_on = 1;
+} // end uni_trace_clear()
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// uni_trace_dump() - print all rings on Serial; format at top of file
+//       returns: nothing
+//
+// loop() level only; events are not recorded while it prints
+//
+static void uni_trace_dump() {
+  uint8_t was_on = g_uni_trace_on;
+  g_uni_trace_on = 0;
+  delay(1); // let a callback that was already writing finish
+
+  Serial.printf("TRACE now %lu\n", (unsigned long) (uint32_t) esp_timer_get_time());
+  for (uint16_t id = 0; id < UNI_TRACE_ID_NUM; id++) {
+    if (NULL != g_uni_trace_ids[id].name) Serial.printf("TRACE name %u %s\n", id, g_uni_trace_ids[id].name);
+  }
+  for (uint16_t idx = 0; idx < g_uni_trace_arg_name_num; idx++) {
+    Serial.printf("TRACE arg %u %u %s\n", g_uni_trace_arg_names[idx].id, g_uni_trace_arg_names[idx].arg, g_uni_trace_arg_names[idx].name);
+  }
+  for (uint16_t idx = 0; idx < g_uni_trace_ring_num; idx++) {
+    const uni_trace_ring_t * ring_ptr = g_uni_trace_rings[idx];
+    uint32_t next = ring_ptr->next;
+    uint32_t first = (next > ring_ptr->num) ? (next - ring_ptr->num) : 0;
+    Serial.printf("TRACE ring %s %lu %lu\n", ring_ptr->track, (unsigned long) (next - first), (unsigned long) next);
+    for (uint32_t num = first; num < next; num++) {
+      const uni_trace_rec_t * rec_ptr = &ring_ptr->recs[num & (ring_ptr->num - 1)];
+      Serial.printf("TRACE ev %lu %lu %u %c %u\n", (unsigned long) rec_ptr->usec, (unsigned long) rec_ptr->dur_usec,
+        rec_ptr->id, (char) rec_ptr->ph, rec_ptr->arg);
+    }
+  }
+  Serial.printf("TRACE end\n");
+  g_uni_trace_on = was_on;
+} // end uni_trace_dump()
+
+#endif // UNI_REMOTE_TRACE_H
@@ -36,6 +36,7 @@
  */
 
 #include "mdo_use_ota_webupdater.h"
+#include <esp_task_wdt.h> // for esp_task_wdt_reset() while waiting for the router
 
 const char* host = "esp32";
 const char* g_ssid = WIFI_SSID;
@@ -44,6 +45,9 @@ const char* g_password = WIFI_PWD;
 constexpr uint16_t MDO_USE_OTA_WEB_UPDATER_NOT_INIT  = 0; // OTA Web Server not initialized/started
 constexpr uint16_t MDO_USE_OTA_WEB_UPDATER_REQUESTED = 1; // We are requested to initialize/start OTA Web Server from loop()
 constexpr uint16_t MDO_USE_OTA_WEB_UPDATER_INIT      = 2; // OTA Web Server initialized/started; periodically call g_ota_server.handleClient()
+// not visible to the user
+constexpr uint32_t MDO_USE_OTA_WIFI_CONNECT_MSEC = 20000; // feed the task watchdog this long while waiting for the router
+
 // not visible to the user
 static uint16_t g_ota_state = MDO_USE_OTA_WEB_UPDATER_NOT_INIT;
 
@@ -148,6 +152,10 @@ const char* serverIndex =
 //      None ... but call mdo_ota_web_request() before this
 // Restriction:
 //    It will probably hang if it cannot connect to the specified WiFi SSID.
+//       While waiting for the router it keeps the task watchdog fed for MDO_USE_OTA_WIFI_CONNECT_MSEC, then
+//       stops; if the sketch has put loop() on the task watchdog (see UniRemoteStall.h) it resets instead.
+//    It hangs for good if mDNS cannot start; if the sketch has put loop() on the task watchdog
+//       (see UniRemoteStall.h) that hang becomes a reset instead.
 //
 // Results:
 //    The web browser address http://esp32.local will find the webpage.
@@ -175,9 +183,20 @@ void mdo_ota_web_start() {
     Serial.println("");
 
     // Wait for connection
+    uint32_t msec_start = millis();
+    uint8_t late_said = 0;
     while (WiFi.status() != WL_CONNECTED) {
       delay(500);
       Serial.print(".");
+      if ((millis() - msec_start) < MDO_USE_OTA_WIFI_CONNECT_MSEC) {
+        esp_task_wdt_reset(); // waiting on purpose; harmless if this task is not on the watchdog
+      } else if (0 == late_said) {
+        // wrong SSID or password, or no router; let the watchdog (if any) reset us and report it
+        Serial.print("\nERROR: not connected to ");
+        Serial.print(g_ssid);
+        Serial.println("; no longer feeding the task watchdog");
+        late_said = 1;
+      }
     }
     Serial.println("");
     Serial.print("Connected to ");
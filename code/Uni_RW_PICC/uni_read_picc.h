@@ -21,6 +21,14 @@
 #ifndef UNI_READ_PICC_H
 #define UNI_READ_PICC_H 1
 
+#include "../UniRemoteRcvrTemplate/UniRemoteTimer.h" // for uni_msec_reached(); safe when millis() wraps
+#include "../UniRemoteRcvrTemplate/UniRemoteStall.h" // for timing the card read; see "picc_read" below
+
+// looking for a card and reading every block of it; a whole card takes a while
+//   a tap reads all 47 data blocks in about 184 msec (UniRemoteCYD/host_sim), so a normal read is not an overrun
+#define UNI_PICC_READ_STALL_MSEC 250
+static uni_stall_section_t g_stall_picc_read = UNI_STALL_SECTION("picc_read", UNI_PICC_READ_STALL_MSEC);
+
 /*
  * This code was developed after reading the Random Nerd Tutorials below.
  * There are significant differences in this code and the tutorials,
@@ -64,7 +72,6 @@ uint8_t uni_read_picc(char p_picc_read[]) {
   byte blockDataRead[PICC_EV1_1K_BLOCK_NUM_BYTES+2];
   MFRC522Constants::StatusCode picc_status;
 
-  static char picc_msg[1026];            // temp area to build strings for messages
   static char picc_cmd[PICC_EV1_1K_NUM_SECTORS*(PICC_EV1_1K_SECTOR_NUM_BLOCKS-1)*PICC_EV1_1K_BLOCK_NUM_BYTES]; // 16 extra bytes; assemble the command from the card here
   char * picc_cmd_ptr = picc_cmd; // pointer to the output buffer
 
@@ -74,7 +81,8 @@ uint8_t uni_read_picc(char p_picc_read[]) {
   picc_cmd[0] = p_picc_read[0] = '\0';
 
   // don't do anything until next waitfor time
-  if (msec_now < msec_waitfor) return(ret_value);
+  if (!uni_msec_reached(msec_now, msec_waitfor)) return(ret_value);
+  UNI_STALL_SCOPE(g_stall_picc_read); // from here to return
 
   // Check if a new card is present
   if (!mfrc522.PICC_IsNewCardPresent() || !mfrc522.PICC_ReadCardSerial()) {
@@ -94,8 +102,7 @@ uint8_t uni_read_picc(char p_picc_read[]) {
   if (MFRC522Constants::PICC_Type::PICC_TYPE_MIFARE_1K != piccType) {
     // FIXME TODO set display status to wrong card type
 #if DEBUG_PRINT_PICC_INFO
-    sprintf(picc_msg, "ERROR: PICC Type %d not PICC_TYPE_MIFARE_1K %d", piccType, MFRC522Constants::PICC_Type::PICC_TYPE_MIFARE_1K);
-    Serial.println(picc_msg); 
+    Serial.printf("ERROR: PICC Type %d not PICC_TYPE_MIFARE_1K %d\n", piccType, MFRC522Constants::PICC_Type::PICC_TYPE_MIFARE_1K);
 #endif // DEBUG_PRINT_PICC_INFO
     msec_waitfor = msec_now + 500;
     return(ret_value);
@@ -115,8 +122,7 @@ uint8_t uni_read_picc(char p_picc_read[]) {
     // MF1S50YYX_V1 Rev. 3.2 — 23 May 2018 says "The HLTA command needs to be sent encrypted to the PICC after a successful authentication in order to be accepted"
     if ((picc_status = mfrc522.PCD_Authenticate(MFRC522Constants::PICC_Command::PICC_CMD_MF_AUTH_KEY_A, blockAddress, &key, &(mfrc522.uid))) != MFRC522Constants::StatusCode::STATUS_OK) {
 #if DEBUG_PRINT_PICC_INFO
-      sprintf(picc_msg, "ERROR: PICC Authentication failed, status %d", picc_status);
-      Serial.println(picc_msg);
+      Serial.printf("ERROR: PICC Authentication failed, status %d\n", picc_status);
 #endif // DEBUG_PRINT_PICC_INFO
       // FIXME TODO set display status to authentication failed
       picc_cmd[0] = '\0';
@@ -125,8 +131,7 @@ uint8_t uni_read_picc(char p_picc_read[]) {
 
     if ((picc_status = mfrc522.MIFARE_Read(blockAddress, blockDataRead, &bufferblocksize)) != MFRC522Constants::StatusCode::STATUS_OK) {
 #if DEBUG_PRINT_PICC_INFO
-      sprintf(picc_msg, "ERROR: PICC Read failed, status %d", picc_status);
-      Serial.println(picc_msg);
+      Serial.printf("ERROR: PICC Read failed, status %d\n", picc_status);
 #endif // DEBUG_PRINT_PICC_INFO
       // FIXME TODO set display status to read failed
       picc_cmd[0] = '\0';
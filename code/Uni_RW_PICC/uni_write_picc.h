@@ -21,6 +21,8 @@
 #ifndef UNI_WRITE_PICC_H
 #define UNI_WRITE_PICC_H 1
 
+#include "../UniRemoteRcvrTemplate/UniRemoteTimer.h" // for uni_msec_reached(); safe when millis() wraps
+
 /*
  * This code was developed after reading the Random Nerd Tutorials below.
  * There are significant differences in this code and the tutorials,
@@ -64,7 +66,6 @@ uint8_t uni_write_picc(char * write_cmd) {
   byte bufferblocksize = PICC_EV1_1K_BLOCK_NUM_BYTES;  // number to write; no slack
   MFRC522Constants::StatusCode picc_status;
 
-  static char picc_msg[1026];            // temp area to build strings for messages
   static char picc_cmd[PICC_EV1_1K_NUM_SECTORS*(PICC_EV1_1K_SECTOR_NUM_BLOCKS-1)*PICC_EV1_1K_BLOCK_NUM_BYTES]; // 16 extra bytes; place the command for the card here
   char * picc_cmd_ptr = picc_cmd;       // pointer to the command to write
 
@@ -75,7 +76,7 @@ uint8_t uni_write_picc(char * write_cmd) {
   strncpy(picc_cmd_ptr, write_cmd, ESP_NOW_MAX_DATA_LEN-1); // max ESP-NOW msg size -1 for the zero termination
 
   // don't do anything until next waitfor time
-  if (msec_now < msec_waitfor) return(ret_value);
+  if (!uni_msec_reached(msec_now, msec_waitfor)) return(ret_value);
 
   // Check if a new card is present
   if (!mfrc522.PICC_IsNewCardPresent() || !mfrc522.PICC_ReadCardSerial()) {
@@ -95,8 +96,7 @@ uint8_t uni_write_picc(char * write_cmd) {
   if (MFRC522Constants::PICC_Type::PICC_TYPE_MIFARE_1K != piccType) {
     // FIXME TODO set display status to wrong card type
 #if DEBUG_PRINT_PICC_INFO
-    sprintf(picc_msg, "ERROR: PICC Type %d not PICC_TYPE_MIFARE_1K %d", piccType, MFRC522Constants::PICC_Type::PICC_TYPE_MIFARE_1K);
-    Serial.println(picc_msg); 
+    Serial.printf("ERROR: PICC Type %d not PICC_TYPE_MIFARE_1K %d\n", piccType, MFRC522Constants::PICC_Type::PICC_TYPE_MIFARE_1K);
 #endif // DEBUG_PRINT_PICC_INFO
     msec_waitfor = msec_now + 500;
     return(ret_value);
@@ -113,8 +113,7 @@ uint8_t uni_write_picc(char * write_cmd) {
     // MF1S50YYX_V1 Rev. 3.2 — 23 May 2018 says "The HLTA command needs to be sent encrypted to the PICC after a successful authentication in order to be accepted"
     if ((picc_status = mfrc522.PCD_Authenticate(MFRC522Constants::PICC_Command::PICC_CMD_MF_AUTH_KEY_A, blockAddress, &key, &(mfrc522.uid))) != MFRC522Constants::StatusCode::STATUS_OK) {
 #if DEBUG_PRINT_PICC_INFO
-      sprintf(picc_msg, "ERROR: PICC Write Authentication failed, status %d", picc_status);
-      Serial.println(picc_msg);
+      Serial.printf("ERROR: PICC Write Authentication failed, status %d\n", picc_status);
 #endif // DEBUG_PRINT_PICC_INFO
       // FIXME TODO set display status to authentication failed
       break; // do the halt and stop
@@ -122,8 +121,7 @@ uint8_t uni_write_picc(char * write_cmd) {
 
     if ((picc_status = mfrc522.MIFARE_Write(blockAddress, (byte *)picc_cmd_ptr, bufferblocksize)) != MFRC522Constants::StatusCode::STATUS_OK) {
 #if DEBUG_PRINT_PICC_INFO
-      sprintf(picc_msg, "ERROR: PICC Write failed, status %d", picc_status);
-      Serial.println(picc_msg);
+      Serial.printf("ERROR: PICC Write failed, status %d\n", picc_status);
 #endif // DEBUG_PRINT_PICC_INFO
       // FIXME TODO set display status to Write failed
       break; // do the halt and stop
@@ -240,6 +240,10 @@ uint8_t parse_string(char *build_string, char *strptr_desc, uint8_t output_desc)
 //    the first call.
 //
 #define MAX_STRING_LENGTH 20
+#define UNI_STALL_WDT_MSEC 15000 // loop() must come around this often or the ESP32 resets; more than the 10 sec Serial timeout below
+
+// the operator can take as long as they like; fed while waiting, the section shows how long they took
+static uni_stall_section_t g_stall_opr_input = UNI_STALL_SECTION("opr_input", 60000);
 #define DO_DEBUG_INPUT FALSE // TRUE=debug, FALSE=no debug
 #if DO_DEBUG_INPUT
   // NOTE: these are not complex enough to cover all the cases
@@ -257,11 +261,12 @@ char * get_ascii_string() {
   int16_t tmp2 = 0;
   uint8_t found = FALSE;
 
+  UNI_STALL_SCOPE(g_stall_opr_input); // from here to return
   Serial.setTimeout(10000); // 10,000 milliseconds is 10 seconds
   memset((void *)ascii_string, 0, NUMOF(ascii_string)); // clear buffer; good idea for zero-terminated strings
 
   while (!found) {
-    while (!Serial.available()) ; // wait for typing to start
+    while (!Serial.available()) uni_stall_feed(); // wait for typing to start; waiting on purpose
     my_string_object = Serial.readStringUntil('\n'); // get a line
     DEBUG_INPUT_PRINT(F("DBGIN Entire String object |")); DEBUG_INPUT_PRINT(my_string_object); DEBUG_INPUT_PRINTLN(F("|"));
     my_string_object.trim(); // trim off spaces/tabs front and back
@@ -304,6 +309,9 @@ void setup() {
   for (byte i = 0; i < 6; i++) {
     key.keyByte[i] = 0xFF;
   }
+
+  // report a stall that reset us last time; then loop() goes on the watchdog
+  uni_stall_setup(UNI_STALL_WDT_MSEC);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////